@@ -71,15 +71,27 @@ void write32psram(uint32_t addr32, uint32_t v) {
     psram_write32(&psram_spi, addr32, v);
 }
 
+// Block transfers go out as DMA bursts. The PIO program takes the bit counts
+// as single bytes, so one transaction carries at most 27 bytes on write and 31
+// on read; bursts are cut at 16-byte boundaries, which also keeps them inside
+// one 1 KB PSRAM page.
+#define PSRAM_BURST 16
+
 void writepsram(uint32_t addr32, uint8_t* b, size_t sz) {
-    while (sz--) {
-        psram_write8(&psram_spi, addr32++, *b++);
+    while (sz) {
+        size_t n = PSRAM_BURST - (addr32 & (PSRAM_BURST - 1));
+        if (n > sz) n = sz;
+        psram_write(&psram_spi, addr32, b, n);
+        addr32 += n; b += n; sz -= n;
     }
 }
 
 void readpsram(uint8_t* b, uint32_t addr32, size_t sz) {
-    while (sz--) {
-        *b++ = psram_read8(&psram_spi, addr32++);
+    while (sz) {
+        size_t n = PSRAM_BURST - (addr32 & (PSRAM_BURST - 1));
+        if (n > sz) n = sz;
+        psram_read(&psram_spi, addr32, b, n);
+        addr32 += n; b += n; sz -= n;
     }
 }
 
@@ -0,0 +1,506 @@
+// spec_bench — headless throughput benchmark for the emulator core.
+//
+// Boots a machine (or loads a .SNA), runs N frames through the same path as
+// ESPectrum::loop() — CPU::loop() (Z80 + ULA renderer + contention), AY/SAA
+// sample generation, beeper finish and the final mix — and reports frames/s,
+// T-states/s and time spent per subsystem. The "state" line hashes registers,
+// RAM, framebuffer and produced audio: an optimisation that must not change
+// emulation has to leave it bit-identical.
+//
+// --rewind also runs Rewind::frame() after every frame (in 4 MB of PSRAM),
+// reports the capture cost and checks that stepping back lands on the state
+// hashed at one of the captures.
+//
+// --giga turns gigascreen on and runs the core1 blend pass after each frame.
+//
+//   spec_bench [--arch 48K|128K|Pentagon|P512|P1024] [--frames N]
+//              [--mem sram|psram|swap] [--pool N] [--no-ay] [--saa]
+//              [--rewind] [--giga] [--root DIR] [snapshot.sna]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/mman.h>
+
+#include "pico/time.h"
+#include "psram_spi.h"
+#include "ESPectrum.h"
+#include "Config.h"
+#include "CPU.h"
+#include "MemESP.h"
+#include "Ports.h"
+#include "Rewind.h"
+#include "Video.h"
+#include "AySound.h"
+#include "Z80_JLS/z80.h"
+#include "wd1793.h"
+#if !PICO_RP2040
+#include "SAASound.h"
+#include "DivMMC.h"
+#endif
+
+using std::string;
+
+extern std::string host_fs_root;
+void host_psram_init(uint32_t sz);
+#if !PICO_RP2040
+void initGigascreenBlendLUT();
+#endif
+
+// Extra Z80 RAM pages (8+) get their own fixed window above 0x11000000: the core
+// treats any lower address as flash ROM (see MemESP::writebyte).
+#define HOST_RAM_BASE ((uintptr_t)0x30000000)
+
+static void usage() {
+    fprintf(stderr,
+        "usage: spec_bench [--arch 48K|128K|Pentagon|P512|P1024] [--frames N]\n"
+        "                  [--mem sram|psram|swap] [--pool N] [--no-ay] [--saa]\n"
+        "                  [--rewind] [--giga] [--root DIR] [snapshot.sna]\n");
+    exit(1);
+}
+
+// ---------------------------------------------------------------------------
+// Machine setup — the parts of ESPectrum::setup() / Config::requestMachine()
+// the core depends on
+// ---------------------------------------------------------------------------
+static void setupMemory(const string& mem, int pool, bool rewind) {
+    mem_desc_t::reset();
+    mem_desc_t* temp = MemESP::ram;
+    MemESP::ram = new mem_desc_t[MEM_PG_CNT + 2];
+    memcpy((void*)MemESP::ram, (void*)temp, sizeof(mem_desc_t) * 8);
+
+    size_t extra = MEM_PG_CNT + 2 - 8;
+    uint8_t* base = (uint8_t*)mmap((void*)HOST_RAM_BASE, extra * MEM_PG_SZ, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (base != (uint8_t*)HOST_RAM_BASE) {
+        fprintf(stderr, "spec_bench: unable to map RAM pages at %p\n", (void*)HOST_RAM_BASE);
+        exit(2);
+    }
+    uint32_t psram = mem == "psram" ? (MEM_PG_CNT + 2) * MEM_PG_SZ : 0;
+    if (rewind && psram < (4ul << 20)) psram = 4ul << 20;
+    if (psram) host_psram_init(psram);
+    for (size_t i = 8; i < MEM_PG_CNT + 2; ++i) {
+        if (mem == "sram" || (int)(i - 8) < pool) {
+            MemESP::ram[i].assign_ram(base + (i - 8) * MEM_PG_SZ, i, false);
+        } else {
+            MemESP::ram[i].assign_vram(i, mem == "psram" ? mem_type_t::PSRAM_SPI : mem_type_t::SWAP);
+        }
+    }
+}
+
+static void requestMachine(const string& arch) {
+    Config::arch = arch;
+    if (arch == "48K") {
+        MemESP::rom[0].assign_rom(gb_rom_0_sinclair_48k);
+    } else if (arch == "128K") {
+        MemESP::rom[0].assign_rom(gb_rom_0_sinclair_128k);
+        MemESP::rom[1].assign_rom(gb_rom_1_sinclair_128k);
+    } else {
+        MemESP::rom[0].assign_rom(gb_rom_pentagon_128k);
+        MemESP::rom[1].assign_rom(gb_rom_pentagon_128k + (16 << 10));
+    }
+    MemESP::rom[4].assign_rom(gb_rom_4_trdos_505d);
+}
+
+static void resetMachine() {
+    MemESP::page0ram = 0;
+    MemESP::romInUse = 0;
+    MemESP::bankLatch = 0;
+    MemESP::videoLatch = 0;
+    MemESP::romLatch = 0;
+    MemESP::newSRAM = false;
+    MemESP::ramCurrent[0] = MemESP::rom[0].direct();
+    MemESP::ramCurrent[1] = MemESP::ram[5].direct();
+    MemESP::ramCurrent[2] = MemESP::ram[2].sync(2);
+    MemESP::ramCurrent[3] = MemESP::ram[0].sync(3);
+    bool pentagon = Config::arch == "Pentagon" || Config::arch == "P512" || Config::arch == "P1024";
+    MemESP::ramContended[0] = false;
+    MemESP::ramContended[1] = !pentagon;
+    MemESP::ramContended[2] = false;
+    MemESP::ramContended[3] = false;
+    MemESP::pagingLock = Config::arch == "48K" ? 1 : 0;
+
+    VIDEO::Init();
+    VIDEO::Reset();
+
+    if (Config::arch == "48K") {
+        ESPectrum::samplesPerFrame = ESP_AUDIO_SAMPLES_48;
+        ESPectrum::audioAYDivider = ESP_AUDIO_AY_DIV_48;
+        ESPectrum::tstatesPerSampleFP = (TSTATES_PER_FRAME_48 << 8) / ESP_AUDIO_SAMPLES_48;
+    } else if (Config::arch == "128K") {
+        ESPectrum::samplesPerFrame = ESP_AUDIO_SAMPLES_128;
+        ESPectrum::audioAYDivider = ESP_AUDIO_AY_DIV_128;
+        ESPectrum::tstatesPerSampleFP = (TSTATES_PER_FRAME_128 << 8) / ESP_AUDIO_SAMPLES_128;
+    } else {
+        ESPectrum::samplesPerFrame = ESP_AUDIO_SAMPLES_PENTAGON;
+        ESPectrum::audioAYDivider = ESP_AUDIO_AY_DIV_PENTAGON;
+        ESPectrum::tstatesPerSampleFP = (TSTATES_PER_FRAME_PENTAGON << 8) / ESP_AUDIO_SAMPLES_PENTAGON;
+    }
+    ESPectrum::audioCOVOXDivider = ESPectrum::audioAYDivider;
+
+    chip0.init();
+    chip0.set_sound_format(ESPectrum::Audio_freq, 1, 8);
+    chip0.set_stereo(AYEMU_MONO, NULL);
+    chip0.reset();
+    chip1.init();
+    chip1.set_sound_format(ESPectrum::Audio_freq, 1, 8);
+    chip1.set_stereo(AYEMU_MONO, NULL);
+    chip1.reset();
+#if !PICO_RP2040
+    saaChip.init();
+    saaChip.set_sound_format(ESPectrum::Audio_freq, 1, 8);
+    saaChip.reset();
+#endif
+
+    Z80::create();
+    for (int i = 0; i < 128; i++) Ports::port[i] = 0xBF;
+    Ports::port[Config::kempstonPort] = 0;
+    rvmWD1793Reset(&ESPectrum::fdd);
+    CPU::reset();
+    VIDEO::Reset();
+}
+
+// ---------------------------------------------------------------------------
+// .SNA loader (same layout and fix-ups as FileSNA::load)
+// ---------------------------------------------------------------------------
+static void loadPage(int page, const uint8_t* src) {
+    for (int addr = 0; addr < MEM_PG_SZ; ++addr) MemESP::ram[page].write(addr, src[addr]);
+}
+
+static bool loadSNA(const char* fn, string& arch) {
+    FILE* f = fopen(fn, "rb");
+    if (!f) {
+        fprintf(stderr, "spec_bench: can't open %s\n", fn);
+        return false;
+    }
+    std::vector<uint8_t> d;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) d.insert(d.end(), buf, buf + n);
+    fclose(f);
+
+    size_t pages128 = 0;
+    if (d.size() == 49179) {
+        arch = "48K";
+    } else if (d.size() == 131103 || d.size() == 147487) {
+        if (arch == "48K") arch = "Pentagon";
+        pages128 = 8;
+    } else if (d.size() == 131103 + 24 * MEM_PG_SZ || d.size() == 147487 + 24 * MEM_PG_SZ) {
+        arch = "P512";
+        pages128 = 32;
+    } else if (d.size() == 131103 + 56 * MEM_PG_SZ || d.size() == 147487 + 56 * MEM_PG_SZ) {
+        arch = "P1024";
+        pages128 = 64;
+    } else {
+        fprintf(stderr, "spec_bench: bad SNA size %zu\n", d.size());
+        return false;
+    }
+    requestMachine(arch);
+    resetMachine();
+
+    const uint8_t* p = d.data();
+    auto rd16 = [&p]() { uint16_t v = p[0] | (p[1] << 8); p += 2; return v; };
+    Z80::setRegI(*p++);
+    Z80::setRegHLx(rd16());
+    Z80::setRegDEx(rd16());
+    Z80::setRegBCx(rd16());
+    Z80::setRegAFx(rd16());
+    Z80::setRegHL(rd16());
+    Z80::setRegDE(rd16());
+    Z80::setRegBC(rd16());
+    Z80::setRegIY(rd16());
+    Z80::setRegIX(rd16());
+    uint8_t inter = *p++;
+    Z80::setIFF2(inter & 0x04 ? true : false);
+    Z80::setIFF1(Z80::isIFF2());
+    Z80::setRegR(*p++);
+    Z80::setRegAF(rd16());
+    Z80::setRegSP(rd16());
+    Z80::setIM((Z80::IntMode)(*p++));
+    VIDEO::borderColor = *p++ & 7;
+    VIDEO::brd = VIDEO::border32[VIDEO::borderColor];
+
+    const uint8_t* p5 = p; p += MEM_PG_SZ;
+    const uint8_t* p2 = p; p += MEM_PG_SZ;
+    const uint8_t* p0 = p; p += MEM_PG_SZ;
+    loadPage(5, p5);
+    loadPage(2, p2);
+
+    if (arch == "48K") {
+        loadPage(0, p0);
+        uint16_t SP = Z80::getRegSP();
+        Z80::setRegPC(MemESP::readword(SP));
+        Z80::setRegSP(SP + 2);
+        return true;
+    }
+
+    Z80::setRegPC(rd16());
+    uint8_t tmp_port = *p++;
+    uint8_t tr_dos = *p++;
+    uint8_t latch = tmp_port & 0x07;
+    loadPage(latch, p0);
+    for (size_t page = 0; page < pages128; ++page) {
+        if (page != latch && page != 2 && page != 5) {
+            loadPage(page, p);
+            p += MEM_PG_SZ;
+        }
+    }
+    MemESP::videoLatch = (tmp_port >> 3) & 1;
+    MemESP::romLatch = (tmp_port >> 4) & 1;
+    MemESP::pagingLock = (tmp_port >> 5) & 1;
+    MemESP::bankLatch = latch;
+    MemESP::romInUse = tr_dos ? 4 : MemESP::romLatch;
+    ESPectrum::trdos = tr_dos != 0;
+    MemESP::recoverPage0();
+    MemESP::ramCurrent[3] = MemESP::ram[MemESP::bankLatch].sync(3);
+    MemESP::ramContended[3] = Z80Ops::isPentagon ? false : (MemESP::bankLatch & 0x01 ? true : false);
+    VIDEO::grmem = MemESP::videoLatch ? MemESP::ram[7].direct() : MemESP::ram[5].direct();
+    if (Z80Ops::isPentagon) CPU::tstates = 22;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// One frame, same order of work as ESPectrum::loop()
+// ---------------------------------------------------------------------------
+struct frame_times_t {
+    uint64_t cpu, ay, saa, mix;
+};
+
+static inline void hash32(uint32_t& h, const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) h = (h ^ p[i]) * 16777619u;
+}
+
+// Registers + the 8 base RAM pages as they are (Rewind only captures when
+// all of them are resident)
+static uint32_t rewindHash() {
+    uint32_t h = 2166136261u;
+    uint16_t regs[] = {
+        Z80::getRegPC(), Z80::getRegSP(), Z80::getRegAF(), Z80::getRegBC(), Z80::getRegDE(),
+        Z80::getRegHL(), Z80::getRegIX(), Z80::getRegIY(), Z80::getRegAFx(), Z80::getRegBCx(),
+        Z80::getRegDEx(), Z80::getRegHLx(), (uint16_t)CPU::tstates, (uint16_t)MemESP::bankLatch,
+    };
+    hash32(h, (const uint8_t*)regs, sizeof(regs));
+    for (int page = 0; page < 8; ++page) {
+        uint8_t* p = MemESP::ram[page].direct();
+        if (p) hash32(h, p, MEM_PG_SZ);
+    }
+    return h;
+}
+
+static void runFrame(frame_times_t& t, uint32_t& audio_hash) {
+    ESPectrum::audbufcnt = 0;
+    ESPectrum::audbufcntover = 0;
+    ESPectrum::audbufcntAY = 0;
+    chip0.flushWrites();
+    chip1.flushWrites();
+    ESPectrum::audbufcntCovox = 0;
+#if !PICO_RP2040
+    ESPectrum::audbufcntSAA = 0;
+    ESPectrum::audbufcntPIT = 0;
+#endif
+    ESPectrum::lastBeeperTstates = 0;
+    ESPectrum::accumulatorFP = 0;
+    ESPectrum::beeperSampleAccum = 0;
+    ESPectrum::beeperTstatesInSample = 0;
+
+    uint64_t t0 = time_us_64();
+    CPU::loop();
+    mem_desc_t::flush();
+#if !PICO_RP2040
+    DivMMC::idle();
+#endif
+    uint64_t t1 = time_us_64();
+
+    const int spf = ESPectrum::samplesPerFrame;
+    ESPectrum::faudbufcntAY = ESPectrum::audbufcntAY;
+    int faudioBit = ESPectrum::lastaudioBit;
+    if (ESPectrum::beeperTstatesInSample > 0 && ESPectrum::audbufcntover < (uint32_t)spf) {
+        uint32_t tstatesPerSampleInt = ESPectrum::tstatesPerSampleFP >> 8;
+        if (ESPectrum::beeperTstatesInSample < tstatesPerSampleInt) {
+            uint32_t remaining = tstatesPerSampleInt - ESPectrum::beeperTstatesInSample;
+            ESPectrum::beeperSampleAccum += faudioBit * remaining;
+            ESPectrum::beeperTstatesInSample += remaining;
+        }
+        ESPectrum::overSamplebuf[ESPectrum::audbufcntover++] =
+            ESPectrum::beeperSampleAccum / ESPectrum::beeperTstatesInSample;
+    }
+    while (ESPectrum::audbufcntover < (uint32_t)spf)
+        ESPectrum::overSamplebuf[ESPectrum::audbufcntover++] = faudioBit;
+
+    if (ESPectrum::AY_emu && ESPectrum::faudbufcntAY < (uint32_t)spf) {
+        if (Config::turbosound != 0 || AySound::selected_chip == 0)
+            chip0.gen_sound(spf - ESPectrum::faudbufcntAY, ESPectrum::faudbufcntAY);
+        if (Config::turbosound != 0 || AySound::selected_chip == 1)
+            chip1.gen_sound(spf - ESPectrum::faudbufcntAY, ESPectrum::faudbufcntAY);
+    }
+    uint64_t t2 = time_us_64();
+#if !PICO_RP2040
+    ESPectrum::faudbufcntSAA = ESPectrum::audbufcntSAA;
+    if (ESPectrum::SAA_emu && ESPectrum::faudbufcntSAA < (uint32_t)spf)
+        saaChip.gen_sound(spf - ESPectrum::faudbufcntSAA, ESPectrum::faudbufcntSAA);
+#endif
+    uint64_t t3 = time_us_64();
+
+    bool mix_chip0 = ESPectrum::AY_emu && (Config::turbosound != 0 || AySound::selected_chip == 0);
+    bool mix_chip1 = ESPectrum::AY_emu && (Config::turbosound != 0 || AySound::selected_chip == 1);
+    for (int i = 0; i < spf; i++) {
+        int beeper_L = ESPectrum::overSamplebuf[i] + ESPectrum::audioBufferCovox[i];
+        int beeper_R = beeper_L;
+        if (mix_chip0) {
+            beeper_L += chip0.SamplebufAY_L[i];
+            beeper_R += chip0.SamplebufAY_R[i];
+        }
+        if (mix_chip1) {
+            beeper_L += chip1.SamplebufAY_L[i];
+            beeper_R += chip1.SamplebufAY_R[i];
+        }
+#if !PICO_RP2040
+        if (ESPectrum::SAA_emu) {
+            beeper_L += saaChip.SamplebufSAA_L[i];
+            beeper_R += saaChip.SamplebufSAA_R[i];
+        }
+#endif
+        ESPectrum::audioBuffer_L[i] = beeper_L > 255 ? 255 : (beeper_L < 0 ? 0 : beeper_L);
+        ESPectrum::audioBuffer_R[i] = beeper_R > 255 ? 255 : (beeper_R < 0 ? 0 : beeper_R);
+    }
+    hash32(audio_hash, ESPectrum::audioBuffer_L, spf);
+    hash32(audio_hash, ESPectrum::audioBuffer_R, spf);
+
+#if !PICO_RP2040
+    if (!(VIDEO::flash_ctr++ & 0x0f) && !VIDEO::ulaplus_enabled)
+#else
+    if (!(VIDEO::flash_ctr++ & 0x0f))
+#endif
+        VIDEO::flashing ^= 0x80;
+    uint64_t t4 = time_us_64();
+
+    t.cpu += t1 - t0;
+    t.ay += t2 - t1;
+    t.saa += t3 - t2;
+    t.mix += t4 - t3;
+}
+
+int main(int argc, char** argv) {
+    string arch = "48K";
+    string mem = "sram";
+    string sna;
+    int frames = 500;
+    int pool = 4;
+    bool ay = true;
+    bool saa = false;
+    bool rewind = false;
+    bool giga = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--arch" && i + 1 < argc) arch = argv[++i];
+        else if (a == "--frames" && i + 1 < argc) frames = atoi(argv[++i]);
+        else if (a == "--mem" && i + 1 < argc) mem = argv[++i];
+        else if (a == "--pool" && i + 1 < argc) pool = atoi(argv[++i]);
+        else if (a == "--root" && i + 1 < argc) host_fs_root = argv[++i];
+        else if (a == "--no-ay") ay = false;
+        else if (a == "--saa") saa = true;
+        else if (a == "--rewind") rewind = true;
+        else if (a == "--giga") giga = true;
+        else if (a[0] == '-') usage();
+        else sna = a;
+    }
+    if (frames <= 0 || (mem != "sram" && mem != "psram" && mem != "swap")) usage();
+    if (arch != "48K" && arch != "128K" && arch != "Pentagon" && arch != "P512" && arch != "P1024") usage();
+
+    setupMemory(mem, pool, rewind);
+    ESPectrum::AY_emu = ay;
+#if !PICO_RP2040
+    ESPectrum::SAA_emu = saa;
+#endif
+    if (sna.empty()) {
+        requestMachine(arch);
+        resetMachine();
+    } else if (!loadSNA(sna.c_str(), arch)) {
+        return 2;
+    }
+
+#if !PICO_RP2040
+    if (giga) {
+        Config::gigascreen_enabled = true;
+        Config::gigascreen_onoff = 1;
+        initGigascreenBlendLUT();
+        VIDEO::InitPrevBuffer();
+        VIDEO::gigascreen_enabled = VIDEO::vga.prevFrameBuffer != nullptr;
+    }
+#endif
+
+    frame_times_t t = { 0, 0, 0, 0 };
+    uint32_t audio_hash = 2166136261u;
+    uint64_t global0 = CPU::global_tstates;
+    uint64_t start = time_us_64();
+    std::vector<uint32_t> snapHash;
+    if (rewind) Rewind::reset();
+    for (int f = 0; f < frames; ++f) {
+        runFrame(t, audio_hash);
+#if !PICO_RP2040
+        if (giga) VIDEO::gigascreenPass(); // core1 on the device
+#endif
+        if (rewind && Rewind::frame()) snapHash.push_back(rewindHash());
+    }
+    uint64_t wall = time_us_64() - start;
+    uint64_t tstates = CPU::global_tstates - global0;
+
+    uint32_t cpu_hash = 2166136261u;
+    uint8_t regs[] = {
+        (uint8_t)(Z80::getRegPC() & 0xFF), (uint8_t)(Z80::getRegPC() >> 8),
+        (uint8_t)(Z80::getRegSP() & 0xFF), (uint8_t)(Z80::getRegSP() >> 8),
+        (uint8_t)(Z80::getRegAF() & 0xFF), (uint8_t)(Z80::getRegAF() >> 8),
+        (uint8_t)(Z80::getRegBC() & 0xFF), (uint8_t)(Z80::getRegBC() >> 8),
+        (uint8_t)(Z80::getRegDE() & 0xFF), (uint8_t)(Z80::getRegDE() >> 8),
+        (uint8_t)(Z80::getRegHL() & 0xFF), (uint8_t)(Z80::getRegHL() >> 8),
+        (uint8_t)(Z80::getRegIX() & 0xFF), (uint8_t)(Z80::getRegIX() >> 8),
+        (uint8_t)(Z80::getRegIY() & 0xFF), (uint8_t)(Z80::getRegIY() >> 8),
+        Z80::getRegI(), Z80::getRegR(),
+        (uint8_t)(CPU::tstates & 0xFF), (uint8_t)(CPU::tstates >> 8),
+    };
+    hash32(cpu_hash, regs, sizeof(regs));
+    mem_desc_t::cache_stats_t cs = mem_desc_t::stats; // before hashing pages in below
+    uint32_t ram_hash = 2166136261u;
+    for (int page = 0; page < 8; ++page) {
+        uint8_t* p = MemESP::ram[page].sync(page == MemESP::bankLatch ? 3 : 5);
+        hash32(ram_hash, p, MEM_PG_SZ);
+    }
+    MemESP::ramCurrent[3] = MemESP::ram[MemESP::bankLatch].sync(3);
+    uint32_t screen_hash = 2166136261u;
+    for (int y = 0; y < VIDEO::vga.yres; ++y)
+        hash32(screen_hash, (const uint8_t*)VIDEO::vga.frameBuffer[y], VIDEO::vga.xres);
+
+    double secs = wall / 1e6;
+    double fps = frames / secs;
+    double real_fps = 1e6 / (double)ESPectrum::target;
+    printf("spec_bench: arch=%s mem=%s frames=%d%s%s\n", Config::arch.c_str(), mem.c_str(), frames,
+           sna.empty() ? "" : " snapshot=", sna.c_str());
+    printf("  wall       %.3f s  %.1f fps  (%.1fx real time)\n", secs, fps, fps / real_fps);
+    printf("  T-states   %llu  %.2f M/s\n", (unsigned long long)tstates, tstates / secs / 1e6);
+    printf("  per frame  z80+ula %.1f us | ay %.1f us | saa %.1f us | mix %.1f us\n",
+           (double)t.cpu / frames, (double)t.ay / frames, (double)t.saa / frames, (double)t.mix / frames);
+    if (mem != "sram")
+        printf("  page cache hit %u miss %u | evict: writeback %u clean %u\n",
+               cs.hits, cs.misses, cs.writebacks, cs.clean);
+    printf("  state      cpu=%08x ram=%08x screen=%08x audio=%08x\n", cpu_hash, ram_hash, screen_hash, audio_hash);
+    if (rewind) {
+        const Rewind::stats_t& rs = Rewind::stats;
+        printf("  rewind     %u snaps (%u held) | capture avg %.1f us max %u us | last %u bytes | every %u frames\n",
+               rs.snaps, Rewind::count(), rs.snaps ? (double)rs.total_us / rs.snaps : 0.0, rs.max_us,
+               rs.last_bytes, rs.interval);
+        if (Rewind::stepBack()) {
+            uint32_t h = rewindHash();
+            int back = 0;
+            while (back < (int)snapHash.size() && snapHash[snapHash.size() - 1 - back] != h) ++back;
+            if (back == (int)snapHash.size()) {
+                printf("  rewind     step back: MISMATCH %08x\n", h);
+                return 3;
+            }
+            printf("  rewind     step back: ok (snapshot -%d)\n", back);
+        }
+    }
+    return 0;
+}
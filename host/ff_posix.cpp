@@ -0,0 +1,163 @@
+// Host build: the subset of the FatFs API the core uses, on top of stdio.
+// Paths are taken relative to host_fs_root ("/tmp/pico-spec.swap" ->
+// "<root>/tmp/pico-spec.swap"), so the swap file and disk images live in a
+// scratch directory instead of the real filesystem root.
+// The FILE* is kept in FIL::obj.fs; obj.objsize/fptr are kept current so the
+// f_size()/f_tell()/f_eof() macros work unchanged.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ff.h"
+#include "diskio.h"
+
+std::string host_fs_root = "host_sd";
+
+static std::string host_path(const TCHAR* path) {
+    std::string p = path;
+    if (!p.empty() && p[0] == '/') p = host_fs_root + p;
+    return p;
+}
+
+static void mkdir_parents(const std::string& p) {
+    for (size_t i = 1; i < p.size(); ++i) {
+        if (p[i] == '/') mkdir(p.substr(0, i).c_str(), 0755);
+    }
+}
+
+static inline FILE* fil_file(FIL* fp) { return (FILE*)fp->obj.fs; }
+
+extern "C" {
+
+FRESULT f_open(FIL* fp, const TCHAR* path, BYTE mode) {
+    memset(fp, 0, sizeof(FIL));
+    std::string p = host_path(path);
+    struct stat st;
+    bool exists = stat(p.c_str(), &st) == 0;
+    if ((mode & FA_CREATE_NEW) && exists) return FR_EXIST;
+    const char* m;
+    if (mode & FA_CREATE_ALWAYS) {
+        mkdir_parents(p);
+        m = "w+b";
+    } else if (!exists) {
+        if (!(mode & (FA_OPEN_ALWAYS | FA_CREATE_NEW))) return FR_NO_FILE;
+        mkdir_parents(p);
+        m = "w+b";
+    } else {
+        m = (mode & FA_WRITE) ? "r+b" : "rb";
+    }
+    FILE* f = fopen(p.c_str(), m);
+    if (!f) return FR_DENIED;
+    fp->obj.fs = (FATFS*)f;
+    fp->obj.id = 1;
+    fp->flag = mode;
+    fseek(f, 0, SEEK_END);
+    fp->obj.objsize = ftell(f);
+    fp->fptr = 0;
+    fseek(f, 0, SEEK_SET);
+    if ((mode & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+        fseek(f, 0, SEEK_END);
+        fp->fptr = fp->obj.objsize;
+    }
+    return FR_OK;
+}
+
+FRESULT f_close(FIL* fp) {
+    FILE* f = fil_file(fp);
+    if (!f) return FR_INVALID_OBJECT;
+    fclose(f);
+    fp->obj.fs = 0;
+    return FR_OK;
+}
+
+FRESULT f_read(FIL* fp, void* buff, UINT btr, UINT* br) {
+    FILE* f = fil_file(fp);
+    *br = 0;
+    if (!f) return FR_INVALID_OBJECT;
+    size_t n = fread(buff, 1, btr, f);
+    *br = (UINT)n;
+    fp->fptr += n;
+    return FR_OK;
+}
+
+FRESULT f_write(FIL* fp, const void* buff, UINT btw, UINT* bw) {
+    FILE* f = fil_file(fp);
+    *bw = 0;
+    if (!f) return FR_INVALID_OBJECT;
+    size_t n = fwrite(buff, 1, btw, f);
+    *bw = (UINT)n;
+    fp->fptr += n;
+    if (fp->fptr > fp->obj.objsize) fp->obj.objsize = fp->fptr;
+    return n == btw ? FR_OK : FR_DISK_ERR;
+}
+
+FRESULT f_lseek(FIL* fp, FSIZE_t ofs) {
+    FILE* f = fil_file(fp);
+    if (!f) return FR_INVALID_OBJECT;
+    // FatFs extends a writable file when seeking past its end
+    if (ofs > fp->obj.objsize && (fp->flag & FA_WRITE)) {
+        fseek(f, 0, SEEK_END);
+        static const uint8_t zero[512] = { 0 };
+        FSIZE_t gap = ofs - fp->obj.objsize;
+        while (gap) {
+            size_t n = gap > sizeof(zero) ? sizeof(zero) : (size_t)gap;
+            fwrite(zero, 1, n, f);
+            gap -= n;
+        }
+        fp->obj.objsize = ofs;
+    } else if (ofs > fp->obj.objsize) {
+        ofs = fp->obj.objsize;
+    }
+    fseek(f, (long)ofs, SEEK_SET);
+    fp->fptr = ofs;
+    return FR_OK;
+}
+
+FRESULT f_sync(FIL* fp) {
+    FILE* f = fil_file(fp);
+    if (!f) return FR_INVALID_OBJECT;
+    fflush(f);
+    return FR_OK;
+}
+
+FRESULT f_unlink(const TCHAR* path) {
+    return unlink(host_path(path).c_str()) == 0 ? FR_OK : FR_NO_FILE;
+}
+
+FRESULT f_stat(const TCHAR* path, FILINFO* fno) {
+    struct stat st;
+    if (stat(host_path(path).c_str(), &st) != 0) return FR_NO_FILE;
+    if (fno) {
+        memset(fno, 0, sizeof(FILINFO));
+        fno->fsize = st.st_size;
+        fno->fattrib = S_ISDIR(st.st_mode) ? AM_DIR : 0;
+        const char* name = strrchr(path, '/');
+        strncpy(fno->fname, name ? name + 1 : path, sizeof(fno->fname) - 1);
+    }
+    return FR_OK;
+}
+
+FIL* fopen2(const TCHAR* path, BYTE mode) {
+    FIL* f = new FIL;
+    if (f_open(f, path, mode) != FR_OK) {
+        delete f;
+        return 0;
+    }
+    return f;
+}
+
+void fclose2(FIL* f) {
+    if (!f) return;
+    f_close(f);
+    delete f;
+}
+
+// No raw SD card on the host: DivMMC/Z-Controller sector access reports "not ready"
+DRESULT disk_read(BYTE pdrv, BYTE* buff, LBA_t sector, UINT count) { return RES_NOTRDY; }
+DRESULT disk_write(BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count) { return RES_NOTRDY; }
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void* buff) { return RES_NOTRDY; }
+
+}
@@ -0,0 +1,78 @@
+// Host build: board-level pieces (clock, PSRAM, 74HC595, video-out palette).
+// PSRAM is a plain heap buffer, sized by the bench via host_psram_init();
+// psram_size() == 0 means "no PSRAM", exactly like a board without the chip.
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "pico/time.h"
+#include "psram_spi.h"
+
+// ---------------------------------------------------------------------------
+// Time
+// ---------------------------------------------------------------------------
+extern "C" uint64_t time_us_64(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000u;
+}
+
+extern "C" void sleep_us(uint64_t us) {
+    struct timespec ts = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000 };
+    nanosleep(&ts, 0);
+}
+
+extern "C" void sleep_ms(uint32_t ms) { sleep_us((uint64_t)ms * 1000u); }
+
+// ---------------------------------------------------------------------------
+// SPI PSRAM
+// ---------------------------------------------------------------------------
+static uint8_t* psram_buf = 0;
+static uint32_t psram_sz = 0;
+
+void host_psram_init(uint32_t sz) {
+    free(psram_buf);
+    psram_buf = sz ? (uint8_t*)calloc(1, sz) : 0;
+    psram_sz = psram_buf ? sz : 0;
+}
+
+extern "C" {
+
+uint32_t init_psram() { return psram_sz; }
+uint32_t psram_size() { return psram_sz; }
+void psram_cleanup() { if (psram_buf) memset(psram_buf, 0, psram_sz); }
+void psram_id(uint8_t rx[8]) { memset(rx, 0, 8); }
+
+void write8psram(uint32_t addr32, uint8_t v) { psram_buf[addr32] = v; }
+void write16psram(uint32_t addr32, uint16_t v) { memcpy(psram_buf + addr32, &v, 2); }
+void write32psram(uint32_t addr32, uint32_t v) { memcpy(psram_buf + addr32, &v, 4); }
+uint8_t read8psram(uint32_t addr32) { return psram_buf[addr32]; }
+uint16_t read16psram(uint32_t addr32) { uint16_t v; memcpy(&v, psram_buf + addr32, 2); return v; }
+uint32_t read32psram(uint32_t addr32) { uint32_t v; memcpy(&v, psram_buf + addr32, 4); return v; }
+void writepsram(uint32_t addr32, uint8_t* b, size_t sz) { memcpy(psram_buf + addr32, b, sz); }
+void readpsram(uint8_t* b, uint32_t addr32, size_t sz) { memcpy(b, psram_buf + addr32, sz); }
+
+// ---------------------------------------------------------------------------
+// 74HC595 (hardware AY/SAA bus) — nothing attached
+// ---------------------------------------------------------------------------
+uint16_t control_bits = 0;
+void send_to_595(uint16_t data) {}
+
+// ---------------------------------------------------------------------------
+// Video out: the framebuffer is rendered for real, only the scan-out is absent
+// ---------------------------------------------------------------------------
+void graphics_set_palette(uint8_t i, uint32_t color) {}
+void graphics_set_scanlines(bool enabled) {}
+void graphics_set_dither(bool enabled) {}
+void vga_set_palette_entry_solid(uint8_t i, uint32_t color888) {}
+
+}
+
+// No QMI ("butter") PSRAM on the host
+uint8_t* PSRAM_DATA = 0;
+uint32_t butter_psram_size() { return 0; }
+
+size_t getContiguousHeap(void) { return 64u << 20; }
+uint8_t nes_pad2_for_alf(void) { return 0xFF; }
@@ -0,0 +1,10 @@
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+#include "pico.h"
+static inline void gpio_put(unsigned int, bool) {}
+static inline bool gpio_get(unsigned int) { return false; }
+static inline void gpio_init(unsigned int) {}
+static inline void gpio_set_dir(unsigned int, bool) {}
+#define GPIO_OUT 1
+#define GPIO_IN 0
+#endif
@@ -0,0 +1,8 @@
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+#include "pico.h"
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+#define pio0 ((PIO)0)
+#define pio1 ((PIO)0)
+#endif
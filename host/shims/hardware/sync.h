@@ -0,0 +1,7 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+#include "pico.h"
+
+static inline void __dmb(void) { __sync_synchronize(); }
+
+#endif
@@ -0,0 +1,4 @@
+#ifndef HOST_HARDWARE_VREG_H
+#define HOST_HARDWARE_VREG_H
+#include "pico.h"
+#endif
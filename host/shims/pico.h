@@ -0,0 +1,40 @@
+// Host shim for the handful of pico-sdk platform macros used by the emulator
+// core. Only what the host bench needs to compile Z80/CPU/Memory/Ports/Video
+// and AY translation units on Linux; nothing here talks to real hardware.
+#ifndef HOST_PICO_H
+#define HOST_PICO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef PICO_RP2040
+#define PICO_RP2040 0
+#endif
+#ifndef PICO_RP2350
+#define PICO_RP2350 (!PICO_RP2040)
+#endif
+
+#define __in_flash(...)
+#define __not_in_flash(group)
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+#define __no_inline_not_in_flash_func(func_name) func_name
+#define __scratch_x(group)
+#define __scratch_y(group)
+#define __uninitialized_ram(name) name
+#ifndef __aligned
+#define __aligned(x) __attribute__((aligned(x)))
+#endif
+#ifndef __force_inline
+#define __force_inline inline __attribute__((always_inline))
+#endif
+#ifndef __unused
+#define __unused __attribute__((unused))
+#endif
+
+#define XIP_BASE 0x10000000u
+
+static inline void tight_loop_contents(void) {}
+
+#endif
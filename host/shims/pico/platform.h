@@ -0,0 +1,4 @@
+#ifndef HOST_PICO_PLATFORM_H
+#define HOST_PICO_PLATFORM_H
+#include "pico.h"
+#endif
@@ -0,0 +1,30 @@
+// Host shim for drivers/psram/psram_spi.h: same C API, backed by a plain
+// heap buffer (see host/hal.cpp). Size is chosen by the bench at startup.
+#ifndef HOST_PSRAM_SPI_H
+#define HOST_PSRAM_SPI_H
+
+#include "pico.h"
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t init_psram();
+uint32_t psram_size();
+void psram_cleanup();
+void write8psram(uint32_t addr32, uint8_t v);
+void write16psram(uint32_t addr32, uint16_t v);
+void write32psram(uint32_t addr32, uint32_t v);
+uint8_t read8psram(uint32_t addr32);
+uint16_t read16psram(uint32_t addr32);
+uint32_t read32psram(uint32_t addr32);
+void psram_id(uint8_t rx[8]);
+void writepsram(uint32_t addr32, uint8_t* b, size_t sz);
+void readpsram(uint8_t* b, uint32_t addr32, size_t sz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
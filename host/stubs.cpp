@@ -0,0 +1,261 @@
+// Host build: definitions normally provided by Config.cpp, ESPectrum.cpp, Tape.cpp,
+// OSDMain.cpp and friends. Those units drag in the whole UI/USB/video-out stack,
+// so the host links against these minimal versions instead.
+// Defaults mirror the firmware ones; bench.cpp overrides what it needs.
+
+#include <cstdio>
+#include <cstdarg>
+#include <string>
+
+#include "Config.h"
+#include "ESPectrum.h"
+#include "CPU.h"
+#include "Ports.h"
+#include "AySound.h"
+#include "Video.h"
+#include "Tape.h"
+#include "OSDMain.h"
+#include "Debug.h"
+#include "FileUtils.h"
+#include "Midi.h"
+#if !PICO_RP2040
+#include "SAASound.h"
+#endif
+
+using std::string;
+
+// ---------------------------------------------------------------------------
+// Config
+// ---------------------------------------------------------------------------
+string   Config::arch = "48K";
+string   Config::romSet48 = "48K";
+string   Config::romSet128 = "128K";
+const bool Config::aspect_16_9 = false;
+uint8_t  Config::lang = 0;
+bool     Config::Issue2 = true;
+bool     Config::flashload = true;
+bool     Config::tape_player = false;
+
+Config::BreakPoint Config::breakPoints[Config::MAX_BREAKPOINTS];
+int Config::numPcBP = 0;
+int Config::numPortReadBP = 0;
+int Config::numPortWriteBP = 0;
+int Config::numMemWriteBP = 0;
+int Config::numMemReadBP = 0;
+int Config::numBreakPoints = 0;
+int Config::numCondBP = 0;
+uint8_t Config::bpPage[Config::BP_TYPES][256] = { 0 };
+uint32_t Config::bpBits[Config::MAX_BREAKPOINTS][8];
+
+uint8_t  Config::joystick = JOY_KEMPSTON;
+uint8_t  Config::AluTiming = 0;
+uint8_t  Config::ayConfig = 0;
+#if !PICO_RP2040
+uint8_t  Config::turbosound = 3; // BOTH
+#else
+uint8_t  Config::turbosound = 0; // OFF
+#endif
+uint8_t  Config::covox = 0;
+uint8_t  Config::kempstonPort = 0x1F;
+bool     Config::trdosFastMode = false;
+#if !PICO_RP2040
+uint8_t  Config::esxdos = 0;
+string   Config::esxdos_hdf_image[2] = {"", ""};
+uint8_t  Config::mb02 = 0;
+#endif
+uint8_t  Config::scanlines = 0;
+uint8_t  Config::render = 0;
+uint8_t  Config::hdmi_video_mode = Config::VM_640x480_60;
+#if !PICO_RP2040
+bool     Config::gigascreen_enabled = false;
+uint8_t  Config::gigascreen_onoff = 0;
+bool     Config::ulaplus = false;
+bool     Config::hdmi_dither = false;
+bool     Config::timex_video = false;
+uint8_t  Config::dma_mode = 0;
+bool     Config::mode16col_onoff = false;
+#endif
+uint8_t  Config::palette = 0;
+uint8_t  Config::audio_driver = 0;
+
+void Config::save() {}
+
+// ---------------------------------------------------------------------------
+// ESPectrum — audio counters and the per-frame sample producers.
+// GetSample() bodies are kept in step with ESPectrum.cpp so the bench measures
+// the same work the firmware does on every port write.
+// ---------------------------------------------------------------------------
+uint8_t ESPectrum::audioBuffer_L[ESP_AUDIO_SAMPLES_PENTAGON] = { 0 };
+uint8_t ESPectrum::audioBuffer_R[ESP_AUDIO_SAMPLES_PENTAGON] = { 0 };
+uint8_t ESPectrum::audioBufferCovox[ESP_AUDIO_SAMPLES_PENTAGON] = { 0 };
+uint8_t ESPectrum::overSamplebuf[ESP_AUDIO_SAMPLES_PENTAGON] = { 0 };
+#if !PICO_RP2040
+uint8_t ESPectrum::audioBufferPIT[ESP_AUDIO_SAMPLES_PENTAGON] = { 0 };
+uint32_t ESPectrum::audbufcntSAA = 0;
+uint32_t ESPectrum::faudbufcntSAA = 0;
+uint32_t ESPectrum::audbufcntPIT = 0;
+uint32_t ESPectrum::faudbufcntPIT = 0;
+#endif
+unsigned char ESPectrum::audioAYDivider;
+unsigned char ESPectrum::audioCOVOXDivider;
+uint32_t ESPectrum::audbufcnt = 0;
+uint32_t ESPectrum::audbufcntover = 0;
+uint32_t ESPectrum::audbufcntAY = 0;
+uint32_t ESPectrum::audbufcntCovox = 0;
+uint32_t ESPectrum::faudbufcnt = 0;
+uint32_t ESPectrum::faudbufcntAY = 0;
+uint32_t ESPectrum::faudbufcntCovox = 0;
+bool ESPectrum::SAA_emu = false;
+int ESPectrum::lastaudioBit = 0;
+int ESPectrum::lastCovoxVal = 0;
+int ESPectrum::faudioBit = 0;
+int ESPectrum::samplesPerFrame;
+bool ESPectrum::AY_emu = false;
+int ESPectrum::Audio_freq = 31250;
+uint8_t ESPectrum::multiplicator = 0;
+uint32_t ESPectrum::lastBeeperTstates = 0;
+uint32_t ESPectrum::accumulatorFP = 0;
+uint32_t ESPectrum::tstatesPerSampleFP = 0;
+uint32_t ESPectrum::beeperSampleAccum = 0;
+uint32_t ESPectrum::beeperTstatesInSample = 0;
+int64_t ESPectrum::target;
+volatile bool ESPectrum::v_sync = false;
+bool ESPectrum::trdos = false;
+rvmWD1793 ESPectrum::fdd;
+#if !PICO_RP2040
+rvmWD1793 ESPectrum::mb02_fdd;
+#endif
+int32_t ESPectrum::mouseX = 0;
+int32_t ESPectrum::mouseY = 0;
+bool ESPectrum::mouseButtonL = 0;
+bool ESPectrum::mouseButtonR = 0;
+bool ESPectrum::maxSpeed = false;
+
+// recip[n] = (1<<16)/n, [0] and [1] are 0 — same values as the table in ESPectrum.cpp
+static uint16_t beeper_recip[256];
+static struct beeper_recip_init_t {
+    beeper_recip_init_t() {
+        for (int i = 2; i < 256; ++i) beeper_recip[i] = (uint16_t)(65536 / i);
+    }
+} beeper_recip_init;
+
+void ESPectrum::BeeperGetSample() {
+    uint32_t currentTstates = CPU::tstates;
+    uint32_t delta = currentTstates - lastBeeperTstates;
+    lastBeeperTstates = currentTstates;
+
+    uint32_t effectiveFP = tstatesPerSampleFP;
+    if (multiplicator) effectiveFP <<= multiplicator;
+
+    beeperSampleAccum += lastaudioBit * delta;
+    beeperTstatesInSample += delta;
+    accumulatorFP += (delta << 8);
+
+    while (accumulatorFP >= effectiveFP) {
+        accumulatorFP -= effectiveFP;
+        uint32_t overflowTstates = accumulatorFP >> 8;
+        uint32_t completedAccum = beeperSampleAccum - lastaudioBit * overflowTstates;
+        uint32_t completedTstates = beeperTstatesInSample - overflowTstates;
+        overSamplebuf[audbufcntover++] = (completedTstates > 0 && completedTstates < 256)
+            ? (uint32_t)(completedAccum * beeper_recip[completedTstates]) >> 16 : 0;
+        beeperSampleAccum = lastaudioBit * overflowTstates;
+        beeperTstatesInSample = overflowTstates;
+    }
+}
+
+void ESPectrum::CovoxGetSample() {
+    uint32_t audbufpos = CPU::tstates / audioCOVOXDivider;
+    if (multiplicator) audbufpos >>= multiplicator;
+    if (audbufpos > audbufcntCovox) {
+        uint8_t *sound_buf = audioBufferCovox + audbufcntCovox;
+        int sound_bufsize = audbufpos - audbufcntCovox;
+        while (sound_bufsize-- > 0) *sound_buf++ = lastCovoxVal;
+        audbufcntCovox = audbufpos;
+    }
+}
+
+void ESPectrum::AYGetSample() {
+    uint32_t audbufpos = CPU::tstates / audioAYDivider;
+    if (multiplicator) audbufpos >>= multiplicator;
+    if (audbufpos > audbufcntAY) {
+        chip0.gen_sound(audbufpos - audbufcntAY, audbufcntAY);
+        if (Config::turbosound)
+            chip1.gen_sound(audbufpos - audbufcntAY, audbufcntAY);
+        audbufcntAY = audbufpos;
+    }
+}
+
+void ESPectrum::AYWrite(uint8_t data) {
+    AySound *chip = chips[AySound::selected_chip];
+    if (chip->queueFull()) AYGetSample();
+    uint32_t audbufpos = CPU::tstates / audioAYDivider;
+    if (multiplicator) audbufpos >>= multiplicator;
+    chip->queueRegisterData(data, audbufpos);
+}
+
+#if !PICO_RP2040
+void ESPectrum::SAAGetSample() {
+    uint32_t audbufpos = CPU::tstates / audioAYDivider;
+    if (multiplicator) audbufpos >>= multiplicator;
+    if (audbufpos > audbufcntSAA) {
+        saaChip.gen_sound(audbufpos - audbufcntSAA, audbufcntSAA);
+        audbufcntSAA = audbufpos;
+    }
+}
+
+void ESPectrum::PITGetSample() {
+    uint32_t audbufpos = CPU::tstates >> 7;
+    if (multiplicator) audbufpos >>= multiplicator;
+    if (audbufpos > audbufcntPIT) {
+        Ports::pitGenSound(audioBufferPIT + audbufcntPIT, audbufpos - audbufcntPIT);
+        audbufcntPIT = audbufpos;
+    }
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Video output side (the ULA renderer itself is the real Video.cpp)
+// ---------------------------------------------------------------------------
+int VIDEO::video_mode = 0;
+
+// ---------------------------------------------------------------------------
+// Tape — never loading on the host
+// ---------------------------------------------------------------------------
+string  Tape::tapeFileName = "none";
+int     Tape::tapeFileType = TAPE_FTYPE_EMPTY;
+uint8_t Tape::tapeEarBit = 0;
+uint8_t Tape::tapeStatus = TAPE_STOPPED;
+uint8_t Tape::tapePhase = 0;
+bool    Tape::jjScreenAnimating = false;
+bool    Tape::pzxFlashCont = false;
+
+bool Tape::FlashLoad() { return false; }
+void Tape::Save() {}
+bool Tape::TapePortRead() { return false; }
+
+// ---------------------------------------------------------------------------
+// OSD / Debug / Midi / FileUtils
+// ---------------------------------------------------------------------------
+unsigned short OSD::scrW = 320;
+unsigned short OSD::scrH = 240;
+
+void OSD::osdCenteredMsg(const string& msg, uint8_t warn_level) {
+    fprintf(stderr, "[osd] %s\n", msg.c_str());
+}
+
+void Debug::log(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+}
+void Debug::log2SD(const char* fmt, ...) {}
+void Debug::led_blink() {}
+
+uint8_t Midi::enabled = 0;
+void Midi::send(uint8_t b) {}
+bool Midi::busy() { return false; }
+
+bool FileUtils::fsMount = true;
+void FileUtils::mkdirParents(const char* path) {}
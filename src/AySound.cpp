@@ -160,6 +160,7 @@ void AySound::init()
     bit_a = bit_b = bit_c = bit_n = 0;
     env_pos = EnvNum = 0;
     SamplebufAY[0] = SamplebufAY[1] = 0;
+    wq_len = wq_rd = 0;
 
 #if !PICO_RP2040
     midi_bitbang_pos = -1;
@@ -292,21 +293,44 @@ void AySound::prepare_generation()
 // Generate sound.
 // Fill sound buffer with current register data
 //
-// Common counter/noise/envelope tick macro — shared by all stereo variants.
-// Operates on hoisted local variables to minimize member access in inner loop.
-#define AY_TICK_COUNTERS() \
-    if (++l_cnt_a >= l_tone_a) { l_cnt_a = 0; l_bit_a ^= 1; } \
-    if (++l_cnt_b >= l_tone_b) { l_cnt_b = 0; l_bit_b ^= 1; } \
-    if (++l_cnt_c >= l_tone_c) { l_cnt_c = 0; l_bit_c ^= 1; } \
-    if (++l_cnt_n >= l_noise2) { \
-        l_cnt_n = 0; \
-        l_seed = (l_seed * 2 + 1) ^ (((l_seed >> 16) ^ (l_seed >> 13)) & 1); \
-        l_bit_n = (l_seed >> 16) & 1; \
-    } \
-    if (++l_cnt_e >= l_env_freq) { \
-        l_cnt_e = 0; \
-        if (++l_env_pos > 127) l_env_pos = 64; \
-    }
+// The chip runs ChipTacts_per_outcount tacts per output sample, but its output
+// only changes when a tone, noise or envelope counter wraps. Rather than tick
+// every tact, each step jumps straight to the nearest such event, adds the
+// constant output of the tacts before it as one product and then applies the
+// event. Counters that can't be heard with the current registers (tone or
+// noise masked in R7, or the channel at volume 0, envelope unused) are run
+// forward once per call by AY_SKIP_SILENT(). Output is bit-identical to
+// ticking every tact.
+
+// Distance in tacts from a counter to its next wrap; at least 1 since a
+// counter already past a lowered period wraps on the next tact
+#define AY_DIST(k, cnt, period) { int d = (period) - (cnt); if (d < (k)) k = d; }
+
+// Advance a counter by k tacts, k never past its next wrap
+#define AY_STEP(k, cnt, period, on_wrap) \
+    if ((cnt += (k)) >= (period)) { cnt = 0; on_wrap; }
+
+#define AY_NOISE_SEED() \
+    l_seed = (l_seed * 2 + 1) ^ (((l_seed >> 16) ^ (l_seed >> 13)) & 1)
+
+#define AY_ENV_NEXT() \
+    if (++l_env_pos > 127) l_env_pos = 64
+
+// Tacts until the next audible event, capped at the k passed in
+#define AY_NEXT_EVENT(k) \
+    if (l_hear_a) AY_DIST(k, l_cnt_a, l_tone_a) \
+    if (l_hear_b) AY_DIST(k, l_cnt_b, l_tone_b) \
+    if (l_hear_c) AY_DIST(k, l_cnt_c, l_tone_c) \
+    if (l_hear_n) AY_DIST(k, l_cnt_n, l_noise2) \
+    if (l_hear_e) AY_DIST(k, l_cnt_e, l_env_freq) \
+    if (k < 1) k = 1;
+
+#define AY_ADVANCE(k) \
+    if (l_hear_a) { AY_STEP(k, l_cnt_a, l_tone_a, l_bit_a ^= 1) } \
+    if (l_hear_b) { AY_STEP(k, l_cnt_b, l_tone_b, l_bit_b ^= 1) } \
+    if (l_hear_c) { AY_STEP(k, l_cnt_c, l_tone_c, l_bit_c ^= 1) } \
+    if (l_hear_n) { AY_STEP(k, l_cnt_n, l_noise2, AY_NOISE_SEED(); l_bit_n = (l_seed >> 16) & 1) } \
+    if (l_hear_e) { AY_STEP(k, l_cnt_e, l_env_freq, AY_ENV_NEXT()) }
 
 // Hoist all loop-invariant AY state into local variables
 #define AY_HOIST_LOCALS() \
@@ -324,7 +348,25 @@ void AySound::prepare_generation()
     int l_seed = Cur_Seed; \
     int l_tacts = ChipTacts_per_outcount; \
     int l_inv_amp = inv_Amp_Global; \
-    const int *l_table = table;
+    const int *l_table = table; \
+    bool l_aud_a = l_env_a || l_vol_a, l_aud_b = l_env_b || l_vol_b, l_aud_c = l_env_c || l_vol_c; \
+    bool l_hear_a = l_aud_a && l_R7ta, l_hear_b = l_aud_b && l_R7tb, l_hear_c = l_aud_c && l_R7tc; \
+    bool l_hear_n = (l_aud_a && l_R7na) || (l_aud_b && l_R7nb) || (l_aud_c && l_R7nc); \
+    bool l_hear_e = l_env_a || l_env_b || l_env_c;
+
+// Run the counters nobody hears forward by the whole call at once
+#define AY_SKIP_SILENT(n) \
+    if (!l_hear_a) ay_skip_tone(l_cnt_a, l_bit_a, l_tone_a, n); \
+    if (!l_hear_b) ay_skip_tone(l_cnt_b, l_bit_b, l_tone_b, n); \
+    if (!l_hear_c) ay_skip_tone(l_cnt_c, l_bit_c, l_tone_c, n); \
+    if (!l_hear_n) { \
+        for (int w = ay_skip_count(l_cnt_n, l_noise2, n); w > 0; w--) AY_NOISE_SEED(); \
+        l_bit_n = (l_seed >> 16) & 1; \
+    } \
+    if (!l_hear_e) { \
+        l_env_pos += ay_skip_count(l_cnt_e, l_env_freq, n); \
+        if (l_env_pos > 127) l_env_pos = 64 + ((l_env_pos - 128) & 63); \
+    }
 
 // Write back mutable state to member variables
 #define AY_WRITEBACK() \
@@ -336,81 +378,100 @@ void AySound::prepare_generation()
 #define AY_CHVOL(env_flag, vol_reg) \
     (l_table[(env_flag) ? l_env_row[l_env_pos] : Rampa_AY_table[vol_reg]])
 
+// Channel outputs for the current generator state
+#define AY_OUTPUTS() \
+    out_a = ((l_bit_a | !l_R7ta) & (l_bit_n | !l_R7na)) ? AY_CHVOL(l_env_a, l_vol_a) : 0; \
+    out_b = ((l_bit_b | !l_R7tb) & (l_bit_n | !l_R7nb)) ? AY_CHVOL(l_env_b, l_vol_b) : 0; \
+    out_c = ((l_bit_c | !l_R7tc) & (l_bit_n | !l_R7nc)) ? AY_CHVOL(l_env_c, l_vol_c) : 0;
+
+// Wraps of a counter over n tacts; leaves the counter where ticking would
+static inline int ay_skip_count(int &cnt, int period, int n) {
+    int first = period - cnt;
+    if (first < 1) first = 1;
+    if (n < first) { cnt += n; return 0; }
+    n -= first;
+    if (period < 1) period = 1;
+    cnt = n % period;
+    return 1 + n / period;
+}
+
+static inline void ay_skip_tone(int &cnt, int &bit, int period, int n) {
+    bit ^= ay_skip_count(cnt, period, n) & 1;
+}
+
+// Body shared by the stereo variants: MIX(n) adds n tacts of the current
+// out_a/out_b/out_c to the sample accumulators. Whole samples before the next
+// event all come out the same and are stored in a row; a sample an event falls
+// in is built from the spans between its events.
+#define AY_GEN_LOOP(MIX, STORE) \
+    AY_HOIST_LOCALS() \
+    AY_SKIP_SILENT(sound_bufsize * l_tacts) \
+    int out_a, out_b, out_c; \
+    AY_OUTPUTS() \
+    while (sound_bufsize > 0) { \
+        int mix_l = 0, mix_r = 0; \
+        int span = sound_bufsize * l_tacts; \
+        AY_NEXT_EVENT(span) \
+        if (span > l_tacts && l_tacts > 0) { \
+            int whole = (span - 1) / l_tacts; \
+            int n = whole * l_tacts; \
+            AY_ADVANCE(n) \
+            MIX(l_tacts) \
+            sound_bufsize -= whole; \
+            while (whole-- > 0) { STORE } \
+            continue; \
+        } \
+        sound_bufsize--; \
+        for (int r = l_tacts; r > 0; ) { \
+            int k = r; \
+            AY_NEXT_EVENT(k) \
+            r -= k; \
+            MIX(k - 1) \
+            AY_ADVANCE(k) \
+            AY_OUTPUTS() \
+            MIX(1) \
+        } \
+        STORE \
+    } \
+    AY_WRITEBACK()
+
 // ABC stereo: A→L, B→L/2+R/2, C→R
+#define AY_MIX_ABC(n) \
+    mix_l += (n) * (out_a + (out_b >> 1)); \
+    mix_r += (n) * (out_c + (out_b >> 1));
+
+// ACB stereo: A→L, B→R, C→L/2+R/2
+#define AY_MIX_ACB(n) \
+    mix_l += (n) * (out_a + (out_c >> 1)); \
+    mix_r += (n) * (out_b + (out_c >> 1));
+
+// Mono: all channels → both L and R equally
+#define AY_MIX_MONO(n) \
+    mix_l += (n) * (out_a + out_b + out_c);
+
+#define AY_STORE_STEREO \
+    *sound_buf_L++ = (mix_l * l_inv_amp) >> 16; \
+    *sound_buf_R++ = (mix_r * l_inv_amp) >> 16;
+
+#define AY_STORE_MONO \
+    uint8_t out = (mix_l * l_inv_amp) >> 16; \
+    *sound_buf_L++ = out; \
+    *sound_buf_R++ = out; \
+    (void)mix_r;
+
 IRAM_ATTR void AySound::gen_sound_ABC(int sound_bufsize, uint8_t *sound_buf_L, uint8_t *sound_buf_R) {
-    AY_HOIST_LOCALS()
-    while (sound_bufsize-- > 0) {
-        int mix_l = 0, mix_r = 0;
-        for (int m = 0; m < l_tacts; m++) {
-            AY_TICK_COUNTERS()
-            if ((l_bit_a | !l_R7ta) & (l_bit_n | !l_R7na)) {
-                mix_l += AY_CHVOL(l_env_a, l_vol_a);
-            }
-            if ((l_bit_b | !l_R7tb) & (l_bit_n | !l_R7nb)) {
-                int v = AY_CHVOL(l_env_b, l_vol_b) >> 1;
-                mix_l += v;
-                mix_r += v;
-            }
-            if ((l_bit_c | !l_R7tc) & (l_bit_n | !l_R7nc)) {
-                mix_r += AY_CHVOL(l_env_c, l_vol_c);
-            }
-        }
-        *sound_buf_L++ = (mix_l * l_inv_amp) >> 16;
-        *sound_buf_R++ = (mix_r * l_inv_amp) >> 16;
-    }
-    AY_WRITEBACK()
+    AY_GEN_LOOP(AY_MIX_ABC, AY_STORE_STEREO)
 }
 
-// ACB stereo: A→L, B→R, C→L/2+R/2
 IRAM_ATTR void AySound::gen_sound_ACB(int sound_bufsize, uint8_t *sound_buf_L, uint8_t *sound_buf_R) {
-    AY_HOIST_LOCALS()
-    while (sound_bufsize-- > 0) {
-        int mix_l = 0, mix_r = 0;
-        for (int m = 0; m < l_tacts; m++) {
-            AY_TICK_COUNTERS()
-            if ((l_bit_a | !l_R7ta) & (l_bit_n | !l_R7na)) {
-                mix_l += AY_CHVOL(l_env_a, l_vol_a);
-            }
-            if ((l_bit_b | !l_R7tb) & (l_bit_n | !l_R7nb)) {
-                mix_r += AY_CHVOL(l_env_b, l_vol_b);
-            }
-            if ((l_bit_c | !l_R7tc) & (l_bit_n | !l_R7nc)) {
-                int v = AY_CHVOL(l_env_c, l_vol_c) >> 1;
-                mix_l += v;
-                mix_r += v;
-            }
-        }
-        *sound_buf_L++ = (mix_l * l_inv_amp) >> 16;
-        *sound_buf_R++ = (mix_r * l_inv_amp) >> 16;
-    }
-    AY_WRITEBACK()
+    AY_GEN_LOOP(AY_MIX_ACB, AY_STORE_STEREO)
 }
 
-// Mono: all channels → both L and R equally
 IRAM_ATTR void AySound::gen_sound_MONO(int sound_bufsize, uint8_t *sound_buf_L, uint8_t *sound_buf_R) {
-    AY_HOIST_LOCALS()
-    while (sound_bufsize-- > 0) {
-        int mix = 0;
-        for (int m = 0; m < l_tacts; m++) {
-            AY_TICK_COUNTERS()
-            if ((l_bit_a | !l_R7ta) & (l_bit_n | !l_R7na)) {
-                mix += AY_CHVOL(l_env_a, l_vol_a);
-            }
-            if ((l_bit_b | !l_R7tb) & (l_bit_n | !l_R7nb)) {
-                mix += AY_CHVOL(l_env_b, l_vol_b);
-            }
-            if ((l_bit_c | !l_R7tc) & (l_bit_n | !l_R7nc)) {
-                mix += AY_CHVOL(l_env_c, l_vol_c);
-            }
-        }
-        uint8_t out = (mix * l_inv_amp) >> 16;
-        *sound_buf_L++ = out;
-        *sound_buf_R++ = out;
-    }
-    AY_WRITEBACK()
+    AY_GEN_LOOP(AY_MIX_MONO, AY_STORE_MONO)
 }
 
-IRAM_ATTR void AySound::gen_sound(int sound_bufsize, int bufpos)
+IRAM_ATTR void AySound::gen_span(int sound_bufsize, int bufpos)
 {
     uint8_t *sound_buf_L = SamplebufAY_L + bufpos;
     uint8_t *sound_buf_R = SamplebufAY_R + bufpos;
@@ -421,77 +482,86 @@ IRAM_ATTR void AySound::gen_sound(int sound_bufsize, int bufpos)
     }
 }
 
+// Generate [bufpos, bufpos + bufsize), applying each queued write at its
+// sample: samples before pos use the old value. Writes at or past the end
+// stay queued for the next call.
+IRAM_ATTR void AySound::gen_sound(int sound_bufsize, int bufpos)
+{
+    int end = bufpos + sound_bufsize;
+    while (wq_rd < wq_len && wq[wq_rd].pos < end) {
+        const ay_write_t &w = wq[wq_rd++];
+        if (w.pos > bufpos) {
+            gen_span(w.pos - bufpos, bufpos);
+            bufpos = w.pos;
+        }
+        applyRegister(w.reg, w.data);
+    }
+    if (wq_rd == wq_len) wq_rd = wq_len = 0;
+    if (end > bufpos) gen_span(end - bufpos, bufpos);
+}
+
 IRAM_ATTR uint8_t* AySound::gen_sound()
 {
     // Single-sample variant — delegates to batch with bufsize=1
-    gen_sound(1, 0);
+    gen_span(1, 0);
     SamplebufAY[0] = SamplebufAY_L[0];
     SamplebufAY[1] = SamplebufAY_R[0];
     return SamplebufAY;
 }
 
-#undef AY_TICK_COUNTERS
+#undef AY_DIST
+#undef AY_STEP
+#undef AY_NOISE_SEED
+#undef AY_ENV_NEXT
+#undef AY_NEXT_EVENT
+#undef AY_ADVANCE
 #undef AY_HOIST_LOCALS
+#undef AY_SKIP_SILENT
 #undef AY_WRITEBACK
 #undef AY_CHVOL
-#undef ENVVOL
-
-void AySound::updToneA() {
-    ayregs.tone_a = regs[0] + ((regs[1] & 0x0f) << 8);
-}
-
-void AySound::updToneB() {
-    ayregs.tone_b = regs[2] + ((regs[3] & 0x0f) << 8);
-}
-
-void AySound::updToneC() {
-    ayregs.tone_c = regs[4] + ((regs[5] & 0x0f) << 8);
-}
-
-void AySound::updNoisePitch() {
-    ayregs.noise = regs[6] & 0x1f;
-}
-
-void AySound::updMixer() {
-    ayregs.R7_tone_a = !(regs[7] & 0x01);
-    ayregs.R7_tone_b = !(regs[7] & 0x02);
-    ayregs.R7_tone_c = !(regs[7] & 0x04);
-
-    ayregs.R7_noise_a = !(regs[7] & 0x08);
-    ayregs.R7_noise_b = !(regs[7] & 0x10);
-    ayregs.R7_noise_c = !(regs[7] & 0x20);
-}
-
-void AySound::updVolA() {
-    ayregs.vol_a = regs[8] & 0x0f;
-    ayregs.env_a = regs[8] & 0x10;
-}
-
-void AySound::updVolB() {
-    ayregs.vol_b = regs[9] & 0x0f;
-    ayregs.env_b = regs[9] & 0x10;
-}
-
-void AySound::updVolC() {
-    ayregs.vol_c = regs[10] & 0x0f;
-    ayregs.env_c = regs[10] & 0x10;
-}
-
-void AySound::updEnvFreq() {
-    ayregs.env_freq = regs[11] + (regs[12] << 8);
-}
-
-void AySound::updEnvType() {
-    
-    // This shouldn't happen on AY
-    // if (regs[13] == 0xff) { // R13 = 255 means continue current envelop
-    //     // printf("ENV TYPE 0xff!\n");
-    //     return;
-    // }
-
-    ayregs.env_style = regs[13] & 0x0f;
-    env_pos = cnt_e = 0;
-
+#undef AY_OUTPUTS
+#undef AY_GEN_LOOP
+#undef AY_MIX_ABC
+#undef AY_MIX_ACB
+#undef AY_MIX_MONO
+#undef AY_STORE_STEREO
+#undef AY_STORE_MONO
+
+// Update the generator's view of one register. Tone and envelope periods
+// are composed from what the generator already has rather than from regs[],
+// which may already hold writes still queued behind this one.
+IRAM_ATTR void AySound::applyRegister(uint8_t reg, uint8_t data)
+{
+    switch (reg) {
+        case 0: ayregs.tone_a = (ayregs.tone_a & 0xf00) | data; break;
+        case 1: ayregs.tone_a = (ayregs.tone_a & 0x0ff) | ((data & 0x0f) << 8); break;
+        case 2: ayregs.tone_b = (ayregs.tone_b & 0xf00) | data; break;
+        case 3: ayregs.tone_b = (ayregs.tone_b & 0x0ff) | ((data & 0x0f) << 8); break;
+        case 4: ayregs.tone_c = (ayregs.tone_c & 0xf00) | data; break;
+        case 5: ayregs.tone_c = (ayregs.tone_c & 0x0ff) | ((data & 0x0f) << 8); break;
+        case 6: ayregs.noise = data & 0x1f; break;
+        case 7:
+            ayregs.R7_tone_a = !(data & 0x01);
+            ayregs.R7_tone_b = !(data & 0x02);
+            ayregs.R7_tone_c = !(data & 0x04);
+            ayregs.R7_noise_a = !(data & 0x08);
+            ayregs.R7_noise_b = !(data & 0x10);
+            ayregs.R7_noise_c = !(data & 0x20);
+            break;
+        case 8: ayregs.vol_a = data & 0x0f; ayregs.env_a = data & 0x10; break;
+        case 9: ayregs.vol_b = data & 0x0f; ayregs.env_b = data & 0x10; break;
+        case 10: ayregs.vol_c = data & 0x0f; ayregs.env_c = data & 0x10; break;
+        case 11: ayregs.env_freq = (ayregs.env_freq & 0xff00) | data; break;
+        case 12: ayregs.env_freq = (ayregs.env_freq & 0x00ff) | (data << 8); break;
+        case 13:
+            // This shouldn't happen on AY
+            // if (data == 0xff) { // R13 = 255 means continue current envelop
+            //     return;
+            // }
+            ayregs.env_style = data & 0x0f;
+            env_pos = cnt_e = 0;
+            break;
+    }
 }
 
 void AySound::updIOPortA() {
@@ -538,23 +608,12 @@ uint8_t AySound::getRegisterData()
         return 0xFF;
     }
 
+    // From regs[] rather than ayregs: the generator may not have caught up
     switch(selectedRegister) {
-      case 0x00: return ayregs.tone_a & 0xff;
-      case 0x01: return (ayregs.tone_a >> 8) & 0x0f;
-      case 0x02: return ayregs.tone_b & 0xff;
-      case 0x03: return (ayregs.tone_b >> 8) & 0x0f;
-      case 0x04: return ayregs.tone_c & 0xff;
-      case 0x05: return (ayregs.tone_c >> 8) & 0x0f;
-      case 0x06: return ayregs.noise & 0x1f;
-      case 0x07: return regs[7];
-      case 0x08: return ayregs.env_a + ayregs.vol_a;
-      case 0x09: return ayregs.env_b + ayregs.vol_b;
-      case 0x0a: return ayregs.env_c + ayregs.vol_c;
-      case 0x0b: return ayregs.env_freq & 0x00ff;
-      case 0x0c: return ayregs.env_freq >> 8;
-      case 0x0d: return ayregs.env_style & 0x0f;
-      case 0x0e: return ayregs.IOPortA;
-      case 0x0f: return ayregs.IOPortB;
+      case 0x01: case 0x03: case 0x05: case 0x0d: return regs[selectedRegister] & 0x0f;
+      case 0x06: case 0x08: case 0x09: case 0x0a: return regs[selectedRegister] & 0x1f;
+      case 0x00: case 0x02: case 0x04: case 0x07: case 0x0b: case 0x0c:
+      case 0x0e: case 0x0f: return regs[selectedRegister];
     }
     
     return 0;
@@ -577,42 +636,59 @@ void AySound::selectRegister(uint8_t registerNumber)
     selectedRegister = registerNumber;
 }
 
+// Chip select and data strobe for the external AY on the 595 bus
+static inline void ay_hw_write(uint8_t data)
+{
+    if (AySound::selected_chip == 0) {
+        HIGH(CS_AY0);
+        LOW(CS_AY1);
+    } else {
+        HIGH(CS_AY1);
+        LOW(CS_AY0);
+    }
+    send_to_595(LOW (BDIR) | data);
+    send_to_595(HIGH(BDIR) | data);
+    send_to_595(LOW (BDIR) | data);
+}
+
 void AySound::setRegisterData(uint8_t data)
 {
-    if (Config::audio_driver == 3) {
-        if (selected_chip == 0) {
-            HIGH(CS_AY0);
-            LOW(CS_AY1);
-        } else {
-            HIGH(CS_AY1);
-            LOW(CS_AY0);
+    if (Config::audio_driver == 3) ay_hw_write(data);
+    if (selectedRegister < 16) {
+        regs[selectedRegister] = data;
+        switch (selectedRegister) {
+            case 14: updIOPortA(); break;
+            case 15: updIOPortB(); break;
+            default: applyRegister(selectedRegister, data); break;
         }
-        send_to_595(LOW (BDIR) | data);
-        send_to_595(HIGH(BDIR) | data);
-        send_to_595(LOW (BDIR) | data);
     }
+
+}
+
+IRAM_ATTR void AySound::queueRegisterData(uint8_t data, uint16_t pos)
+{
+    if (Config::audio_driver == 3) ay_hw_write(data);
     if (selectedRegister < 16) {
         regs[selectedRegister] = data;
         switch (selectedRegister) {
-            case 0: updToneA(); break;
-            case 1: updToneA(); break;
-            case 2: updToneB(); break;
-            case 3: updToneB(); break;
-            case 4: updToneC(); break;
-            case 5: updToneC(); break;
-            case 6: updNoisePitch(); break;
-            case 7: updMixer(); break;
-            case 8: updVolA(); break;
-            case 9: updVolB(); break;
-            case 10: updVolC(); break;
-            case 11: updEnvFreq(); break;
-            case 12: updEnvFreq(); break;
-            case 13: updEnvType(); break;
+            // I/O ports don't feed the generator; the MIDI decoder wants them now
             case 14: updIOPortA(); break;
             case 15: updIOPortB(); break;
+            default:
+                if (wq_len == AY_WQ_SIZE) flushWrites();
+                wq[wq_len++] = { pos, selectedRegister, data };
+                break;
         }
     }
+}
 
+void AySound::flushWrites()
+{
+    while (wq_rd < wq_len) {
+        applyRegister(wq[wq_rd].reg, wq[wq_rd].data);
+        wq_rd++;
+    }
+    wq_rd = wq_len = 0;
 }
 
 void AySound::reset()
@@ -655,20 +731,8 @@ void AySound::reset()
     midi_bitbang_prev = true; // idle = HIGH
 #endif
 
-    updToneA();
-    updToneA();
-    updToneB();
-    updToneB();
-    updToneC();
-    updToneC();
-    updNoisePitch();
-    updMixer();
-    updVolA();
-    updVolB();
-    updVolC();
-    updEnvFreq();
-    updEnvFreq();
-    updEnvType();
+    wq_len = wq_rd = 0;
+    for (int i = 0; i < 14; i++) applyRegister(i, regs[i]);
     updIOPortA();
     updIOPortB();
 }
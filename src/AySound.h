@@ -46,6 +46,14 @@ visit https://zxespectrum.speccy.org/contacto
 
 // typedef unsigned char ayemu_ay_reg_frame_t[14];
 
+// Register writes queued per chip and frame; a full queue makes the caller
+// generate up to the current sample first (ESPectrum::AYWrite)
+#if !PICO_RP2040
+#define AY_WQ_SIZE 1024
+#else
+#define AY_WQ_SIZE 128
+#endif
+
 /* Types of stereo.
     The codes of stereo types used for generage sound. */
 typedef enum
@@ -134,16 +142,6 @@ class AySound
 public:
     static int selected_chip;
     AySound(uint8_t my_num): my_num(my_num) {}
-    void updToneA();
-    void updToneB();
-    void updToneC();
-    void updNoisePitch();
-    void updMixer();
-    void updVolA();
-    void updVolB();
-    void updVolC();
-    void updEnvFreq();
-    void updEnvType();
     void updIOPortA();
     void updIOPortB();
     
@@ -151,6 +149,11 @@ public:
     uint8_t getRegisterData();
     void selectRegister(uint8_t data);
     void setRegisterData(uint8_t data);
+    // Data write logged for the generator at output sample pos instead of
+    // applied at once; gen_sound() replays it when it reaches that sample
+    void queueRegisterData(uint8_t data, uint16_t pos);
+    bool queueFull() { return wq_len == AY_WQ_SIZE; }
+    void flushWrites();          // apply what is still queued, no output
 
     void init();
     int set_chip_type(ayemu_chip_t chip, int *custom_table);
@@ -162,6 +165,8 @@ public:
     uint8_t* gen_sound();
 
 private:
+    void applyRegister(uint8_t reg, uint8_t data);
+    void gen_span(int bufsize, int bufpos);
     void gen_sound_ABC(int bufsize, uint8_t *buf_L, uint8_t *buf_R);
     void gen_sound_ACB(int bufsize, uint8_t *buf_L, uint8_t *buf_R);
     void gen_sound_MONO(int bufsize, uint8_t *buf_L, uint8_t *buf_R);
@@ -182,7 +187,7 @@ private:
                                             // Array contains 6 elements: 
                                             // A left, A right, B left, B right, C left and C right;
                                             // range -100...100 */
-    ayemu_regdata_t ayregs;          /*< parsed registers data */
+    ayemu_regdata_t ayregs;          /*< parsed registers data, as the generator sees them */
     ayemu_sndfmt_t sndfmt;           /*< output sound format */
 
     // flags
@@ -208,9 +213,14 @@ private:
     int env_pos;                     /*< current position in envelop (0...127) */
     int Cur_Seed;                    /*< random numbers counter */
 
-    uint8_t regs[16];
+    uint8_t regs[16];                /*< as the CPU last wrote them */
     uint8_t selectedRegister;
 
+    struct ay_write_t { uint16_t pos; uint8_t reg, data; };
+    ay_write_t wq[AY_WQ_SIZE];       /*< writes not yet seen by the generator */
+    uint16_t wq_len;
+    uint16_t wq_rd;
+
 #if !PICO_RP2040
     // Bit-bang UART decoder for MIDI via AY IOPortA (reg 14, bit 2)
     int8_t midi_bitbang_pos;   // -1=idle, 0=start received, 1-8=data bits, 9=stop
@@ -43,6 +43,7 @@ visit https://zxespectrum.speccy.org/contacto
 #include "Z80_JLS/z80.h"
 #include "psram_spi.h"
 #include "Debug.h"
+#include "Profiler.h"
 #include "Z80DMA.h"
 #if !PICO_RP2040
 #include "DivMMC.h"
@@ -189,6 +190,8 @@ void CPU::reset() {
     }
 #endif
 
+    Ports::decodeInit();
+
     updateStatesInFrame();
 
     tstates = 0;
@@ -202,9 +205,32 @@ IRAM_ATTR void CPU::step() {
     Z80::execute();
 }
 
-#define BREAKPOINTS if (pbbp || (nbp > 0 && Config::hasBreakPoint(Z80::getRegPC(), Config::BP_PC))) { VIDEO::EndFrame(); return; }
+// Breakpoint predicate (see Config::hitBreakPoint): only reached on a bitmap hit
+IRAM_ATTR bool Config::bpCondMatch(const BreakPoint& bp, uint8_t value) {
+    uint16_t v;
+    switch (bp.cond) {
+        case BPC_NONE: return true;
+        case BPC_A:  v = Z80::getRegA(); break;
+        case BPC_BC: v = Z80::getRegBC(); break;
+        case BPC_DE: v = Z80::getRegDE(); break;
+        case BPC_HL: v = Z80::getRegHL(); break;
+        case BPC_IX: v = Z80::getRegIX(); break;
+        case BPC_IY: v = Z80::getRegIY(); break;
+        case BPC_SP: v = Z80::getRegSP(); break;
+        case BPC_VAL: v = value; break;
+        default: return true;
+    }
+    return (v == bp.condVal) != bp.condNe;
+}
+
+#define BREAKPOINTS if (pbbp || (nbp > 0 && Config::hitBreakPoint(Z80::getRegPC(), Config::BP_PC))) { VIDEO::EndFrame(); return; }
 
 
+// Horizonte de eventos: entre dos eventos observables (fin de la ventana INT,
+// HALT, fin de frame) la CPU corre sin volver aquí. El ULA se dibuja dentro de
+// fetch/peek/poke, el WD1793 avanza por frame y la cinta se evalúa al leer el
+// puerto, así que nada de eso corta el lote. Sólo un breakpoint armado o el modo
+// DMA obligan a comprobar instrucción a instrucción.
 IRAM_ATTR void CPU::loop() {
     bool pbbp = CPU::portBasedBP;
     if (paused || pbbp) {
@@ -212,6 +238,12 @@ IRAM_ATTR void CPU::loop() {
         return;
     }
     int nbp = Config::numPcBP;
+#if !PICO_RP2040
+    bool dma = Config::dma_mode;
+#else
+    const bool dma = false;
+#endif
+    bool batch = (nbp == 0) && !dma;
 
     BREAKPOINTS
     // Check NMI
@@ -222,29 +254,46 @@ IRAM_ATTR void CPU::loop() {
         Z80::execute();
         Z80::doNMI();
     }
-    while (tstates < IntEnd) {
-        Z80::execute();
+    if (batch) {
+        Z80::execUntil(IntEnd);
+    } else {
+        while (tstates < IntEnd) {
+            Z80::execute();
 #if !PICO_RP2040
-        if (Config::dma_mode) Z80DMA::handleDMA();
+            if (dma) Z80DMA::handleDMA();
 #endif
-        BREAKPOINTS
+            BREAKPOINTS
+        }
     }
     BREAKPOINTS
     bool halted = Z80::isHalted();
     if (!halted) {
         stFrame = statesInFrame - IntEnd;
-        Z80::exec_nocheck();
+        if (nbp == 0) {
+            Z80::exec_nocheck();
+        } else {
+            // Fuera de la ventana INT checkINT() no hace nada: execute() equivale
+            // a exec_nocheck() instrucción a instrucción (HALT pone stFrame = 0)
+            while (tstates < stFrame) {
+                Z80::execute();
+                if (Config::hitBreakPoint(Z80::getRegPC(), Config::BP_PC)) break;
+            }
+        }
         if (stFrame == 0) { tstates_active = tstates; FlushOnHalt(); halted = true; }
     } else {
         tstates_active = tstates; FlushOnHalt();
     }
     BREAKPOINTS
-    while (tstates < statesInFrame) {
-        Z80::execute();
+    if (batch) {
+        Z80::execUntil(statesInFrame);
+    } else {
+        while (tstates < statesInFrame) {
+            Z80::execute();
 #if !PICO_RP2040
-        if (Config::dma_mode) Z80DMA::handleDMA();
+            if (dma) Z80DMA::handleDMA();
 #endif
-        BREAKPOINTS
+            BREAKPOINTS
+        }
     }
     VIDEO::EndFrame();
 
@@ -252,7 +301,9 @@ IRAM_ATTR void CPU::loop() {
 
     if ((ESPectrum::fdd.control & (kRVMWD177XHLD | kRVMWD177XHLT)) != 0)
     {
+        uint32_t prof = Profiler::begin();
         rvmWD1793Step(&ESPectrum::fdd, CPU::tstates_diff / WD177XSTEPSTATES); // FDD
+        Profiler::end(PROF_FDC, prof);
     }
     CPU::tstates_diff = CPU::tstates_diff % WD177XSTEPSTATES;
 
@@ -62,6 +62,9 @@ int Config::numPortReadBP = 0;
 int Config::numPortWriteBP = 0;
 int Config::numMemWriteBP = 0;
 int Config::numMemReadBP = 0;
+int Config::numCondBP = 0;
+uint8_t Config::bpPage[Config::BP_TYPES][256] = { 0 };
+uint32_t Config::bpBits[Config::MAX_BREAKPOINTS][8];
 
 uint8_t  Config::joystick = JOY_KEMPSTON;
 uint16_t Config::joydef[12] = {
@@ -165,6 +168,7 @@ void Config::initHotkeys() {
         { fabgl::VK_END,    true,  true,  false }, // HK_VIDMODE_50
         { fabgl::VK_F3,     true,  false, false }, // HK_QUICK_LOAD
         { fabgl::VK_F4,     true,  false, false }, // HK_QUICK_SAVE
+        { fabgl::VK_BACKSPACE, true, false, false }, // HK_REWIND
     };
     for (int i = 0; i < HK_COUNT; i++)
         hotkeys[i] = defaults[i];
@@ -491,6 +495,13 @@ void Config::load() {
             nvs_get_u8(key, t, sts);
             breakPoints[i].type = (BPType)t;
             if (breakPoints[i].type == BP_NONE) breakPoints[i].addr = 0xFFFF;
+            uint8_t c = BPC_NONE;
+            snprintf(key, sizeof(key), "bpc%d", i);
+            nvs_get_u8(key, c, sts);
+            breakPoints[i].cond = (c & 0x7F) < BPC_COUNT ? (BPCond)(c & 0x7F) : BPC_NONE;
+            breakPoints[i].condNe = (c & 0x80) != 0;
+            snprintf(key, sizeof(key), "bpv%d", i);
+            nvs_get_u16(key, breakPoints[i].condVal, sts);
         }
         // Migrate old single breakPoint
         {
@@ -756,6 +767,10 @@ void Config::save() {
         nvs_set_u16(buf, key, breakPoints[i].addr);
         snprintf(key, sizeof(key), "bpt%d", i);
         nvs_set_u8(buf, key, (uint8_t)breakPoints[i].type);
+        snprintf(key, sizeof(key), "bpc%d", i);
+        nvs_set_u8(buf, key, (uint8_t)breakPoints[i].cond | (breakPoints[i].condNe ? 0x80 : 0));
+        snprintf(key, sizeof(key), "bpv%d", i);
+        nvs_set_u16(buf, key, breakPoints[i].condVal);
     }
     nvs_set_u8(buf,"joystick", Config::joystick);
     // Write joystick definition
@@ -38,6 +38,7 @@ visit https://zxespectrum.speccy.org/contacto
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
 #include <string>
 #include "Debug.h"
 
@@ -107,7 +108,11 @@ public:
     static bool     rightSpace;
     static bool     wasd;
     enum BPType : uint8_t { BP_PC=0, BP_PORT_READ=1, BP_PORT_WRITE=2, BP_MEM_WRITE=3, BP_MEM_READ=4, BP_NONE=0xFF };
-    struct BreakPoint { uint16_t addr = 0xFFFF; BPType type = BP_NONE; };
+    static constexpr int BP_TYPES = 5;
+    // Optional predicate, evaluated only when the bitmap says addr is armed.
+    // BPC_VAL is the byte read/written (MR, MW, PW); unused for PC and PR.
+    enum BPCond : uint8_t { BPC_NONE=0, BPC_A, BPC_BC, BPC_DE, BPC_HL, BPC_IX, BPC_IY, BPC_SP, BPC_VAL, BPC_COUNT };
+    struct BreakPoint { uint16_t addr = 0xFFFF; BPType type = BP_NONE; BPCond cond = BPC_NONE; bool condNe = false; uint16_t condVal = 0; };
     static constexpr int MAX_BREAKPOINTS = 20;
     static BreakPoint breakPoints[MAX_BREAKPOINTS];
     static int numBreakPoints;
@@ -117,8 +122,17 @@ public:
     static int numPortWriteBP;
     static int numMemWriteBP;
     static int numMemReadBP;
+    // Per-type 64K-bit bitmap, paged on demand: bpPage[type][addr >> 8] is 1 + index
+    // of a 256-bit page in bpBits, 0 if nothing is armed in those 256 addresses.
+    // At most one page per breakpoint, so the whole thing stays under 2 KB.
+    static uint8_t bpPage[BP_TYPES][256];
+    static uint32_t bpBits[MAX_BREAKPOINTS][8];
+    static int numCondBP;
     static void recountBP() {
         numBreakPoints = numPcBP = numPortReadBP = numPortWriteBP = numMemWriteBP = numMemReadBP = 0;
+        numCondBP = 0;
+        memset(bpPage, 0, sizeof(bpPage));
+        int pages = 0;
         for (int i = 0; i < MAX_BREAKPOINTS; i++) {
             if (breakPoints[i].type == BP_NONE) continue;
             numBreakPoints++;
@@ -128,22 +142,41 @@ public:
                 case BP_PORT_WRITE: numPortWriteBP++; break;
                 case BP_MEM_WRITE: numMemWriteBP++; break;
                 case BP_MEM_READ: numMemReadBP++; break;
-                default: break;
+                default: continue;
             }
+            if (breakPoints[i].cond != BPC_NONE) numCondBP++;
+            uint16_t addr = breakPoints[i].addr;
+            uint8_t &pg = bpPage[breakPoints[i].type][addr >> 8];
+            if (!pg) {
+                pg = ++pages;
+                memset(bpBits[pg - 1], 0, sizeof(bpBits[0]));
+            }
+            bpBits[pg - 1][(addr >> 5) & 7] |= 1u << (addr & 31);
         }
     }
-    static bool hasBreakPoint(uint16_t addr, BPType type) {
-        for (int i = 0; i < MAX_BREAKPOINTS; i++)
-            if (breakPoints[i].addr == addr && breakPoints[i].type == type) return true;
-        return false;
+    // O(1): is any breakpoint of this type set at addr (conditions ignored)
+    static inline bool hasBreakPoint(uint16_t addr, BPType type) {
+        uint8_t pg = bpPage[type][addr >> 8];
+        return pg && ((bpBits[pg - 1][(addr >> 5) & 7] >> (addr & 31)) & 1);
     }
     // Legacy: check any BP_PC at addr
     static bool hasBreakPoint(uint16_t addr) { return hasBreakPoint(addr, BP_PC); }
-    static bool addBreakPoint(uint16_t addr, BPType type) {
+    // Should execution stop here: bitmap first, predicates only on a bitmap hit
+    static inline bool hitBreakPoint(uint16_t addr, BPType type, uint8_t value = 0) {
+        if (!hasBreakPoint(addr, type)) return false;
+        if (numCondBP == 0) return true;
+        for (int i = 0; i < MAX_BREAKPOINTS; i++) {
+            const BreakPoint &bp = breakPoints[i];
+            if (bp.addr == addr && bp.type == type && bpCondMatch(bp, value)) return true;
+        }
+        return false;
+    }
+    static bool bpCondMatch(const BreakPoint& bp, uint8_t value); // CPU.cpp, needs Z80 registers
+    static bool addBreakPoint(uint16_t addr, BPType type, BPCond cond = BPC_NONE, bool condNe = false, uint16_t condVal = 0) {
         if (hasBreakPoint(addr, type)) return false;
         for (int i = 0; i < MAX_BREAKPOINTS; i++) {
             if (breakPoints[i].type == BP_NONE) {
-                breakPoints[i] = {addr, type};
+                breakPoints[i] = {addr, type, cond, condNe, condVal};
                 recountBP();
                 return true;
             }
@@ -154,7 +187,7 @@ public:
     static bool removeBreakPoint(uint16_t addr, BPType type) {
         for (int i = 0; i < MAX_BREAKPOINTS; i++) {
             if (breakPoints[i].addr == addr && breakPoints[i].type == type) {
-                breakPoints[i] = {0xFFFF, BP_NONE};
+                breakPoints[i] = BreakPoint();
                 recountBP();
                 return true;
             }
@@ -164,7 +197,7 @@ public:
     static bool removeBreakPoint(uint16_t addr) { return removeBreakPoint(addr, BP_PC); }
     static void removeBreakPointAt(int idx) {
         if (idx >= 0 && idx < MAX_BREAKPOINTS) {
-            breakPoints[idx] = {0xFFFF, BP_NONE};
+            breakPoints[idx] = BreakPoint();
             recountBP();
         }
     }
@@ -178,6 +211,19 @@ public:
             default: return "??";
         }
     }
+    static const char* bpCondName(BPCond c) {
+        switch(c) {
+            case BPC_A: return "A";
+            case BPC_BC: return "BC";
+            case BPC_DE: return "DE";
+            case BPC_HL: return "HL";
+            case BPC_IX: return "IX";
+            case BPC_IY: return "IY";
+            case BPC_SP: return "SP";
+            case BPC_VAL: return "V";
+            default: return "";
+        }
+    }
     static uint8_t  joystick;
     static uint16_t joydef[12];
     static uint8_t  AluTiming;
@@ -275,7 +321,8 @@ public:
         HK_VIDMODE_50   = 26,
         HK_QUICK_LOAD   = 27,
         HK_QUICK_SAVE   = 28,
-        HK_COUNT        = 29
+        HK_REWIND       = 29,
+        HK_COUNT        = 30
     };
 
     struct HotkeyBinding {
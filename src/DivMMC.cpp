@@ -74,11 +74,26 @@ int DivMMC::mmc_ocr_index = -1;
 
 uint32_t DivMMC::mmc_read_address = 0;
 uint32_t DivMMC::mmc_write_address = 0;
+int DivMMC::mmc_block_index = -1;
+bool DivMMC::mmc_data_resp = false;
 
 uint8_t DivMMC::mmc_sector_buf[512];
 uint32_t DivMMC::mmc_sector_buf_addr = 0xFFFFFFFF;
 bool DivMMC::mmc_sector_dirty = false;
 
+// Sector cache
+DivMMC::sc_stats_t DivMMC::sc_stats = { 0, 0, 0, 0, 0 };
+uint32_t DivMMC::psram_bytes = 0;
+DivMMC::sc_line_t DivMMC::sc_line[DIVMMC_SC_LINES];
+uint8_t* DivMMC::sc_buf = nullptr;
+uint8_t* DivMMC::sc_heap = nullptr;
+int DivMMC::sc_lines = 0;
+uint32_t DivMMC::sc_tick = 0;
+uint8_t DivMMC::sc_idle = 0;
+bool DivMMC::sc_dirty = false;
+bool DivMMC::sc_synced[2] = {true, true};
+uint32_t DivMMC::sc_next[2] = {0xFFFFFFFF, 0xFFFFFFFF};
+
 FIL DivMMC::mmc_file[2];
 bool DivMMC::mmc_file_open[2] = {false, false};
 uint32_t DivMMC::mmc_file_size[2] = {0, 0};
@@ -93,14 +108,17 @@ uint8_t DivMMC::mmc_cid[16] = {1,'P','I','C','O',' ','S','D',' ',1,1,1,1,1,127,1
 uint8_t DivMMC::mmc_ocr[5] = {5,0,0,0,0};
 
 void DivMMC::init() {
+    // Pending writes belong to the mode and images being replaced
+    flush();
+    sc_drop();
+
     enabled = (Config::esxdos != 0);
     divsd_mode = (Config::esxdos == 3);
     divide_mode = (Config::esxdos == 2);
 
     // Free previous allocations if switching modes or disabling
     if (!enabled) {
-        // Flush pending writes and unmap before freeing memory
-        flushWriteBuffer();
+        // Unmap before freeing memory
         automap = false;
         conmem = false;
         mapram = false;
@@ -139,11 +157,21 @@ void DivMMC::init() {
     size_t butter_used = (size_t)butter_pages * MEM_PG_SZ;
     size_t butter_free = butter_psram_size() > butter_used ? butter_psram_size() - butter_used : 0;
 
+    size_t sc_total = (size_t)DIVMMC_SC_LINES * DIVMMC_SC_RUN * 512;
+
     if (butter_free >= divmmc_total) {
         use_psram = true;
         uint8_t* base = PSRAM_DATA + butter_used;
         for (int i = 0; i < DIVMMC_NUM_BANKS; i++)
             bank_ptr[i] = base + i * DIVMMC_BANK_SIZE;
+        psram_bytes = divmmc_total;
+        // Sector cache right above the banks if it fits, else on the heap
+        if (butter_free >= divmmc_total + sc_total) {
+            sc_setup(base + divmmc_total);
+            psram_bytes += sc_total;
+        } else {
+            sc_setup(nullptr);
+        }
         Debug::log("DivMMC: %d banks in butter PSRAM @ %p", DIVMMC_NUM_BANKS, base);
     } else {
         use_psram = false;
@@ -175,6 +203,8 @@ void DivMMC::init() {
             swap_open = true;
         }
         memset(bank_ptr, 0, sizeof(bank_ptr));
+        psram_bytes = 0;
+        sc_setup(nullptr);
         Debug::log("DivMMC: %d banks via swap file (%d cache slots)", DIVMMC_NUM_BANKS, allocated);
     }
     clearAllBanks();
@@ -189,6 +219,7 @@ void DivMMC::init() {
         mode_name = divsd_mode ? "DivSD" : "DivMMC";
     }
     rom_loaded = true;
+    Debug::log("DivMMC: sector cache %d x %d sectors", sc_lines, DIVMMC_SC_RUN);
     Debug::log("%s ROM verify: %02X %02X %02X %02X %02X %02X %02X @ %p",
         mode_name, esxdos_rom[0], esxdos_rom[1], esxdos_rom[2], esxdos_rom[3],
         esxdos_rom[4], esxdos_rom[5], esxdos_rom[6], esxdos_rom);
@@ -196,7 +227,6 @@ void DivMMC::init() {
     // Close previous images if open
     for (int d = 0; d < 2; d++) {
         if (mmc_file_open[d]) {
-            if (d == 0) flushWriteBuffer();
             f_close(&mmc_file[d]);
             mmc_file_open[d] = false;
             mmc_file_size[d] = 0;
@@ -302,6 +332,9 @@ void DivMMC::init() {
 
 void DivMMC::reopenFiles() {
     if (!enabled) return;
+    // Write back through the old handles; the card may have been changed
+    flush();
+    sc_drop();
     // Reopen MMC/HDF image files
     for (int d = 0; d < 2; d++) {
         if (mmc_file_open[d]) {
@@ -354,6 +387,8 @@ void DivMMC::reset() {
     mmc_ocr_index = -1;
     mmc_sector_buf_addr = 0xFFFFFFFF;
     mmc_sector_dirty = false;
+    mmc_block_index = -1;
+    mmc_data_resp = false;
 
     // Reset IDE state
     ide_feature = 0;
@@ -588,37 +623,174 @@ void DivMMC::flushWriteBuffer() {
     mmc_sector_dirty = false;
 }
 
-// Read one sector into mmc_sector_buf, with synthetic MBR for DivMMC images.
-// In DivMMC mode the .mmc file is "superfloppy" formatted (FAT16 starts at
-// sector 0). ZP4 expects an MBR with a partition table at sector 0, so we
-// synthesize one and shift the .mmc data by +1 sector.
-void DivMMC::loadSector(uint32_t sector) {
+// Read one sector into mmc_sector_buf through the sector cache. 'stream'
+// marks a multi-block read, so a miss fetches the sectors that follow too.
+// The .mmc image is presented byte-for-byte: sector 0 holds the FAT16 BPB
+// (superfloppy), there is no MBR.
+void DivMMC::loadSector(uint32_t sector, bool stream) {
+    sc_read(0, sector, mmc_sector_buf, stream);
+}
+
+void DivMMC::storeSector(uint32_t sector) {
+    sc_write(0, sector, mmc_sector_buf);
+}
+
+// Read 'n' consecutive sectors of 'unit' from the card or image file and
+// return how many were read: a raw multi-sector read that fails (past the
+// end of the card) is retried as a single sector.
+int DivMMC::io_read(int unit, uint32_t sector, uint8_t* dst, int n) {
     if (divsd_mode) {
-        disk_read(0, mmc_sector_buf, sector, 1);
-        return;
+        if (disk_read(0, dst, sector, n) != RES_OK && n > 1) {
+            n = 1;
+            disk_read(0, dst, sector, 1);
+        }
+        return n;
     }
-    if (!mmc_file_open[0]) {
-        memset(mmc_sector_buf, 0, 512);
-        return;
+    UINT len = n * 512, br = 0;
+    if (mmc_file_open[unit]) {
+        FSIZE_t pos = divide_mode ? ide_hdf_data_offset[unit] : 0;
+        f_lseek(&mmc_file[unit], pos + (FSIZE_t)sector * 512);
+        f_read(&mmc_file[unit], dst, len, &br);
     }
-    // Read the sector directly from the .mmc file. The image is presented
-    // byte-for-byte: sector 0 holds the FAT16 BPB (superfloppy), there is no MBR.
-    UINT br;
-    f_lseek(&mmc_file[0], (FSIZE_t)sector * 512);
-    f_read(&mmc_file[0], mmc_sector_buf, 512, &br);
-    if (br < 512) memset(mmc_sector_buf + br, 0, 512 - br);
+    if (br < len) memset(dst + br, divide_mode ? 0xFF : 0x00, len - br);
+    return n;
 }
 
-void DivMMC::storeSector(uint32_t sector) {
+// Write 'n' consecutive sectors; image files are synced by flush()
+void DivMMC::io_write(int unit, uint32_t sector, const uint8_t* src, int n) {
+    ++sc_stats.flushes;
     if (divsd_mode) {
-        disk_write(0, mmc_sector_buf, sector, 1);
+        disk_write(0, src, sector, n);
         return;
     }
-    if (!mmc_file_open[0]) return;
+    if (!mmc_file_open[unit]) return;
+    FSIZE_t pos = divide_mode ? ide_hdf_data_offset[unit] : 0;
     UINT bw;
-    f_lseek(&mmc_file[0], (FSIZE_t)sector * 512);
-    f_write(&mmc_file[0], mmc_sector_buf, 512, &bw);
-    f_sync(&mmc_file[0]);
+    f_lseek(&mmc_file[unit], pos + (FSIZE_t)sector * 512);
+    f_write(&mmc_file[unit], src, n * 512, &bw);
+    sc_synced[unit] = false;
+}
+
+// Use 'psram' (DIVMMC_SC_LINES lines) or, when null, a small heap buffer.
+// Without either the cache passes every sector straight through.
+void DivMMC::sc_setup(uint8_t* psram) {
+    if (psram) {
+        sc_buf = psram;
+        sc_lines = DIVMMC_SC_LINES;
+    } else {
+        if (!sc_heap) sc_heap = (uint8_t*)malloc(DIVMMC_SC_LINES_SRAM * DIVMMC_SC_RUN * 512);
+        sc_buf = sc_heap;
+        sc_lines = sc_heap ? DIVMMC_SC_LINES_SRAM : 0;
+    }
+    sc_drop();
+}
+
+// Forget every line, written back or not
+void DivMMC::sc_drop() {
+    for (int i = 0; i < DIVMMC_SC_LINES; i++) sc_line[i] = { 0xFFFFFFFF, 0, 0, 0, 0 };
+    sc_dirty = false;
+    sc_next[0] = sc_next[1] = 0xFFFFFFFF;
+}
+
+// Line holding sectors 'base'.. of 'unit'; the least recently used line is
+// written back and taken over when none does
+int DivMMC::sc_get(int unit, uint32_t base) {
+    int victim = 0;
+    for (int i = 0; i < sc_lines; i++) {
+        if (sc_line[i].base == base && sc_line[i].unit == unit) {
+            sc_line[i].lru = ++sc_tick;
+            return i;
+        }
+        if ((int32_t)(sc_line[i].lru - sc_line[victim].lru) < 0) victim = i;
+    }
+    sc_writeback(victim);
+    sc_line[victim] = { base, ++sc_tick, (uint8_t)unit, 0, 0 };
+    return victim;
+}
+
+void DivMMC::sc_read(int unit, uint32_t sector, uint8_t* dst, bool stream) {
+    stream |= sector == sc_next[unit];
+    sc_next[unit] = sector + 1;
+    sc_idle = 0;
+    if (!sc_lines) {
+        ++sc_stats.misses;
+        io_read(unit, sector, dst, 1);
+        return;
+    }
+    int bit = sector & (DIVMMC_SC_RUN - 1);
+    int i = sc_get(unit, sector - bit);
+    sc_line_t& l = sc_line[i];
+    uint8_t* p = sc_buf + ((size_t)i * DIVMMC_SC_RUN + bit) * 512;
+    if (l.valid & (1 << bit)) {
+        ++sc_stats.hits;
+    } else {
+        // A sequential miss reads on to the end of the line in one transfer
+        int n = 1;
+        if (stream) while (bit + n < DIVMMC_SC_RUN && !(l.valid & (1 << (bit + n)))) n++;
+        n = io_read(unit, sector, p, n);
+        l.valid |= ((1 << n) - 1) << bit;
+        ++sc_stats.misses;
+        sc_stats.readahead += n - 1;
+    }
+    memcpy(dst, p, 512);
+}
+
+void DivMMC::sc_write(int unit, uint32_t sector, const uint8_t* src) {
+    sc_idle = 0;
+    ++sc_stats.writes;
+    if (!sc_lines) {
+        io_write(unit, sector, src, 1);
+        return;
+    }
+    int bit = sector & (DIVMMC_SC_RUN - 1);
+    int i = sc_get(unit, sector - bit);
+    memcpy(sc_buf + ((size_t)i * DIVMMC_SC_RUN + bit) * 512, src, 512);
+    sc_line[i].valid |= 1 << bit;
+    sc_line[i].dirty |= 1 << bit;
+    sc_dirty = true;
+}
+
+// Write the dirty sectors of line 'i', one transfer per consecutive run
+void DivMMC::sc_writeback(int i) {
+    sc_line_t& l = sc_line[i];
+    for (int b = 0; l.dirty; ) {
+        if (!(l.dirty & (1 << b))) { b++; continue; }
+        int n = 1;
+        while (b + n < DIVMMC_SC_RUN && (l.dirty & (1 << (b + n)))) n++;
+        io_write(l.unit, l.base + b, sc_buf + ((size_t)i * DIVMMC_SC_RUN + b) * 512, n);
+        l.dirty &= ~(((1 << n) - 1) << b);
+        b += n;
+    }
+}
+
+void DivMMC::flush() {
+    flushWriteBuffer();
+    if (sc_dirty) {
+        // Lowest address first, so images are written front to back
+        for (;;) {
+            int next = -1;
+            for (int i = 0; i < sc_lines; i++) {
+                if (!sc_line[i].dirty) continue;
+                if (next < 0 || sc_line[i].unit < sc_line[next].unit ||
+                    (sc_line[i].unit == sc_line[next].unit && sc_line[i].base < sc_line[next].base))
+                    next = i;
+            }
+            if (next < 0) break;
+            sc_writeback(next);
+        }
+        sc_dirty = false;
+    }
+    for (int d = 0; d < 2; d++) {
+        if (!sc_synced[d] && mmc_file_open[d]) f_sync(&mmc_file[d]);
+        sc_synced[d] = true;
+    }
+}
+
+void DivMMC::idle() {
+    if (sc_idle >= DIVMMC_SC_IDLE_FRAMES || ++sc_idle < DIVMMC_SC_IDLE_FRAMES) return;
+    flush();
+    // Raw SD: the emulator's own FatFs writes the same card behind the cache
+    if (divsd_mode) sc_drop();
 }
 
 // Port 0xE7 write — chip select
@@ -747,7 +919,7 @@ uint8_t DivMMC::mmc_read() {
                     mmc_read_index = 0;
                     mmc_read_address += sdhc_mode ? 1 : 512;
                     if (sdhc_mode) {
-                        loadSector(mmc_read_address);
+                        loadSector(mmc_read_address, true);
                         mmc_sector_buf_addr = mmc_read_address;
                     }
                 }
@@ -767,6 +939,19 @@ uint8_t DivMMC::mmc_read() {
             }
             return 0xFF;
 
+        case 0x59: // CMD25 WRITE_MULTIPLE_BLOCK
+            if (mmc_write_index >= 0) {
+                if (mmc_write_index == 0) value = 0xFF;       // NCR
+                if (mmc_write_index == 1) value = 0;           // R1
+                if (mmc_write_index >= 2 && mmc_data_resp) {
+                    value = 0x05;                              // Data accepted
+                    mmc_data_resp = false;
+                }
+                if (mmc_write_index < 2) mmc_write_index++;
+                return value;
+            }
+            return 0xFF;
+
         case 0x77: // CMD55 APP_CMD (prefix for ACMD) — R1=00 once
             mmc_last_command = 0;
             return 0;
@@ -891,7 +1076,7 @@ void DivMMC::mmc_write(uint8_t value) {
                                    mmc_params[3];
                 if (sdhc_mode) {
                     flushWriteBuffer();
-                    loadSector(mmc_read_address);
+                    loadSector(mmc_read_address, true);
                     mmc_sector_buf_addr = mmc_read_address;
                 }
                 mmc_read_index = 0;
@@ -909,11 +1094,9 @@ void DivMMC::mmc_write(uint8_t value) {
                                     ((uint32_t)mmc_params[2] << 8) |
                                     mmc_params[3];
                 mmc_write_index = 0;
-                if (sdhc_mode) {
-                    // Pre-read sector for partial writes; sector_buf_addr = sector number
-                    loadSector(mmc_write_address);
-                    mmc_sector_buf_addr = mmc_write_address;
-                }
+                // The block is stored only once all 512 bytes are in, so the
+                // buffer needs no pre-read; it no longer mirrors any sector
+                if (sdhc_mode) mmc_sector_buf_addr = 0xFFFFFFFF;
             }
             // After gap byte and data token, receive 512 data bytes
             if (mmc_index_command >= WRITE_BLOCK_OFFSET + 2 &&
@@ -921,7 +1104,6 @@ void DivMMC::mmc_write(uint8_t value) {
                 int byte_idx = mmc_index_command - (WRITE_BLOCK_OFFSET + 2);
                 if (sdhc_mode) {
                     mmc_sector_buf[byte_idx] = value;
-                    mmc_sector_dirty = true;
                 } else {
                     writeByte(mmc_write_address + byte_idx, value);
                 }
@@ -930,7 +1112,6 @@ void DivMMC::mmc_write(uint8_t value) {
             if (mmc_index_command == WRITE_BLOCK_OFFSET + 2 + 512) {
                 if (sdhc_mode) {
                     storeSector(mmc_write_address);
-                    mmc_sector_dirty = false;
                 } else {
                     flushWriteBuffer();
                 }
@@ -939,6 +1120,47 @@ void DivMMC::mmc_write(uint8_t value) {
             break;
         }
 
+        case 0x59: // CMD25 WRITE_MULTIPLE_BLOCK
+            if (mmc_index_command < 5) {
+                mmc_params[mmc_index_command - 1] = value;
+                mmc_index_command++;
+                break;
+            }
+            if (mmc_index_command == 5) { // CRC byte ends the command
+                mmc_write_address = ((uint32_t)mmc_params[0] << 24) |
+                                    ((uint32_t)mmc_params[1] << 16) |
+                                    ((uint32_t)mmc_params[2] << 8) |
+                                    mmc_params[3];
+                mmc_write_index = 0;
+                mmc_block_index = -1;
+                mmc_data_resp = false;
+                flushWriteBuffer(); // packets land in mmc_sector_buf
+                mmc_sector_buf_addr = 0xFFFFFFFF;
+                mmc_index_command++;
+                break;
+            }
+            // Data packets: token 0xFC, 512 bytes, 2 CRC bytes; 0xFD stops.
+            // Each block goes to the sector cache, which coalesces them.
+            if (mmc_block_index < 0) {
+                if (value == 0xFC) {
+                    mmc_block_index = 0;
+                } else if (value == 0xFD) {
+                    mmc_index_command = 0;
+                }
+                break;
+            }
+            if (mmc_block_index < 512) {
+                mmc_sector_buf[mmc_block_index] = value;
+            }
+            if (++mmc_block_index == 512) {
+                storeSector(sdhc_mode ? mmc_write_address : mmc_write_address / 512);
+                mmc_write_address += sdhc_mode ? 1 : 512;
+            } else if (mmc_block_index == 514) {
+                mmc_block_index = -1;
+                mmc_data_resp = true;
+            }
+            break;
+
         case 0x77: // CMD55 APP_CMD (prefix for ACMD)
         case 0x69: // ACMD41 SD_SEND_OP_COND
             if (mmc_index_command == 5) {
@@ -1003,12 +1225,8 @@ void DivMMC::ide_read_sector() {
         ide_status = IDE_STATUS_DRDY | IDE_STATUS_ERR;
         return;
     }
-    uint32_t lba = ide_lba();
-    FSIZE_t pos = (FSIZE_t)ide_hdf_data_offset[d] + (FSIZE_t)lba * 512;
-    UINT br;
-    f_lseek(&mmc_file[d], pos);
-    f_read(&mmc_file[d], ide_buffer, 512, &br);
-    if (br < 512) memset(ide_buffer + br, 0xFF, 512 - br);
+    // More sectors to come: let a miss read ahead
+    sc_read(d, ide_lba(), ide_buffer, ide_sector_count > 1);
     ide_data_index = 0;
     ide_data_write = false;
     ide_status = IDE_STATUS_DRDY | IDE_STATUS_DRQ;
@@ -1017,12 +1235,7 @@ void DivMMC::ide_read_sector() {
 void DivMMC::ide_write_sector_done() {
     int d = ide_drive();
     if (!mmc_file_open[d]) return;
-    uint32_t lba = ide_lba();
-    FSIZE_t pos = (FSIZE_t)ide_hdf_data_offset[d] + (FSIZE_t)lba * 512;
-    UINT bw;
-    f_lseek(&mmc_file[d], pos);
-    f_write(&mmc_file[d], ide_buffer, 512, &bw);
-    f_sync(&mmc_file[d]);
+    sc_write(d, ide_lba(), ide_buffer);
 }
 
 void DivMMC::ide_execute_command(uint8_t cmd) {
@@ -1194,6 +1407,10 @@ void DivMMC::ide_write(uint8_t reg, uint8_t value) {
 
 void DivMMC::zc_init() {
     if (zc_enabled) return;
+    // Pending writes belong to the esxDOS image, which this mode leaves alone
+    flush();
+    if (!sc_lines) sc_setup(nullptr);
+    sc_drop();
     // Real SD card in SDHC sector-addressed mode.
     divsd_mode = true;
     sdhc_mode = true;
@@ -1218,6 +1435,8 @@ void DivMMC::zc_init() {
     mmc_ocr_index = -1;
     mmc_sector_buf_addr = 0xFFFFFFFF;
     mmc_sector_dirty = false;
+    mmc_block_index = -1;
+    mmc_data_resp = false;
     zc_config = 0;
     zc_enabled = true;
     Debug::log("Z-Controller: raw SD, %lu sectors, SDHC mode", (unsigned long)sector_count);
@@ -1225,7 +1444,8 @@ void DivMMC::zc_init() {
 
 void DivMMC::zc_shutdown() {
     if (!zc_enabled) return;
-    flushWriteBuffer();
+    flush();
+    sc_drop();
     zc_enabled = false;
     zc_config = 0;
     mmc_cs_active = false;
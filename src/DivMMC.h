@@ -12,6 +12,15 @@
 #define DIVMMC_NUM_BANKS 16       // 16 banks = 128KB RAM
 #define DIVMMC_CACHE_SLOTS 3      // swap mode: number of cached bank buffers
 
+// Card/disk sector cache: lines of DIVMMC_SC_RUN consecutive sectors, LRU.
+// Sequential reads fill the rest of a line in one transfer; writes stay in the
+// cache until the line is evicted or the card has been idle for
+// DIVMMC_SC_IDLE_FRAMES, then go out as one write per run of dirty sectors.
+#define DIVMMC_SC_RUN         4   // sectors per line (2 KB)
+#define DIVMMC_SC_LINES       32  // lines in butter PSRAM (64 KB)
+#define DIVMMC_SC_LINES_SRAM  2   // lines on the heap when PSRAM is short
+#define DIVMMC_SC_IDLE_FRAMES 25  // write-behind delay after the last access
+
 // DivMMC automap trap addresses (M1 cycle entry points)
 #define DIVMMC_TRAP_0000 0x0000
 #define DIVMMC_TRAP_0008 0x0008   // RST 8 - ESXDOS API
@@ -48,10 +57,19 @@ public:
 
     static void init();           // Load ROM, open .mmc/.hdf image
     static void reset();          // Reset state
+    static void idle();           // Once per frame: sector cache write-behind
+    static void flush();          // Write back the sector cache and sync the images
     static void applyMapping();   // Update page0 pointers based on state
     static inline void markHiDirty() { if (hi_slot >= 0) slot_dirty[hi_slot] = true; }
     static inline void markLoDirty() { if (lo_slot >= 0) slot_dirty[lo_slot] = true; }
 
+    // Sector cache counters: hit/miss = sector reads served from / not from
+    // the cache, readahead = extra sectors fetched by sequential misses,
+    // writes = sectors written by the host, flushes = card/image writes
+    struct sc_stats_t { uint32_t hits, misses, readahead, writes, flushes; };
+    static sc_stats_t sc_stats;
+    static uint32_t psram_bytes;  // butter PSRAM taken by banks and sector cache
+
     // SD/SPI protocol emulation (DivMMC/DivSD)
     static void mmc_cs(uint8_t value);    // Port 0xE7 write: chip select
     static void mmc_write(uint8_t value); // Port 0xEB write: send command/data byte
@@ -98,6 +116,8 @@ private:
 
     static uint32_t mmc_read_address;
     static uint32_t mmc_write_address;
+    static int mmc_block_index;    // CMD25: byte in the current data packet (-1 = waiting for token)
+    static bool mmc_data_resp;     // CMD25: data response pending for the last packet
 
     static uint8_t mmc_sector_buf[512];
     static uint32_t mmc_sector_buf_addr;
@@ -117,11 +137,30 @@ private:
     static void buildCSD();
     static void buildCSD_real(uint32_t sector_count);
 
-    // For DivMMC superfloppy images: synthesize an MBR at sector 0 so the
-    // host sees a partition table; sectors >=1 are read from .mmc with offset.
-    static void loadSector(uint32_t sector);
+    // One sector of unit 0 between mmc_sector_buf and the sector cache
+    static void loadSector(uint32_t sector, bool stream = false);
     static void storeSector(uint32_t sector);
 
+    // Sector cache; unit 0 = .mmc / raw SD / DivIDE master, 1 = DivIDE slave
+    struct sc_line_t { uint32_t base; uint32_t lru; uint8_t unit, valid, dirty; }; // base == ~0u: empty
+    static sc_line_t sc_line[DIVMMC_SC_LINES];
+    static uint8_t* sc_buf;        // sc_lines lines of DIVMMC_SC_RUN sectors
+    static uint8_t* sc_heap;       // heap fallback, kept across toggles like active_buf
+    static int sc_lines;           // 0: no cache, straight to the card
+    static uint32_t sc_tick;
+    static uint8_t sc_idle;        // frames since the last access
+    static bool sc_dirty;          // some line holds unwritten sectors
+    static bool sc_synced[2];      // image file has no unsynced writes
+    static uint32_t sc_next[2];    // sector after the last one read (sequential detection)
+    static void sc_setup(uint8_t* psram);
+    static int sc_get(int unit, uint32_t base);
+    static void sc_read(int unit, uint32_t sector, uint8_t* dst, bool stream);
+    static void sc_write(int unit, uint32_t sector, const uint8_t* src);
+    static void sc_writeback(int i);
+    static void sc_drop();
+    static int io_read(int unit, uint32_t sector, uint8_t* dst, int n);
+    static void io_write(int unit, uint32_t sector, const uint8_t* src, int n);
+
     // Bank memory management (butter PSRAM or swap)
     static uint8_t* active_buf[DIVMMC_CACHE_SLOTS];
     static int8_t active_bank[DIVMMC_CACHE_SLOTS];
@@ -44,6 +44,8 @@ visit https://zxespectrum.speccy.org/contacto
 #include "MemESP.h"
 #include "OSDMain.h"
 #include "Ports.h"
+#include "Profiler.h"
+#include "Rewind.h"
 #include "Snapshot.h"
 #include "Tape.h"
 #include "Video.h"
@@ -1037,6 +1039,8 @@ void ESPectrum::reset(uint8_t romInUse) {
   Tape::SaveStatus = SAVE_STOPPED;
   Tape::romLoading = false;
 
+  Rewind::reset();
+
   // Empty audio buffers
   memset(overSamplebuf, 0, sizeof(overSamplebuf));
   memset(audioBuffer_L, 0, sizeof(audioBuffer_L));
@@ -1164,7 +1168,7 @@ IRAM_ATTR void ESPectrum::processKeyboard() {
   bool j[10] = {true, true, true, true, true, true, true, true, true, true};
   bool jShift = true;
 
-  if ((Config::numPcBP > 0 && Config::hasBreakPoint(Z80::getRegPC(), Config::BP_PC)) ||
+  if ((Config::numPcBP > 0 && Config::hitBreakPoint(Z80::getRegPC(), Config::BP_PC)) ||
       CPU::portBasedBP) {
     int64_t osd_start = esp_timer_get_time();
     OSD::osdDebug();
@@ -1196,10 +1200,7 @@ IRAM_ATTR void ESPectrum::processKeyboard() {
             Kbd->isVKDown(fabgl::VK_LALT) || Kbd->isVKDown(fabgl::VK_RALT),
             Kbd->isVKDown(fabgl::VK_LCTRL) || Kbd->isVKDown(fabgl::VK_RCTRL));
         Kbd->emptyVirtualKeyQueue();
-#ifdef DIRTY_LINES
-        for (int i = 0; i < SPEC_H; i++)
-          VIDEO::dirty_lines[i] |= 0x01;
-#endif // DIRTY_LINES
+        VIDEO::dirtyAll();
        // Refresh border
         VIDEO::brdnextframe = true;
         ESPectrum::ts_start += esp_timer_get_time() - osd_start;
@@ -1469,6 +1470,16 @@ __not_in_flash("audio") void ESPectrum::AYGetSample() {
   }
 }
 
+// AY data write: logged with the sample it lands on, generated at frame end.
+// Only a full queue makes it generate up to here first.
+__not_in_flash("audio") void ESPectrum::AYWrite(uint8_t data) {
+  AySound *chip = chips[AySound::selected_chip];
+  if (chip->queueFull()) AYGetSample();
+  uint32_t audbufpos = CPU::tstates / audioAYDivider;
+  if (multiplicator) audbufpos >>= multiplicator;
+  chip->queueRegisterData(data, audbufpos);
+}
+
 #if !PICO_RP2040
 __not_in_flash("audio") void ESPectrum::SAAGetSample() {
   uint32_t audbufpos = CPU::tstates / audioAYDivider; // SAA counter = 8MHz/256 = 31.25kHz, same rate as AY
@@ -1606,15 +1617,19 @@ void ESPectrum::loop() {
     }
     ts_start = time_us_64();
 
+    uint32_t prof = Profiler::begin();
     if (!CPU::paused)
       pwm_audio_write((uint8_t *)audioBuffer_L, (uint8_t *)audioBuffer_R,
                       maxSpeed ? 1 : samplesPerFrame, 0, 0);
+    Profiler::end(PROF_MIX, prof);
 
     // Send audioBuffer to pwmaudio
     audbufcnt = 0;
     audbufcntover = 0;
     audbufcntAY = 0;
     audbufcntCovox = 0;
+    chip0.flushWrites(); // writes past the end of the last frame, or of one
+    chip1.flushWrites(); // that skipped generation
 
 #if !PICO_RP2040
     audbufcntSAA = 0;
@@ -1626,7 +1641,24 @@ void ESPectrum::loop() {
     beeperSampleAccum = 0;
     beeperTstatesInSample = 0;
 
+    prof = Profiler::begin();
     CPU::loop();
+    Profiler::end(PROF_Z80, prof);
+
+    prof = Profiler::begin();
+    mem_desc_t::flush(); // swap sector cache write-back, once per frame
+    rvmWD1793Idle(&fdd); // disk track cache write-back once the drive is idle
+#if !PICO_RP2040
+    rvmWD1793Idle(&mb02_fdd);
+    DivMMC::idle(); // card sector cache write-behind once the card is idle
+#endif
+    Rewind::frame();
+    if (Tape::tapeStatus == TAPE_LOADING) {
+      Tape::Compile(); // queue edges for the next frame
+      Tape::tape.prefetch(); // read the next tape window outside the pulse loop
+      Tape::cswBlock.prefetch();
+    }
+    Profiler::end(PROF_IO, prof);
 
     // GS-Z80 runs on core1 alongside pcm_call(); core0 only reads the ring.
 
@@ -1645,6 +1677,7 @@ void ESPectrum::loop() {
     faudbufcntSAA = audbufcntSAA;
 #endif
 
+    prof = Profiler::begin();
     if (!CPU::paused) {
 #if LOAD_WAV_PIO
       if (Config::real_player) {
@@ -1725,11 +1758,14 @@ void ESPectrum::loop() {
 #endif
             if (fddSndEnabled) FDDGenSound();
         }
+        uint32_t profGen = Profiler::begin();
         if (AY_emu && faudbufcntAY < samplesPerFrame) {
             if(Config::turbosound != 0 || AySound::selected_chip == 0) chip0.gen_sound(samplesPerFrame - faudbufcntAY , faudbufcntAY);
             if(Config::turbosound != 0 || AySound::selected_chip == 1) chip1.gen_sound(samplesPerFrame - faudbufcntAY , faudbufcntAY);
         }
+        Profiler::end(PROF_AY, profGen);
 #if !PICO_RP2040
+        profGen = Profiler::begin();
         if (SAA_emu && faudbufcntSAA < samplesPerFrame)
         {
           if (Tape::tapeStatus == TAPE_LOADING) {
@@ -1743,6 +1779,7 @@ void ESPectrum::loop() {
         {
           MidiSynth::gen_sound(audioBufferMIDI_L, audioBufferMIDI_R, samplesPerFrame);
         }
+        Profiler::end(PROF_SAA, profGen);
 #endif
         // Hoist frame-invariant source flags outside the mix loop
         bool mix_chip0 = AY_emu && (Config::turbosound != 0 || AySound::selected_chip == 0);
@@ -1790,6 +1827,9 @@ void ESPectrum::loop() {
         }
       }
     }
+    Profiler::end(PROF_MIX, prof);
+
+    prof = Profiler::begin();
     processKeyboard();
 #ifdef USE_GS
     GS::pollPerf();
@@ -1841,6 +1881,9 @@ void ESPectrum::loop() {
                    VIDEO::framecnt /
                        (ESPectrum::totalsecondsnodelay / 1000000));
           OSD::drawStats();
+        } else if (VIDEO::OSD == 8) {
+          Profiler::text(OSD::stats_lin1, OSD::stats_lin2, sizeof(OSD::stats_lin1));
+          OSD::drawStats();
         } else if (VIDEO::OSD == 3) {
           snprintf(OSD::stats_lin1, sizeof(OSD::stats_lin1),
                    "TST: %05d / IDL: %05d ", CPU::tstates_active,
@@ -1853,6 +1896,12 @@ void ESPectrum::loop() {
                      ESPectrum::mb02_fdd.track, ESPectrum::mb02_fdd.sector,
                      ESPectrum::mb02_fdd.side);
             OSD::drawStats();
+          } else if (DivMMC::enabled || DivMMC::zc_enabled) {
+            snprintf(OSD::stats_lin2, sizeof(OSD::stats_lin2),
+                     "SD H:%-8lu M:%-8lu",
+                     (unsigned long)DivMMC::sc_stats.hits,
+                     (unsigned long)DivMMC::sc_stats.misses);
+            OSD::drawStats();
           } else
 #endif
           {
@@ -1874,7 +1923,12 @@ void ESPectrum::loop() {
 #else
     if (!(VIDEO::flash_ctr++ & 0x0f))
 #endif
+    {
       VIDEO::flashing ^= 0x80;
+#ifdef DIRTY_LINES
+      VIDEO::dirtyFlash();
+#endif
+    }
 
     // Draw fdd led indicator in top-right corner
     bool hasFdd = (Z80Ops::isPentagon || (Z80Ops::is128 && Z80Ops::isByte)) && Tape::tapeStatus != TAPE_LOADING
@@ -1903,8 +1957,11 @@ void ESPectrum::loop() {
         }
     }
 
+    Profiler::end(PROF_OSD, prof);
+
     elapsed = time_us_64() - ts_start;
     idle = target - elapsed;
+    Profiler::frame(elapsed, idle);
 
 #ifdef USE_GS
     // Track min per-frame IDL across the current pollPerf interval — lets
@@ -105,6 +105,7 @@ public:
     static void BeeperGetSample();
     static void CovoxGetSample();
     static void AYGetSample();
+    static void AYWrite(uint8_t data);
 #if !PICO_RP2040
     static void SAAGetSample();
     static void PITGetSample();
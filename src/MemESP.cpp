@@ -40,13 +40,74 @@ visit https://zxespectrum.speccy.org/contacto
 
 std::list<mem_desc_t> mem_desc_t::pages;
 uint8_t* mem_desc_t::plugged_in[4] = { 0, 0, 0, 0 };
+uint32_t mem_desc_t::lru_tick = 0;
+mem_desc_t::cache_stats_t mem_desc_t::stats = { 0, 0, 0, 0 };
 uint32_t MEM_PG_CNT = 64;
 
 static FIL f;
 static const char PAGEFILE[] = "/tmp/pico-spec.swap";
 
+// Byte access to swapped-out pages (_read/_write: debugger pokes, from_mem,
+// ...) goes through a small sector cache instead of a seek + 1-byte FatFs call
+// per access. Two 512-byte slots, LRU; a slot is written back when it is
+// evicted, before any block transfer on the swap file and at frame end
+// (flush() from ESPectrum::loop). Allocated on first use: PSRAM boards never
+// touch it.
+#define SWAP_SECTOR 512
+#define SWAP_SLOTS  2
+struct swap_slot_t { uint32_t off; uint32_t lru; bool dirty; }; // off == ~0u: empty
+static swap_slot_t swap_slot[SWAP_SLOTS] = { { ~0u, 0, false }, { ~0u, 0, false } };
+static uint8_t (*swap_buf)[SWAP_SECTOR] = nullptr;
+static uint32_t swap_tick = 0;
+bool mem_desc_t::swap_dirty = false;
+
+static void swap_writeback(int i) {
+    if (!swap_slot[i].dirty) return;
+    #ifdef PICO_DEFAULT_LED_PIN
+    gpio_put(PICO_DEFAULT_LED_PIN, true);
+    #endif
+    UINT bw;
+    f_lseek(&f, swap_slot[i].off);
+    f_write(&f, swap_buf[i], SWAP_SECTOR, &bw);
+    #ifdef PICO_DEFAULT_LED_PIN
+    gpio_put(PICO_DEFAULT_LED_PIN, false);
+    #endif
+    swap_slot[i].dirty = false;
+}
+
+// Slot holding the sector of swap file offset 'pos', loading it if needed
+static int swap_sector(uint32_t pos) {
+    uint32_t off = pos & ~(uint32_t)(SWAP_SECTOR - 1);
+    int victim = 0;
+    for (int i = 0; i < SWAP_SLOTS; ++i) {
+        if (swap_slot[i].off == off) {
+            swap_slot[i].lru = ++swap_tick;
+            return i;
+        }
+        if ((int32_t)(swap_slot[i].lru - swap_slot[victim].lru) < 0) victim = i;
+    }
+    if (!swap_buf) swap_buf = new uint8_t[SWAP_SLOTS][SWAP_SECTOR];
+    swap_writeback(victim);
+    UINT br = 0;
+    f_lseek(&f, off);
+    f_read(&f, swap_buf[victim], SWAP_SECTOR, &br);
+    if (br < SWAP_SECTOR) memset(swap_buf[victim] + br, 0, SWAP_SECTOR - br); // past EOF
+    swap_slot[victim] = { off, ++swap_tick, false };
+    return victim;
+}
+
+void mem_desc_t::_flush(bool drop) {
+    for (int i = 0; i < SWAP_SLOTS; ++i) {
+        if (swap_slot[i].off == ~0u) continue;
+        swap_writeback(i);
+        if (drop) swap_slot[i] = { ~0u, 0, false };
+    }
+    swap_dirty = false;
+}
+
 // Called by FileUtils::remountSD() to reopen swap file after SD remount
 extern "C" void mem_swap_reopen(void) {
+    mem_desc_t::flush(true);
     FSIZE_t sz = f_size(&f);
     f_close(&f);
     if (sz > 0) {
@@ -58,6 +119,8 @@ extern "C" void mem_swap_reopen(void) {
 
 void mem_desc_t::reset(void) {
     pages.clear();
+    stats = { 0, 0, 0, 0 };
+    flush(true);
     f_close(&f);
     f_unlink(PAGEFILE); // ensure it is new file
     f_open(&f, PAGEFILE, FA_WRITE | FA_CREATE_ALWAYS);
@@ -65,119 +128,130 @@ void mem_desc_t::reset(void) {
     f_open(&f, PAGEFILE, FA_READ | FA_WRITE);
 }
 
+// FNV-1a over 32-bit words. Taken when a page is loaded from PSRAM/swap and
+// again on eviction: if it still matches, the page was not written meanwhile
+// and the copy in PSRAM/swap is current. Writes reach resident pages through
+// ramCurrent[], DMA, loaders, the debugger... so this is cheaper and safer
+// than hooking every writer; 16 KB of SRAM hash in a fraction of the time one
+// page takes over SPI or SD.
+uint32_t page_sum(const uint8_t* p) {
+    const uint32_t* w = (const uint32_t*)p;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < MEM_PG_SZ / 4; ++i) {
+        h = (h ^ w[i]) * 16777619u;
+    }
+    return h;
+}
+
+bool mem_desc_t::in_psram(void) {
+    return psram_size() >= _int->vram_off + MEM_PG_SZ;
+}
+
+// Block transfer to/from this page's copy in PSRAM or in the swap file
+void mem_desc_t::vram_write(uint32_t off, const uint8_t* src, size_t sz) {
+    uint32_t ba = _int->vram_off;
+    if (in_psram()) {
+        writepsram(ba + off, (uint8_t*)src, sz);
+        return;
+    }
+    flush(true);
+    #ifdef PICO_DEFAULT_LED_PIN
+    gpio_put(PICO_DEFAULT_LED_PIN, true);
+    #endif
+    UINT bw;
+    FSIZE_t lba = ba + off;
+    f_lseek(&f, lba);
+    f_write(&f, src, sz, &bw);
+    #ifdef PICO_DEFAULT_LED_PIN
+    gpio_put(PICO_DEFAULT_LED_PIN, false);
+    #endif
+}
+void mem_desc_t::vram_read(uint8_t* dst, uint32_t off, size_t sz) {
+    uint32_t ba = _int->vram_off;
+    if (in_psram()) {
+        readpsram(dst, ba + off, sz);
+        return;
+    }
+    flush(false);
+    UINT br;
+    FSIZE_t lba = ba + off;
+    f_lseek(&f, lba);
+    f_read(&f, dst, sz, &br);
+}
+
 uint8_t* mem_desc_t::to_vram(void) {
     uint8_t* res = _int->p;
-    uint32_t ba = _int->vram_off;
-    if (psram_size() >= ba + MEM_PG_SZ) {
-        for (size_t i = 0; i < MEM_PG_SZ; i += 4) {
-            write32psram(ba + i, *(uint32_t*)(res + i));
-        }
-        _int->mem_type = PSRAM_SPI;
+    if (_int->vram_valid && page_sum(res) == _int->sum) {
+        ++stats.clean;
     } else {
-        #ifdef PICO_DEFAULT_LED_PIN
-        gpio_put(PICO_DEFAULT_LED_PIN, true);
-        #endif
-        UINT bw;
-        FSIZE_t lba = ba;
-        f_lseek(&f, lba);
-        f_write(&f, res, MEM_PG_SZ, &bw);
-        #if PICO_DEFAULT_LED_PIN
-        gpio_put(PICO_DEFAULT_LED_PIN, false);
-        #endif
-        _int->mem_type = SWAP;
+        ++stats.writebacks;
+        vram_write(0, res, MEM_PG_SZ);
     }
+    _int->mem_type = in_psram() ? PSRAM_SPI : SWAP;
+    _int->vram_valid = true;
     _int->p = 0;
     return res;
 }
 void mem_desc_t::from_vram(uint8_t* p) {
     this->_int->p = p;
-    uint32_t ba = _int->vram_off;
-    if (psram_size() >= ba + MEM_PG_SZ) {
-        for (size_t i = 0; i < MEM_PG_SZ; i += 4) {
-            *(uint32_t*)(p + i) = read32psram(ba + i);
-        }
-    } else {
-        UINT br;
-        FSIZE_t lba = ba;
-        f_lseek(&f, lba);
-        f_read(&f, p, 0x4000, &br);
-    }
+    vram_read(p, 0, MEM_PG_SZ);
     _int->mem_type = POINTER;
+    _int->vram_valid = true;
+    _int->sum = page_sum(p);
 }
 uint8_t mem_desc_t::_read(uint16_t addr) {
-    uint32_t ba = _int->vram_off;
-    if (psram_size() >= ba + MEM_PG_SZ) {
-        return read8psram(ba + addr);
+    uint32_t pos = _int->vram_off + addr;
+    if (in_psram()) {
+        return read8psram(pos);
     }
-    UINT br;
-    FSIZE_t lba = ba;
-    f_lseek(&f, lba + addr);
-    uint8_t r;
-    f_read(&f, &r, 1, &br);
-    return r;
+    return swap_buf[swap_sector(pos)][pos & (SWAP_SECTOR - 1)];
 }
 void mem_desc_t::_write(uint16_t addr, uint8_t v) {
-    uint32_t ba = _int->vram_off;
-    if (psram_size() >= ba + MEM_PG_SZ) {
-        write8psram(ba + addr, v);
+    uint32_t pos = _int->vram_off + addr;
+    if (in_psram()) {
+        write8psram(pos, v);
         return;
     }
-    #ifdef PICO_DEFAULT_LED_PIN
-    gpio_put(PICO_DEFAULT_LED_PIN, true);
-    #endif
-    UINT br;
-    FSIZE_t lba = ba;
-    f_lseek(&f, lba + addr);
-    f_write(&f, &v, 1, &br);
-    #ifdef PICO_DEFAULT_LED_PIN
-    gpio_put(PICO_DEFAULT_LED_PIN, false);
-    #endif
+    int i = swap_sector(pos);
+    swap_buf[i][pos & (SWAP_SECTOR - 1)] = v;
+    swap_slot[i].dirty = true;
+    swap_dirty = true;
 }
 void mem_desc_t::_sync(uint8_t bank) {
+    ++stats.misses;
+    // LRU: the resident page not plugged into another bank that was synced
+    // longest ago hands its buffer over to this one
+    auto victim = pages.end();
     for (auto it = pages.begin(); it != pages.end(); ++it) {
-        mem_desc_t& page = *it;
-        if (page._int->mem_type == POINTER) {
-            for (uint8_t i = 0; i < 4; ++i) {
-                if (i != bank) {
-                    if (page._int->p == plugged_in[i]) goto skip;
-                }
-            }
-            from_vram( page.to_vram() );
-            pages.erase(it);
-            pages.push_back(*this);
-            break;
+        mem_desc_int_t* pi = it->_int;
+        if (pi->mem_type != POINTER) continue;
+        bool plugged = false;
+        for (uint8_t i = 0; i < 4; ++i) {
+            if (i != bank && pi->p == plugged_in[i]) { plugged = true; break; }
         }
-        skip:;
+        if (plugged) continue;
+        if (victim == pages.end() || (int32_t)(pi->lru - victim->_int->lru) < 0) victim = it;
     }
+    if (victim == pages.end()) return;
+    from_vram( victim->to_vram() );
+    pages.erase(victim);
+    pages.push_back(*this);
 }
-/// TODO: packet mode
+// Snapshot load/save of a swapped-out page goes through a small stack buffer
+// in blocks instead of byte by byte
+#define VRAM_CHUNK 256
 void mem_desc_t::from_file(FIL* f_in, size_t sz) {
     UINT br;
     if (_int->mem_type == POINTER) {
         f_read(f_in, direct(), sz, &br);
         return;
     }
-    uint8_t v;
-    uint32_t ba = _int->vram_off;
-    if (psram_size() >= ba + MEM_PG_SZ) {
-        for (size_t addr = 0; addr < sz; ++addr) {
-            f_read(f_in, &v, 1, &br);
-            write8psram(ba + addr, v);
-        }
-        return;
-    }
-    #ifdef PICO_DEFAULT_LED_PIN
-    gpio_put(PICO_DEFAULT_LED_PIN, true);
-    #endif
-    FSIZE_t lba = ba;
-    f_lseek(&f, lba);
-    for (size_t addr = 0; addr < sz; ++addr) {
-        f_read(f_in, &v, 1, &br);
-        f_write(&f, &v, 1, &br);
+    uint8_t buf[VRAM_CHUNK];
+    for (size_t addr = 0; addr < sz; addr += VRAM_CHUNK) {
+        size_t n = sz - addr < VRAM_CHUNK ? sz - addr : VRAM_CHUNK;
+        f_read(f_in, buf, n, &br);
+        vram_write(addr, buf, n);
     }
-    #ifdef PICO_DEFAULT_LED_PIN
-    gpio_put(PICO_DEFAULT_LED_PIN, false);
-    #endif
 }
 void mem_desc_t::to_file(FIL* f_out, size_t sz) {
     #ifdef PICO_DEFAULT_LED_PIN
@@ -186,28 +260,13 @@ void mem_desc_t::to_file(FIL* f_out, size_t sz) {
     UINT br;
     if (_int->mem_type == POINTER) {
         f_write(f_out, direct(), sz, &br);
-        #ifdef PICO_DEFAULT_LED_PIN
-        gpio_put(PICO_DEFAULT_LED_PIN, false);
-        #endif
-        return;
-    }
-    uint8_t v;
-    uint32_t ba = _int->vram_off;
-    if (psram_size()) {
-        for (size_t addr = 0; addr < sz; ++addr) {
-            v = read8psram(ba + addr);
-            f_write(f_out, &v, 1, &br);
+    } else {
+        uint8_t buf[VRAM_CHUNK];
+        for (size_t addr = 0; addr < sz; addr += VRAM_CHUNK) {
+            size_t n = sz - addr < VRAM_CHUNK ? sz - addr : VRAM_CHUNK;
+            vram_read(buf, addr, n);
+            f_write(f_out, buf, n, &br);
         }
-        #ifdef PICO_DEFAULT_LED_PIN
-        gpio_put(PICO_DEFAULT_LED_PIN, false);
-        #endif
-        return;
-    }
-    FSIZE_t lba = ba;
-    f_lseek(&f, lba);
-    for (size_t addr = 0; addr < sz; ++addr) {
-        f_read(&f, &v, 1, &br);
-        f_write(f_out, &v, 1, &br);
     }
     #ifdef PICO_DEFAULT_LED_PIN
     gpio_put(PICO_DEFAULT_LED_PIN, false);
@@ -218,33 +277,31 @@ void mem_desc_t::from_mem(mem_desc_t& ram, size_t sz) {
         if (ram._int->mem_type == POINTER) {
             memcpy(direct(), ram.direct(), sz);
         } else {
-            uint8_t* p = direct();
-            for (size_t addr = 0; addr < sz; ++addr) {
-                p[addr] = ram._read(addr);
-            }
+            ram.vram_read(direct(), 0, sz);
         }
     } else {
         if (ram._int->mem_type == POINTER) {
-            uint8_t* p = ram.direct();
-            for (size_t addr = 0; addr < sz; ++addr) {
-                _write(addr, p[addr]);
-            }
+            vram_write(0, ram.direct(), sz);
         } else {
-            for (size_t addr = 0; addr < sz; ++addr) {
-                _write(addr, ram._read(addr));
+            uint8_t buf[VRAM_CHUNK];
+            for (size_t addr = 0; addr < sz; addr += VRAM_CHUNK) {
+                size_t n = sz - addr < VRAM_CHUNK ? sz - addr : VRAM_CHUNK;
+                ram.vram_read(buf, addr, n);
+                vram_write(addr, buf, n);
             }
         }
     }
-
 }
 void mem_desc_t::cleanup() {
     if (_int->mem_type == POINTER) {
-        for (size_t addr = 0; addr < MEM_PG_SZ; ++addr) {
-            _write(addr, 0);
-        }
-    } else {
         if (!_int->p) return;
         memset(direct(), 0, MEM_PG_SZ);
+    } else {
+        uint8_t buf[VRAM_CHUNK];
+        memset(buf, 0, VRAM_CHUNK);
+        for (size_t addr = 0; addr < MEM_PG_SZ; addr += VRAM_CHUNK) {
+            vram_write(addr, buf, VRAM_CHUNK);
+        }
     }
 }
 
@@ -299,6 +356,20 @@ int ram_pages = 2, butter_pages = 0, psram_pages = 0, swap_pages = 0;
 uint8_t* MemESP::ramCurrent[4];
 bool MemESP::ramContended[4];
 
+// Задержки порта для "Байта": ПЗУ DD10/DD11 декодируются на этапе компиляции,
+// а не цепочкой сравнений на каждом IN (0xEE -> 4, 0xFE -> 3, 0xBE -> 2, иначе 1)
+struct byte_cont_t { uint8_t d[1024]; };
+static constexpr byte_cont_t decodeByteContention() {
+    byte_cont_t t {};
+    for (int i = 0; i < 1024; ++i) {
+        uint8_t val = i < 512 ? romDd10[i] : romDd11[i - 512];
+        t.d[i] = val == 0xEE ? 4 : val == 0xFE ? 3 : val == 0xBE ? 2 : 1;
+    }
+    return t;
+}
+static constexpr byte_cont_t byteCont = decodeByteContention();
+const uint8_t* const MemESP::byteContention = byteCont.d;
+
 uint8_t MemESP::notMore128 = 0;
 uint32_t MemESP::page0ram = 0;
 uint32_t MemESP::bankLatch = 0;
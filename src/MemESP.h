@@ -43,6 +43,7 @@ visit https://zxespectrum.speccy.org/contacto
 #include "Debug.h"
 #include "Config.h"
 #include "CPU.h"
+#include "Video.h"
 
 #define MEM_PG_SZ 0x4000
 #if PICO_RP2350
@@ -58,6 +59,7 @@ extern uint8_t psram_pin;
 extern bool rp2350a;
 uint32_t butter_psram_size();
 extern uint8_t rx[4];
+uint32_t page_sum(const uint8_t* p); // FNV-1a of a 16 KB page
 
 enum mem_type_t {
     POINTER = 0,
@@ -68,12 +70,16 @@ enum mem_type_t {
 class mem_desc_t {
     static std::list<mem_desc_t> pages; // a pool of assigned pages
     static uint8_t* plugged_in[4]; // pointers are plugged to 64k space (do not revoke 'em)
+    static uint32_t lru_tick; // bumped on every sync(), stamps the page just used
     struct mem_desc_int_t {
         uint8_t* p;
         uint32_t vram_off;
         mem_type_t mem_type;
         bool is_rom;
-        mem_desc_int_t() : p(0), vram_off(0), mem_type(POINTER), is_rom(false) {}
+        bool vram_valid; // PSRAM/swap holds a copy that matched 'sum' when the page came in
+        uint32_t lru;
+        uint32_t sum;
+        mem_desc_int_t() : p(0), vram_off(0), mem_type(POINTER), is_rom(false), vram_valid(false), lru(0), sum(0) {}
     };
     mem_desc_int_t* _int;
     uint8_t* to_vram(void);
@@ -81,8 +87,21 @@ class mem_desc_t {
     void _sync(uint8_t bank);
     uint8_t _read(uint16_t addr);
     void _write(uint16_t addr, uint8_t v);
+    void vram_read(uint8_t* dst, uint32_t off, size_t sz);
+    void vram_write(uint32_t off, const uint8_t* src, size_t sz);
+    bool in_psram(void);
+    static bool swap_dirty; // a swap sector cache slot holds unwritten bytes
+    static void _flush(bool drop);
 public:
+    // Page cache counters: hit = sync() of a resident page, miss = swap-in,
+    // writeback / clean = evictions that did / did not have to write the page out
+    struct cache_stats_t { uint32_t hits, misses, writebacks, clean; };
+    static cache_stats_t stats;
     static void reset(void);
+    // Write back the swap sector cache (and forget it when 'drop')
+    static inline void flush(bool drop = false) {
+        if (swap_dirty || drop) _flush(drop);
+    }
     mem_desc_t() : _int( new mem_desc_int_t() ) {}
     mem_desc_t(const mem_desc_t& s) : _int( s._int ) {}
     mem_desc_t(uint8_t* p, uint32_t page) : _int( new mem_desc_int_t() ) {
@@ -98,7 +117,10 @@ public:
     inline uint8_t* sync(uint8_t bank) {
         if (_int->mem_type != POINTER) {
             _sync(bank);
+        } else {
+            ++stats.hits;
         }
+        _int->lru = ++lru_tick;
         uint8_t* res = _int->p;
         if (bank < 4) plugged_in[bank] = res;
         return res;
@@ -190,6 +212,7 @@ public:
     static void writeword(uint16_t addr, uint16_t data);
 
     static int getByteContention(uint16_t addr);
+    static const uint8_t* const byteContention; // [1024] ROM DD10/DD11, already decoded to wait states
 
     inline static void recoverPage0() {
         MemESP::ramCurrent[0] = MemESP::newSRAM ? MemESP::ram[MEM_PG_CNT + MemESP::romLatch].sync(0) :
@@ -202,28 +225,21 @@ public:
 // ==== Функция получения задержки для адреса ====
 inline int MemESP::getByteContention(uint16_t addr) {
     if (addr < 0xC000) return 0;
-
-    int res = 0;
-    uint16_t offset = addr - 0xC000;
-    uint8_t val = (offset < 512) ? romDd10[offset] : romDd11[offset - 512];
-    if (val == 0xEE) res = 4;
-    else if (val == 0xFE) res = 3;
-    else if (val == 0xBE) res = 2;
-    else res = 1;
-
-    return res;
+    return byteContention[addr & 0x3FF];
 }
 
 inline uint8_t MemESP::readbyte(uint16_t addr) {
-    if (Config::numMemReadBP > 0 && Config::hasBreakPoint(addr, Config::BP_MEM_READ))
-        CPU::portBasedBP = true;
     uint8_t page = addr >> 14;
+    uint8_t v;
 #if !PICO_RP2040
     if (page == 0 && divmmc_mapped) {
-        return (addr < 0x2000) ? page0_lo[addr] : page0_hi[addr & 0x1FFF];
-    }
+        v = (addr < 0x2000) ? page0_lo[addr] : page0_hi[addr & 0x1FFF];
+    } else
 #endif
-    return ramCurrent[page][addr & 0x3fff];
+    v = ramCurrent[page][addr & 0x3fff];
+    if (Config::numMemReadBP > 0 && Config::hitBreakPoint(addr, Config::BP_MEM_READ, v))
+        CPU::portBasedBP = true;
+    return v;
 }
 
 inline uint16_t MemESP::readword(uint16_t addr) {
@@ -232,7 +248,7 @@ inline uint16_t MemESP::readword(uint16_t addr) {
 
 inline void MemESP::writebyte(uint16_t addr, uint8_t data)
 {
-    if (Config::numMemWriteBP > 0 && Config::hasBreakPoint(addr, Config::BP_MEM_WRITE))
+    if (Config::numMemWriteBP > 0 && Config::hitBreakPoint(addr, Config::BP_MEM_WRITE, data))
         CPU::portBasedBP = true;
     uint8_t page = addr >> 14;
 #if !PICO_RP2040
@@ -260,6 +276,11 @@ inline void MemESP::writebyte(uint16_t addr, uint8_t data)
     uint8_t* p = ramCurrent[page];
     if (p < (uint8_t*)0x11000000) return;
     p[addr & 0x3fff] = data;
+    if (VIDEO::line_ahead) VIDEO::lineWrite(p + (addr & 0x3fff));
+#ifdef DIRTY_LINES
+    uint32_t voff = (uint32_t)(p + (addr & 0x3fff) - VIDEO::grmem);
+    if (voff < 6912) VIDEO::dirtyScreen(voff);
+#endif
 }
 
 inline void MemESP::writeword(uint16_t addr, uint16_t data) {
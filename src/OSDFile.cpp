@@ -61,51 +61,165 @@ using namespace std;
 
 extern Font Font6x8;
 
-// Sort version: bump to invalidate cached .idx files when sort order changes
-#define SORT_VERSION 1
-
-inline static size_t crc(const std::string& s) {
-    size_t res = 0;
-    for (size_t j = 0; j < s.size(); ++j) {
-        res += s[j];
+// Sort version: bump to invalidate cached .idx files when sort order or format changes
+#define SORT_VERSION 2
+
+// Running FNV-1a hash of a directory listing, one entry at a time in f_readdir order
+inline static uint32_t crc(uint32_t h, const char* s, bool dir) {
+    h = (h ^ (dir ? DIR_MARKER : 0xFF)) * 16777619u;
+    for (; *s; ++s) {
+        h = (h ^ (uint8_t)*s) * 16777619u;
     }
-    return res;
+    return h;
 }
 
 fabgl::VirtualKey get_last_key_pressed(void);
 
+// Directory index: fixed-size records in /tmp/.<path>.idx, sorted (dirs first,
+// case-insensitive). Record 0 is a header with the listing hash, so opening an
+// unchanged directory costs one f_readdir walk and one record read.
+// Sorting is an external merge sort: runs of SORT_RUN_BYTES of names are sorted
+// in RAM, written sequentially to a scratch file, then merged SORT_WAYS at a time.
+#define SORT_RUN_BYTES (24 * 1024)
+#define SORT_WAYS      16
+#define SORT_WBUF      8 // records per f_write
 class sorted_files {
     static const size_t rec_size = FF_LFN_BUF + 1;
+    struct header_t {
+        char magic[4];      // "SIDX"
+        uint32_t version;   // SORT_VERSION
+        uint32_t sclust;    // start cluster of the directory
+        uint32_t count;     // records after the header
+        uint32_t ndirs;     // of them directories (incl. "..")
+        uint32_t hash;      // listing hash at index time
+    };
     std::string folder;
     std::string idx_file;
     size_t sz = 0;
+    header_t hdr = {};
     FIL* storage_file = 0;
     bool open = false;
+    std::vector<std::string> run;  // names waiting to be sorted into a run
+    size_t run_bytes = 0;
+    std::vector<uint32_t> runs;    // record offset of each run in the scratch file
+    FIL* scratch = 0;
     inline void calc_sz() {
         sz = 0;
-        storage_file = fopen2(idx_file.c_str(), FA_READ);
+        memset(&hdr, 0, sizeof(hdr));
+        storage_file = fopen2(idx_file.c_str(), FA_READ | FA_WRITE);
         if (storage_file) {
+            open = true;
             UINT br;
-            char buf[rec_size];
-            while ( f_read(storage_file, buf, rec_size, &br) == FR_OK && br == rec_size ) {
-                ++sz;
+            if (f_read(storage_file, &hdr, sizeof(hdr), &br) != FR_OK || br != sizeof(hdr) ||
+                memcmp(hdr.magic, "SIDX", 4) || hdr.version != SORT_VERSION ||
+                f_size(storage_file) < rec_size * (hdr.count + 1)
+            ) {
+                memset(&hdr, 0, sizeof(hdr));
             }
-            fclose2(storage_file);
+            sz = hdr.count;
         }
-        storage_file = fopen2(idx_file.c_str(), FA_READ | FA_WRITE);
-        if (storage_file) open = true;
+    }
+    static inline void put(FIL* f, size_t i, const std::string& s) {
+        f_lseek(f, rec_size * i);
+        UINT bw;
+        char buf[rec_size] = { 0 };
+        strncpy(buf, s.c_str(), rec_size - 1);
+        f_write(f, buf, rec_size, &bw);
+    }
+    // Sequential record reader/writer with a small buffer
+    struct rec_reader {
+        FIL* f; uint32_t pos, end; uint8_t n = 0, i = 0;
+        char buf[2][rec_size];
+        inline bool next(std::string& s) {
+            if (i == n) {
+                if (pos >= end) return false;
+                n = end - pos > 2 ? 2 : end - pos;
+                i = 0;
+                UINT br;
+                f_lseek(f, rec_size * pos);
+                f_read(f, buf, rec_size * n, &br);
+                pos += n;
+            }
+            s = buf[i++];
+            return true;
+        }
+    };
+    struct rec_writer {
+        FIL* f; uint8_t n = 0;
+        char buf[SORT_WBUF][rec_size];
+        inline void put(const std::string& s) {
+            memset(buf[n], 0, rec_size);
+            strncpy(buf[n], s.c_str(), rec_size - 1);
+            if (++n == SORT_WBUF) flush();
+        }
+        inline void flush() {
+            UINT bw;
+            if (n) f_write(f, buf, rec_size * n, &bw);
+            n = 0;
+        }
+    };
+    // Sort the pending names and append them as one run to the scratch file
+    bool flush_run() {
+        if (run.empty()) return true;
+        if (!scratch) {
+            scratch = fopen2((idx_file + ".tmp").c_str(), FA_READ | FA_WRITE | FA_CREATE_ALWAYS);
+            if (!scratch) return false;
+        }
+        std::sort(run.begin(), run.end(), [this](const std::string& a, const std::string& b) { return cmp(a, b) < 0; });
+        runs.push_back(f_size(scratch) / rec_size);
+        f_lseek(scratch, f_size(scratch));
+        rec_writer* w = new rec_writer { scratch };
+        for (const auto& s : run) w->put(s);
+        w->flush();
+        delete w;
+        run.clear();
+        run_bytes = 0;
+        return true;
+    }
+    // Merge runs [r0, r1) of 'from' (run ends in 'bound') sequentially into 'to'
+    bool merge(FIL* from, const std::vector<uint32_t>& bound, size_t r0, size_t r1, rec_writer* w) {
+        size_t k = r1 - r0;
+        std::vector<rec_reader*> rd(k);
+        std::vector<std::string> head(k);
+        std::vector<bool> live(k);
+        for (size_t j = 0; j < k; ++j) {
+            rd[j] = new rec_reader { from, bound[r0 + j], bound[r0 + j + 1] };
+            live[j] = rd[j]->next(head[j]);
+        }
+        bool ok = true;
+        for (;;) {
+            if (get_last_key_pressed() == fabgl::VirtualKey::VK_F1) { ok = false; break; }
+            int m = -1;
+            for (size_t j = 0; j < k; ++j) {
+                if (live[j] && (m < 0 || cmp(head[j], head[m]) < 0)) m = j;
+            }
+            if (m < 0) break;
+            w->put(head[m]);
+            live[m] = rd[m]->next(head[m]);
+        }
+        for (auto r : rd) delete r;
+        return ok;
     }
 public:
     inline sorted_files() { }
     inline void close(void) { if (open && storage_file) fclose2(storage_file); open = false; }
     inline ~sorted_files() { close(); }
     inline size_t size(void) { return sz; }
+    inline size_t dirs(void) { return hdr.ndirs; }
+    // Index still matches the directory as walked by the caller
+    inline bool valid(uint32_t sclust, uint32_t count, uint32_t hash) {
+        return open && hdr.version == SORT_VERSION && hdr.sclust == sclust && hdr.count == count && hdr.hash == hash;
+    }
     inline void unlink(void) {
         close();
         f_unlink(idx_file.c_str());
         storage_file = fopen2(idx_file.c_str(), FA_READ | FA_WRITE | FA_CREATE_ALWAYS);
         if (storage_file) open = true;
         sz = 0;
+        memset(&hdr, 0, sizeof(hdr));
+        run.clear();
+        run_bytes = 0;
+        runs.clear();
     }
     inline void init(const std::string& folder) {
         close();
@@ -116,34 +230,81 @@ public:
         idx_file = "/tmp/." + s + ".idx";
         calc_sz();
     }
-    inline void put(size_t i, const std::string& s) {
-        f_lseek(storage_file, rec_size * i);
-        UINT bw;
-        char buf[rec_size] = { 0 };
-        strncpy(buf, s.c_str(), rec_size - 1);
-        f_write(storage_file, buf, rec_size, &bw);
-    }
     inline void push(const std::string& s) {
-        put(sz++, s);
+        run.push_back(s);
+        run_bytes += s.size() + sizeof(std::string);
+        ++sz;
+        if (run_bytes >= SORT_RUN_BYTES) flush_run();
     }
-    inline size_t crc(void) {
-        size_t res = SORT_VERSION;
-        for (size_t i = 0; i < sz; ++i) {
-            res += ::crc(get(i));
+    // Sort everything pushed since unlink() and write the header
+    void sort(uint32_t sclust, uint32_t ndirs, uint32_t hash) {
+        if (!open) return;
+        bool ok = flush_run();
+        if (ok && scratch) {
+            runs.push_back(f_size(scratch) / rec_size);
+            // Merge passes scratch -> scratch2 until SORT_WAYS runs are left,
+            // then the final pass straight into the index (after its header)
+            FIL* other = 0;
+            while (ok && runs.size() - 1 > SORT_WAYS) {
+                if (!other) other = fopen2((idx_file + ".tm2").c_str(), FA_READ | FA_WRITE | FA_CREATE_ALWAYS);
+                if (!other) { ok = false; break; }
+                f_lseek(other, 0);
+                f_truncate(other);
+                rec_writer* w = new rec_writer { other };
+                std::vector<uint32_t> next;
+                for (size_t r = 0; ok && r + 1 < runs.size(); r += SORT_WAYS) {
+                    next.push_back(f_tell(other) / rec_size + w->n);
+                    ok = merge(scratch, runs, r, min(r + SORT_WAYS, runs.size() - 1), w);
+                }
+                w->flush();
+                delete w;
+                next.push_back(f_size(other) / rec_size);
+                runs.swap(next);
+                std::swap(scratch, other);
+            }
+            if (ok) {
+                f_lseek(storage_file, rec_size);
+                rec_writer* w = new rec_writer { storage_file };
+                ok = merge(scratch, runs, 0, runs.size() - 1, w);
+                w->flush();
+                delete w;
+            }
+            if (other) {
+                fclose2(other);
+                f_unlink((idx_file + ".tm2").c_str());
+            }
+            fclose2(scratch);
+            scratch = 0;
+            f_unlink((idx_file + ".tmp").c_str());
+            f_unlink((idx_file + ".tm2").c_str());
         }
-        return res;
+        runs.clear();
+        if (!ok) return; // cancelled: no header, rebuilt next time
+        memcpy(hdr.magic, "SIDX", 4);
+        hdr.version = SORT_VERSION;
+        hdr.sclust = sclust;
+        hdr.count = sz;
+        hdr.ndirs = ndirs;
+        hdr.hash = hash;
+        char buf[rec_size] = { 0 };
+        memcpy(buf, &hdr, sizeof(hdr));
+        UINT bw;
+        f_lseek(storage_file, 0);
+        f_write(storage_file, buf, rec_size, &bw);
+        f_sync(storage_file);
     }
     inline std::string get(size_t i) {
-        f_lseek(storage_file, rec_size * i);
+        f_lseek(storage_file, rec_size * (i + 1));
         UINT br;
         char buf[rec_size];
+        buf[0] = 0;
         f_read(storage_file, buf, rec_size, &br);
         return (buf);
     }
     inline std::string operator[](size_t i) {
         return get(i);
     }
-    inline int cmp(const std::string& s1, const std::string& s2) {
+    static inline int cmp(const std::string& s1, const std::string& s2) {
         // Case-insensitive compare; DIR_MARKER (0x01) stays lowest so dirs sort first
         size_t len = s1.size() < s2.size() ? s1.size() : s2.size();
         for (size_t i = 0; i < len; i++) {
@@ -153,106 +314,20 @@ public:
         }
         return (int)s1.size() - (int)s2.size();
     }
-    inline int cmp(size_t i1, size_t i2) {
-        return cmp(get(i1), get(i2));
-    }
-    inline void swap(size_t i1, size_t i2) {
-        std::string s1 = get(i1);
-        std::string s2 = get(i2);
-        put(i1, s2);
-        put(i2, s1);
-    }
-    inline void vecswap(size_t i1, size_t i2, size_t num) {
-        for (size_t i = 0; i < num; ++i) {
-            swap(i1 + i, i2 + i);
+    // First real (upper-cased) character of an entry, DIR_MARKERs skipped
+    static inline uint8_t initial(const std::string& s) {
+        for (size_t i = 0; i < s.size(); i++) {
+            if ((uint8_t)s[i] != DIR_MARKER) return toupper((uint8_t)s[i]);
         }
+        return 0;
     }
-    inline size_t med3(size_t a, size_t b, size_t c) {
-	    return cmp(a, b) < 0 ? (cmp(b, c) < 0 ? b : (cmp(a, c) < 0 ? c : a )) : (cmp(b, c) > 0 ? b : (cmp(a, c) < 0 ? a : c ));
-    }
-    inline void sort(void) {
-        qsort(0, sz);
-    }
-    void qsort(size_t ai, size_t n) {
-        if (!n) return;
-        size_t pn, pm, pl, d, pa, pb, pc, pd = 0;
-        int r;
-    loop:
-        fabgl::VirtualKey lkp = get_last_key_pressed();
-        if (lkp == fabgl::VirtualKey::VK_F1) return;
-        size_t swap_cnt = 0;
-        if (n < 7) {
-            for (pm = ai + 1; pm < ai + n; ++pm) {
-                for (pl = pm; pl > ai && cmp(pl - 1, pl) > 0; --pl) {
-                    swap(pl, pl - 1);
-                }
-            }
+    // Binary search in [lo, hi) for the first entry whose initial is >= c
+    size_t lower_initial(size_t lo, size_t hi, uint8_t c) {
+        while (lo < hi) {
+            size_t mid = lo + ((hi - lo) >> 1);
+            if (initial(get(mid)) < c) lo = mid + 1; else hi = mid;
         }
-        pm = ai + (n / 2);
-	    if (n > 7) {
-		    pl = ai;
-		    pn = ai + (n - 1);
-		    if (n > 40) {
-			    d = (n / 8);
-			    pl = med3(pl, pl + d, pl + 2 * d);
-			    pm = med3(pm - d, pm, pm + d);
-    			pn = med3(pn - 2 * d, pn - d, pn);
-	    	}
-		    pm = med3(pl, pm, pn);
-	    }
-	    swap(ai, pm);
-	    pa = pb = ai + 1;
-        pc = pd = ai + (n - 1);
-	    for (;;) {
-		    while (pb <= pc && (r = cmp(pb, ai)) <= 0) {
-                fabgl::VirtualKey lkp = get_last_key_pressed();
-                if (lkp == fabgl::VirtualKey::VK_F1) return;
-			    if (r == 0) {
-				    swap_cnt = 1;
-				    swap(pa, pb);
-				    ++pa;
-                }
-			    ++pb;
-		    }
-		    while (pb <= pc && (r = cmp(pc, ai)) >= 0) {
-                fabgl::VirtualKey lkp = get_last_key_pressed();
-                if (lkp == fabgl::VirtualKey::VK_F1) return;
-			    if (r == 0) {
-				    swap_cnt = 1;
-				    swap(pc, pd);
-				    --pd;
-			    }
-			    --pc;
-		    }
-		    if (pb > pc)
-			    break;
-		    swap(pb, pc);
-		    swap_cnt = 1;
-		    ++pb;
-		    --pc;
-	    }
-	    if (swap_cnt == 0) {  // Switch to insertion sort
-		    for (pm = ai + 1; pm < ai + n; ++pm)
-			    for (pl = pm; pl > ai && cmp(pl - 1, pl) > 0; --pl) {
-                    fabgl::VirtualKey lkp = get_last_key_pressed();
-                    if (lkp == fabgl::VirtualKey::VK_F1) return;
-				    swap(pl, pl - 1);
-                }
-		    return;
-        }
-	    pn = ai + n;
-	    r = min(pa - ai, pb - pa);
-	    vecswap(ai, pb - r, r);
-	    r = min(pd - pc, pn - pd - 1);
-	    vecswap(pb, pn - r, r);
-	    if ((r = pb - pa) > 1)
-		qsort(ai, r);
-	    if ((r = pd - pc) > 1) { 
-		    // Iterate rather than recurse to save stack space
-		    ai = pn - r;
-		    n = r;
-		    goto loop;
-	    }
+        return lo;
     }
 };
 
@@ -471,32 +546,31 @@ string OSD::fileDialog(string &fdir, const string& title, uint8_t ftype, uint8_t
         if (res) {
         
             FILINFO fileInfo;
-            size_t crc = SORT_VERSION;
+            uint32_t sclust = f_dir.obj.sclust;
+            uint32_t crc = 2166136261u;
             if (fdir.size() > 1) {
                 ++ndirs;
-                crc += ::crc(string(2, DIR_MARKER) + "..");
+                crc = ::crc(crc, "..", true);
             }
             while (f_readdir(&f_dir, &fileInfo) == FR_OK && fileInfo.fname[0] != '\0') {
                 if (ESPectrum::PS2Controller.keyboard()->virtualKeyAvailable()) {
                    fabgl::VirtualKey lkp = get_last_key_pressed();
                    if (lkp == fabgl::VirtualKey::VK_F1) break;
                 }
-                string fname = fileInfo.fname;
-                if (fname.compare(0,1,".") != 0) {
+                if (fileInfo.fname[0] != '.') {
                         if (fileInfo.fattrib & AM_DIR) {
                             ++ndirs;
-                            crc += ::crc(char(DIR_MARKER) + fname);
+                            crc = ::crc(crc, fileInfo.fname, true);
                         }
                         else {
                             ++elements; // Count elements in dir
-                            crc += ::crc(fname);
+                            crc = ::crc(crc, fileInfo.fname, false);
                         }
                 }
             }
 
             f_closedir(&f_dir);
-            uint32_t rcrc = filenames.crc();
-            if (rcrc != crc) { // reindex
+            if (!filenames.valid(sclust, ndirs + elements, crc)) { // reindex
                 filenames.unlink();
                 if (fdir.size() > 1) {
                     filenames.push(string(2, DIR_MARKER) + "..");
@@ -521,13 +595,13 @@ string OSD::fileDialog(string &fdir, const string& title, uint8_t ftype, uint8_t
                             OSD::progressDialog(
                                 OSD_FILE_INDEXING[Config::lang],
                                 OSD_FILE_INDEXING_1[Config::lang],
-                                f_idx * 95 / (ndirs + elements) + 5,
+                                f_idx * 90 / (ndirs + elements) + 5,
                                 1
                             );
                     }
                 }
                 f_closedir(&f_dir);
-                filenames.sort();
+                filenames.sort(sclust, ndirs, crc);
             }
         }
         OSD::progressDialog(OSD_FILE_INDEXING[Config::lang], OSD_FILE_INDEXING_1[Config::lang], 100, 2);
@@ -763,26 +837,25 @@ string OSD::fileDialog(string &fdir, const string& title, uint8_t ftype, uint8_t
                             int cur_idx = (FileUtils::fileTypes[ftype].begin_row - 2) + (FileUtils::fileTypes[ftype].focus - 2);
                             // Get first real char of current entry (skip DIR_MARKER)
                             std::string cur_s = (cur_idx >= 0 && cur_idx < (int)filenames.size()) ? filenames[cur_idx] : "";
-                            uint8_t letra = 0;
-                            for (size_t ci = 0; ci < cur_s.size(); ci++) {
-                                if ((uint8_t)cur_s[ci] != DIR_MARKER) { letra = toupper(cur_s[ci]); break; }
-                            }
+                            uint8_t letra = sorted_files::initial(cur_s);
                             // Start search from next entry if already on matching letter (cycle through)
                             int start = (letra == fsearch) ? cur_idx + 1 : 0;
                             int cnt = -1;
                             int total = (int)filenames.size();
-                            // Search from start to end, then wrap around from 0 to start
-                            for (int i = 0; i < total; i++) {
-                                int idx = (start + i) % total;
-                                std::string s = filenames[idx];
-                                // Skip DIR_MARKER prefix to get real first char
-                                for (size_t ci = 0; ci < s.size(); ci++) {
-                                    if ((uint8_t)s[ci] != DIR_MARKER) {
-                                        if (toupper(s[ci]) == fsearch) cnt = idx;
-                                        break;
-                                    }
-                                }
-                                if (cnt >= 0) break;
+                            // Dirs and files are sorted separately: binary search each
+                            // part for its block of entries starting with fsearch
+                            int ndir = min((int)filenames.dirs(), total);
+                            int lo[2], hi[2];
+                            lo[0] = filenames.lower_initial(0, ndir, fsearch);
+                            hi[0] = filenames.lower_initial(lo[0], ndir, fsearch + 1);
+                            lo[1] = filenames.lower_initial(ndir, total, fsearch);
+                            hi[1] = filenames.lower_initial(lo[1], total, fsearch + 1);
+                            // First match at or after start, else wrap to the first one
+                            for (int k = 0; k < 2 && cnt < 0; k++) {
+                                if (lo[k] < hi[k] && hi[k] > start) cnt = max(lo[k], start);
+                            }
+                            for (int k = 0; k < 2 && cnt < 0; k++) {
+                                if (lo[k] < hi[k]) cnt = lo[k];
                             }
                             if (cnt >= 0 && cnt != cur_idx) {
                                 last_begin_row = FileUtils::fileTypes[ftype].begin_row;
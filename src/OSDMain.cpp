@@ -58,6 +58,8 @@ visit https://zxespectrum.speccy.org/contacto
 #include "diskio.h"
 #include "psram_spi.h"
 #include "Ports.h"
+#include "Profiler.h"
+#include "Rewind.h"
 #include "audio.h"
 #include "AySound.h"
 #include "Midi.h"
@@ -1136,6 +1138,10 @@ void OSD::do_OSD(fabgl::VirtualKey KeytoESP, bool ALT, bool CTRL) {
         } else if (FileUtils::fsMount && hkIdx == Config::HK_QUICK_SAVE) {
             // Quick Save — save to current persist slot without dialog (same as F4 + F4)
             persistSave(Config::persist_slot, Config::persist_slot, true);
+        } else if (hkIdx == Config::HK_REWIND) {
+            // Rewind — step back to the previous in-memory snapshot
+            if (!Rewind::stepBack())
+                OSD::osdCenteredMsg(Config::lang ? "Nada que rebobinar" : "Nothing to rewind", LEVEL_WARN, 1000);
         } else if (FileUtils::fsMount && hkIdx == Config::HK_LOAD_ANY) {
             menu_level = 0;
             menu_saverect = false;
@@ -1298,9 +1304,10 @@ void OSD::do_OSD(fabgl::VirtualKey KeytoESP, bool ALT, bool CTRL) {
                 }
             }
         } else if (hkIdx == Config::HK_STATS) {
-            // Show / hide OnScreen Stats
+            // Show / hide OnScreen Stats. Pages: 1 tape, 2 speed, 3 FDD,
+            // then the profiler (OSD bit 3), then off
             {
-                uint8_t mode = VIDEO::OSD & 0x03;
+                uint8_t mode = VIDEO::OSD & 0x08 ? 4 : VIDEO::OSD & 0x03;
                 bool hasFdd = (Z80Ops::isPentagon || (Z80Ops::is128 && Z80Ops::isByte)
 #if !PICO_RP2040
                                 || ((Z80Ops::is48 || Z80Ops::is128) && MB02::enabled))
@@ -1315,10 +1322,20 @@ void OSD::do_OSD(fabgl::VirtualKey KeytoESP, bool ALT, bool CTRL) {
 
                 if (mode == 0)
                     mode = Tape::tapeStatus == TAPE_LOADING ? 1 : 2;
+                else if (mode == maxMode)
+                    mode = 4;
                 else
                     mode++;
 
-                if (mode > maxMode) {
+                if (mode == 4) {
+                    Profiler::enable(true);
+                } else if (Profiler::on) {
+                    Profiler::enable(false);
+                    if (Profiler::dump())
+                        OSD::osdCenteredMsg(Config::lang ? "Perfil guardado" : "Profile saved", LEVEL_INFO, 1000);
+                }
+
+                if (mode > 4) {
                     if ((VIDEO::OSD & 0x04) == 0) {
                         OSD::clearStats();
                         if (Config::aspect_16_9)
@@ -1327,9 +1344,9 @@ void OSD::do_OSD(fabgl::VirtualKey KeytoESP, bool ALT, bool CTRL) {
                             VIDEO::Draw_OSD43 = VIDEO::BottomBorder;
                         VIDEO::brdnextframe = true;
                     }
-                    VIDEO::OSD &= 0xfc;
+                    VIDEO::OSD &= 0xf4;
                 } else {
-                    VIDEO::OSD = (VIDEO::OSD & 0xfc) | mode;
+                    VIDEO::OSD = (VIDEO::OSD & 0xf4) | (mode == 4 ? 0x08 : mode);
                     if ((VIDEO::OSD & 0x04) == 0) {
                         if (Config::aspect_16_9)
                             VIDEO::Draw_OSD169 = VIDEO::MainScreen_OSD;
@@ -1807,6 +1824,9 @@ void OSD::do_OSD(fabgl::VirtualKey KeytoESP, bool ALT, bool CTRL) {
                                         Config::trdosFastMode = (opt2 == 1);
                                         if (Config::trdosFastMode != prev) {
                                             ESPectrum::fdd.fastmode = Config::trdosFastMode;
+#if !PICO_RP2040
+                                            ESPectrum::fdd.fastraw = Config::trdosFastMode;
+#endif
                                             Config::save();
                                         }
                                         menu_curopt = opt2;
@@ -9199,7 +9219,7 @@ static const char* hkIdNames[Config::HK_COUNT] = {
     "HK_DEBUG", "HK_DISK", "HK_NMI", "HK_RESET_TO",
     "HK_USB_BOOT", "HK_GIGASCREEN", "HK_BP_LIST", "HK_JUMP_TO",
     "HK_POKE", "HK_VIDMODE_60", "HK_VIDMODE_50",
-    "HK_QUICK_LOAD", "HK_QUICK_SAVE"
+    "HK_QUICK_LOAD", "HK_QUICK_SAVE", "HK_REWIND"
 };
 
 static string expandHotkeys(const char* menu) {
@@ -9258,6 +9278,7 @@ const char* const hkDescEN[Config::HK_COUNT] = {
     "HDMI 50Hz mode",       // HK_VIDMODE_50
     "Quick Load snapshot",  // HK_QUICK_LOAD
     "Quick Save snapshot",  // HK_QUICK_SAVE
+    "Rewind",               // HK_REWIND
 };
 // ES
 const char* const hkDescES[Config::HK_COUNT] = {
@@ -9294,6 +9315,7 @@ const char* const hkDescES[Config::HK_COUNT] = {
     "Modo HDMI 50Hz",        // HK_VIDMODE_50
     "Carga rapida snapshot", // HK_QUICK_LOAD
     "Guardado rapido snapshot", // HK_QUICK_SAVE
+    "Rebobinar",             // HK_REWIND
 };
 
 static const int HK_MENU_WIDTH = 32; // usable cols for hotkey menu
@@ -10471,6 +10493,10 @@ uint16_t OSD::BPListDialog() {
             } else {
                 snprintf(buf, sizeof(buf), "#%02d %s %04X             ", scroll + i + 1, Config::bpTypeName(bp.type), bp.addr);
             }
+            if (bp.cond != Config::BPC_NONE) {
+                // The condition replaces the disassembly column
+                snprintf(buf + 12, sizeof(buf) - 12, " %s%s%04X", Config::bpCondName(bp.cond), bp.condNe ? "!=" : "==", bp.condVal);
+            }
             buf[28] = 0;
             VIDEO::vga.print(buf);
         }
@@ -10513,11 +10539,9 @@ uint16_t OSD::BPListDialog() {
     return 0xFFFF;
 }
 
-void OSD::BPDialog() {
-    const char* items[] = { "PC address", "Port read", "Port write", "Mem write", "Mem read" };
-    Config::BPType types[] = { Config::BP_PC, Config::BP_PORT_READ, Config::BP_PORT_WRITE, Config::BP_MEM_WRITE, Config::BP_MEM_READ };
-    const char* titles[] = { "PC breakpoint", "Port read BP", "Port write BP", "Mem write BP", "Mem read BP" };
-    const int nItems = 5;
+// Small list picker used by the breakpoint dialogs. If 'ne' is given, SPACE
+// toggles it and the items are shown with "==" / "!=". Returns -1 on ESC.
+int OSD::BPPickDialog(const char* title, const char* const* items, int nItems, bool* ne) {
     int sel = 0;
 
     const unsigned short h = (nItems + 2) * OSD_FONT_H + 4;
@@ -10535,7 +10559,7 @@ void OSD::BPDialog() {
         VIDEO::vga.fillRect(x + 1, y + 1 + OSD_FONT_H, w - 2, h - OSD_FONT_H - 2, zxColor(7, 1));
         VIDEO::vga.setTextColor(zxColor(7, 1), zxColor(0, 0));
         VIDEO::vga.setCursor(x + OSD_FONT_W + 1, y + 1);
-        VIDEO::vga.print("Breakpoint type");
+        VIDEO::vga.print(title);
 
         for (int i = 0; i < nItems; i++) {
             int yi = y + (i + 2) * OSD_FONT_H;
@@ -10544,7 +10568,10 @@ void OSD::BPDialog() {
             else
                 VIDEO::vga.setTextColor(zxColor(0, 1), zxColor(7, 1));
             VIDEO::vga.setCursor(x + OSD_FONT_W, yi);
-            snprintf(buf, 24, " %-15s", items[i]);
+            if (ne && i > 0)
+                snprintf(buf, 24, " %-5s %s        ", items[i], *ne ? "!=" : "==");
+            else
+                snprintf(buf, 24, " %-15s", items[i]);
             buf[16] = 0;
             VIDEO::vga.print(buf);
         }
@@ -10556,21 +10583,46 @@ void OSD::BPDialog() {
         if (!key.down) continue;
         if (key.vk == fabgl::VK_UP) { if (sel > 0) sel--; }
         else if (key.vk == fabgl::VK_DOWN) { if (sel < nItems - 1) sel++; }
+        else if (key.vk == fabgl::VK_SPACE && ne) { *ne = !*ne; }
         else if (key.vk == fabgl::VK_RETURN || key.vk == fabgl::VK_KP_ENTER) {
             VIDEO::SaveRect.restore_last();
-            uint32_t address = addressDialog(Z80::getRegPC(), titles[sel]);
-            if (address == 0x00010000 || address == 0x00010001) return;
-            Config::addBreakPoint(address, types[sel]);
-            Config::save();
-            return;
+            return sel;
         }
         else if (key.vk == fabgl::VK_ESCAPE) {
             VIDEO::SaveRect.restore_last();
-            return;
+            return -1;
         }
     }
 }
 
+void OSD::BPDialog() {
+    const char* items[] = { "PC address", "Port read", "Port write", "Mem write", "Mem read" };
+    Config::BPType types[] = { Config::BP_PC, Config::BP_PORT_READ, Config::BP_PORT_WRITE, Config::BP_MEM_WRITE, Config::BP_MEM_READ };
+    const char* titles[] = { "PC breakpoint", "Port read BP", "Port write BP", "Mem write BP", "Mem read BP" };
+
+    int sel = BPPickDialog("Breakpoint type", items, 5);
+    if (sel < 0) return;
+    uint32_t address = addressDialog(Z80::getRegPC(), titles[sel]);
+    if (address == 0x00010000 || address == 0x00010001) return;
+
+    // Optional condition; "Value" is the byte read/written, so PC and PR don't offer it
+    const char* conds[] = { "Always", "A", "BC", "DE", "HL", "IX", "IY", "SP", "Value" };
+    bool hasVal = types[sel] != Config::BP_PC && types[sel] != Config::BP_PORT_READ;
+    bool ne = false;
+    int c = BPPickDialog("Stop if", conds, hasVal ? 9 : 8, &ne);
+    if (c < 0) return;
+    uint16_t val = 0;
+    if (c > 0) {
+        char t[16];
+        snprintf(t, sizeof(t), "%s %s", conds[c], ne ? "!=" : "==");
+        uint32_t v = addressDialog(0, t);
+        if (v == 0x00010000 || v == 0x00010001) return;
+        val = v;
+    }
+    Config::addBreakPoint(address, types[sel], (Config::BPCond)c, ne, val);
+    Config::save();
+}
+
 bool OSD::dumpRangeDialog(uint16_t &from, uint16_t &to) {
     char tmp0[8], tmp1[8];
     snprintf(tmp0, 8, "%04X", from);
@@ -155,6 +155,7 @@ public:
     static void pokeDialog();
     static void jumpToDialog();
     static void hotkeyDialog();
+    static int BPPickDialog(const char* title, const char* const* items, int nItems, bool* ne = nullptr);
     static void BPDialog();
     static uint16_t BPListDialog();
     static bool dumpRangeDialog(uint16_t &from, uint16_t &to);
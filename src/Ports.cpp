@@ -48,6 +48,7 @@ visit https://zxespectrum.speccy.org/contacto
 #include "roms.h"
 #include "wd1793.h"
 #include "Debug.h"
+#include "Profiler.h"
 
 #include "OSDMain.h"
 
@@ -84,6 +85,36 @@ uint8_t Ports::speaker_values[8] = {0, 19, 34, 53, 97, 101, 130, 134};
 uint8_t Ports::port[128];
 uint8_t Ports::port254 = 0;
 uint8_t Ports::portAFF7 = 0;
+uint16_t Ports::decode[256];
+
+void Ports::decodeInit() {
+  for (int p8 = 0; p8 < 256; p8++) {
+    uint16_t d = 0;
+    if (Z80Ops::isPentagon && (p8 == 0xFB || p8 == 0x7B)) d |= PD_PENT_RAM;
+    if (p8 == 0xF7) d |= PD_XMEM;
+#if !PICO_RP2040
+    if (p8 == 0x3B) d |= PD_ULAPLUS;
+    if (p8 == 0xCF) d |= PD_MIDI;
+#ifdef USE_GS
+    if (p8 == 0xB3 || p8 == 0xBB) d |= PD_GS;
+#endif
+    if (p8 == 0xFF) d |= PD_FF;
+    if (p8 == 0x0B || p8 == 0x6B) d |= PD_DMA;
+    if ((p8 & 0x9F) == 0x0F || p8 == 0x13 || p8 == 0x17) d |= PD_MB02;
+    if (p8 == 0xE3 || (p8 & 0xE3) == 0xA3 || p8 == 0xEB || p8 == 0xE7) d |= PD_DIVMMC;
+    if (p8 == 0x57 || p8 == 0x77) d |= PD_ZC;
+#endif
+    switch (p8 & 0xE3) {
+    case 0x03: case 0x23: case 0x43: case 0x63: case 0xE3: d |= PD_BETA; break;
+    }
+    if (p8 == 0xDF) d |= PD_MOUSE;
+    // Kempston on #1F decodes A5=0 only; #37, #5F and Fuller #7F exactly
+    if ((p8 & 0x20) == 0 || p8 == 0x37 || p8 == 0x5F || p8 == 0x7F) d |= PD_JOY;
+    if ((p8 & 0x02) == 0) d |= PD_AY;
+    if (p8 == 0xFB || p8 == 0xDD) d |= PD_COVOX;
+    decode[p8] = d;
+  }
+}
 #if !PICO_RP2040
 Ports::PIT8253Channel Ports::pitChannels[3] = {};
 #endif
@@ -139,8 +170,11 @@ IRAM_ATTR void Ports::FDDStep(bool force) {
   CPU::tstates_diff += p_states - CPU::prev_tstates;
 
   if (force ||
-      ((ESPectrum::fdd.control & (kRVMWD177XHLD | kRVMWD177XHLT)) != 0))
+      ((ESPectrum::fdd.control & (kRVMWD177XHLD | kRVMWD177XHLT)) != 0)) {
+    uint32_t prof = Profiler::begin();
     rvmWD1793Step(&ESPectrum::fdd, CPU::tstates_diff / WD177XSTEPSTATES); // FDD
+    Profiler::end(PROF_FDC, prof);
+  }
 
   CPU::tstates_diff = CPU::tstates_diff % WD177XSTEPSTATES;
 
@@ -151,8 +185,11 @@ IRAM_ATTR void Ports::FDDStep(bool force) {
 IRAM_ATTR static void FDDStep_MB02(bool force) {
   CPU::tstates_diff += p_states - CPU::prev_tstates;
   if (force ||
-      ((ESPectrum::mb02_fdd.control & (kRVMWD177XHLD | kRVMWD177XHLT)) != 0))
+      ((ESPectrum::mb02_fdd.control & (kRVMWD177XHLD | kRVMWD177XHLT)) != 0)) {
+    uint32_t prof = Profiler::begin();
     rvmWD1793Step(&ESPectrum::mb02_fdd, CPU::tstates_diff / WD177XSTEPSTATES);
+    Profiler::end(PROF_FDC, prof);
+  }
   CPU::tstates_diff = CPU::tstates_diff % WD177XSTEPSTATES;
   CPU::prev_tstates = p_states;
 }
@@ -180,7 +217,7 @@ inline static size_t extendedZxRamPages() {
 
 IRAM_ATTR uint8_t Ports::input(uint16_t address) {
   uint8_t data;
-  if (Config::numPortReadBP > 0 && Config::hasBreakPoint(address, Config::BP_PORT_READ))
+  if (Config::numPortReadBP > 0 && Config::hitBreakPoint(address, Config::BP_PORT_READ))
     CPU::portBasedBP = true;
   uint8_t rambank = address >> 14;
   p_states = CPU::tstates;
@@ -201,12 +238,13 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     VIDEO::Draw(1, MemESP::ramContended[rambank]); // I/O Contention (Early)
   }
 
-  if (MEM_PG_CNT > 64 && address == 0xAFF7) {
-    return portAFF7;
-  }
   bool ia = Z80Ops::isALF;
   uint8_t p8 = address & 0xFF;
-  if (Z80Ops::isPentagon) { // Hidden RAM (Pentagon 512/1024 only)
+  uint16_t dec = decode[p8];
+  if ((dec & PD_XMEM) && MEM_PG_CNT > 64 && address == 0xAFF7) {
+    return portAFF7;
+  }
+  if (dec & PD_PENT_RAM) { // Hidden RAM (Pentagon 512/1024 only)
     if (p8 == 0xFB) { // Hidden RAM on
       MemESP::newSRAM = true;
       MemESP::recoverPage0();
@@ -265,7 +303,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
 #endif
 #if !PICO_RP2040
     // ULA+ data port read
-    if (Config::ulaplus && address == 0xFF3B) {
+    if ((dec & PD_ULAPLUS) && Config::ulaplus && address == 0xFF3B) {
       uint8_t reg = VIDEO::ulaplus_reg;
       if ((reg & 0xC0) == 0x00)
         return VIDEO::ulaplus_palette[reg & 0x3F];
@@ -275,11 +313,11 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     // ShamaZX MIDI — status read from 0xA1CF
     // Bit 6 = "receiver full" — reflect real UART FIFO state
     // enabled 2=ShamaZX HW, 3=Soft Synth (both use ShamaZX ports)
-    if (Midi::enabled >= 2 && address == 0xA1CF) {
+    if ((dec & PD_MIDI) && Midi::enabled >= 2 && address == 0xA1CF) {
       return Midi::busy() ? 0x40 : 0x00;
     }
     // ShamaZX MIDI — read from 0xA0CF (parallel mode handshake)
-    if (Midi::enabled >= 2 && address == 0xA0CF) {
+    if ((dec & PD_MIDI) && Midi::enabled >= 2 && address == 0xA0CF) {
       return 0x00;
     }
 #ifdef USE_GS
@@ -290,7 +328,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     //     Debug::log("IN %04X (a8=%02X) GS.en=%d", address, a8, GS::enabled);
     //   }
     // }
-    if (GS::enabled && !DivMMC::divide_mode) {
+    if ((dec & PD_GS) && GS::enabled && !DivMMC::divide_mode) {
       uint8_t a8 = address & 0xFF;
       if (a8 == 0xB3 || a8 == 0xBB) {
         ioContentionLate(MemESP::ramContended[rambank]);
@@ -299,12 +337,12 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     }
 #endif
     // Timex SCLD port read (port 0x00FF) — skip when TR-DOS is active (port conflict)
-    if (Config::timex_video && !ESPectrum::trdos && address == 0x00FF) {
+    if ((dec & PD_FF) && Config::timex_video && !ESPectrum::trdos && address == 0x00FF) {
       ioContentionLate(MemESP::ramContended[rambank]);
       return VIDEO::timex_port_ff;
     }
     // Z80 DMA / zxnDMA port read: listen on both 0x0B and 0x6B
-    if (Config::dma_mode && ((address & 0xFF) == 0x0B || (address & 0xFF) == 0x6B)) {
+    if ((dec & PD_DMA) && Config::dma_mode) {
       ioContentionLate(MemESP::ramContended[rambank]);
       return Z80DMA::readPort();
     }
@@ -314,7 +352,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
 
 #if !PICO_RP2040
     // MB-02+ ports: FDC (#0F/#2F/#4F/#6F), floppy status (#13)
-    if (MB02::enabled) {
+    if ((dec & PD_MB02) && MB02::enabled) {
       uint8_t lo = address & 0xFF;
       if ((lo & 0x9F) == 0x0F) { // WD2797 registers
         FDDStep_MB02(true); // force step — WD2797 needs step advancement for Seek/Restore
@@ -330,7 +368,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
       }
     }
 
-    if (DivMMC::enabled) {
+    if ((dec & PD_DIVMMC) && DivMMC::enabled) {
       uint8_t lo = address & 0xFF;
       if (lo == 0xE3) {
         return (DivMMC::conmem ? 0x80 : 0) | (DivMMC::mapram ? 0x40 : 0) | DivMMC::bank;
@@ -350,7 +388,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
       }
     }
 
-    if (DivMMC::zc_enabled) {
+    if ((dec & PD_ZC) && DivMMC::zc_enabled) {
       uint8_t lo = address & 0xFF;
       if (lo == 0x77) return DivMMC::zc_read_status();
       if (lo == 0x57) return DivMMC::zc_read_data();
@@ -360,12 +398,12 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     // Beta-128 ports: accessible when TR-DOS ROM is paged in,
     // or when a raw-format disk (UDI/FDI) is inserted (copy-protected loaders
     // access WD1793 ports from RAM with TR-DOS ROM paged out)
-    if (ESPectrum::trdos
+    if ((dec & PD_BETA) && (ESPectrum::trdos
 #if !PICO_RP2040
         || (ESPectrum::fdd.disk[ESPectrum::fdd.diskS] &&
             (ESPectrum::fdd.disk[ESPectrum::fdd.diskS]->IsUDIFile || ESPectrum::fdd.disk[ESPectrum::fdd.diskS]->IsFDIFile))
 #endif
-    ) {
+    )) {
 
       uint8_t dat;
 
@@ -392,7 +430,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     }
 
     /// if (ESPectrum::ps2mouse && Config::mouse == 1)
-    {
+    if (dec & PD_MOUSE) {
       if ((address & 0x05ff) == 0x01df) {
         return (uint8_t)ESPectrum::mouseX;
       }
@@ -408,7 +446,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     // Kempston Joystick
     // Standard Kempston decodes A5=0 (so port 0x1F catches 0x00..0x1F).
     // Non-standard kempstonPort values (0x37, 0x5F) use exact low-byte match.
-    if (Config::joystick == JOY_KEMPSTON) {
+    if ((dec & PD_JOY) && Config::joystick == JOY_KEMPSTON) {
       bool kempston_hit = (Config::kempstonPort == 0x1F)
                               ? ((p8 & 0x20) == 0)
                               : (p8 == Config::kempstonPort);
@@ -418,11 +456,11 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
     }
 
     // Fuller Joystick
-    if (Config::joystick == JOY_FULLER && p8 == 0x7F)
+    if ((dec & PD_JOY) && Config::joystick == JOY_FULLER && p8 == 0x7F)
       return port[0x7f];
 
     // Sound (AY-3-8912)
-    if (ESPectrum::AY_emu) {
+    if ((dec & PD_AY) && ESPectrum::AY_emu) {
       if ((address & 0xC002) == 0xC000) {
         if (ia) {
           return chips[AySound::selected_chip]->getRegisterData() | newAlfBit;
@@ -458,6 +496,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
             MemESP::videoLatch = bitRead(data, 3);
             VIDEO::grmem = MemESP::videoLatch ? MemESP::ram[7].direct()
                                               : MemESP::ram[5].direct();
+            VIDEO::dirtyAll();
             if (Config::gigascreen_onoff == 2) VIDEO::gigascreen_auto_countdown = 3;
 #if !PICO_RP2040
             if (VIDEO::mode16col_enabled) VIDEO::mode16colUpdatePlanes();
@@ -477,7 +516,7 @@ IRAM_ATTR uint8_t Ports::input(uint16_t address) {
 
 IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
   int Audiobit;
-  if (Config::numPortWriteBP > 0 && Config::hasBreakPoint(address, Config::BP_PORT_WRITE))
+  if (Config::numPortWriteBP > 0 && Config::hitBreakPoint(address, Config::BP_PORT_WRITE, data))
     CPU::portBasedBP = true;
   uint8_t rambank = address >> 14;
 
@@ -494,9 +533,10 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
     VIDEO::Draw(1, MemESP::ramContended[rambank]); // I/O Contention (Early)
   }
   uint8_t a8 = (address & 0xFF);
+  uint16_t dec = decode[a8];
   p_states = CPU::tstates;
 
-  if (address == 0xAFF7) {
+  if ((dec & PD_XMEM) && address == 0xAFF7) {
     uint8_t prev = portAFF7;
     uint8_t d6 = data & 0b00111111; // limit it for 64 planes
     if (prev != d6) {
@@ -518,10 +558,11 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
 #if !PICO_RP2040
   // Port #EFF7 D0 enables Pentagon 16col video mode (Alone Coder).
   // Other bits historically reserved (D1=hardware multicolor stub, etc.) — ignored.
-  if (Z80Ops::isPentagon && Config::mode16col_onoff && address == 0xEFF7) {
+  if ((dec & PD_XMEM) && Z80Ops::isPentagon && Config::mode16col_onoff && address == 0xEFF7) {
     bool want = (data & 0x01) != 0;
     if (want != VIDEO::mode16col_enabled) {
       VIDEO::mode16col_enabled = want;
+      VIDEO::line_ahead = false; // takes effect mid-line
       if (want) VIDEO::mode16colUpdatePlanes();
     }
   }
@@ -589,8 +630,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
       if ((address & 0x4000) != 0) {
         chips[AySound::selected_chip]->selectRegister(data);
       } else {
-        if (Tape::tapeStatus != TAPE_LOADING) ESPectrum::AYGetSample();
-        chips[AySound::selected_chip]->setRegisterData(data);
+        ESPectrum::AYWrite(data);
       }
       VIDEO::Draw(3, !Z80Ops::isPentagon); // I/O Contention (Late)
       return;
@@ -630,7 +670,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
   } else {
 #if !PICO_RP2040
     // ULA+ ports (odd addresses: 0xBF3B register select, 0xFF3B data)
-    if (Config::ulaplus) {
+    if ((dec & PD_ULAPLUS) && Config::ulaplus) {
       if (address == 0xBF3B) {
         VIDEO::ulaplus_reg = data;
         ioContentionLate(MemESP::ramContended[rambank]);
@@ -663,22 +703,24 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
       }
     }
 #endif
-    int covox = Config::covox;
-    if ((covox == 1 && a8 == 0xFB) || (covox == 2 && a8 == 0xDD)) {
-      ESPectrum::lastCovoxVal = data;
-      ESPectrum::CovoxGetSample();
+    if (dec & PD_COVOX) {
+      int covox = Config::covox;
+      if ((covox == 1 && a8 == 0xFB) || (covox == 2 && a8 == 0xDD)) {
+        ESPectrum::lastCovoxVal = data;
+        ESPectrum::CovoxGetSample();
+      }
     }
 #if !PICO_RP2040
     // ShamaZX MIDI Interface (SAM2695)
     // 0xA0CF = control port: TX data byte here
     // 0xA1CF = data port: write 0xFF/0x3F for init, read status (bit 6 = receiver full)
-    if (Midi::enabled >= 2 && address == 0xA0CF) {
+    if ((dec & PD_MIDI) && Midi::enabled >= 2 && address == 0xA0CF) {
       Midi::send(data);
       return;
     }
 #ifdef USE_GS
     // General Sound — host-side data/command ports
-    if (GS::enabled && !DivMMC::divide_mode) {
+    if ((dec & PD_GS) && GS::enabled && !DivMMC::divide_mode) {
       if (a8 == 0xB3 || a8 == 0xBB) {
         if (a8 == 0xB3) GS::hostWriteB3(data);
         else            GS::hostWriteBB(data);
@@ -688,17 +730,18 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
     }
 #endif
     // Z80 DMA / zxnDMA port write: listen on both 0x0B and 0x6B
-    if (Config::dma_mode && (a8 == 0x0B || a8 == 0x6B)) {
+    if ((dec & PD_DMA) && Config::dma_mode) {
       Z80DMA::writePort(data);
       ioContentionLate(MemESP::ramContended[rambank]);
       return;
     }
     // Timex SCLD video mode register (port 0x00FF, bit 8 clear)
     // Skip when TR-DOS is active — port 0xFF is the Beta-128 system register
-    if (Config::timex_video && !ESPectrum::trdos && a8 == 0xFF && !(address & 0x0100)) {
+    if ((dec & PD_FF) && Config::timex_video && !ESPectrum::trdos && !(address & 0x0100)) {
       VIDEO::timex_port_ff = data & 0x3F;
       VIDEO::timex_mode = data & 0x07;
       VIDEO::timex_hires_ink = (data >> 3) & 0x07;
+      VIDEO::line_ahead = false; // takes effect mid-line
       ioContentionLate(MemESP::ramContended[rambank]);
       return;
     }
@@ -706,7 +749,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
     // Ports: 0x00FF/0x01FF (original), 0x04FF/0x05FF (Light/Middle revisions)
     //        0x00FE/0x01FE (FPGA48all.tap and some other programs use a8=0xFE)
     // Accessible only when TR-DOS ROM is NOT mapped (DOS/ = 1)
-    if (ESPectrum::SAA_emu && !ESPectrum::trdos && (a8 == 0xFF)) {
+    if ((dec & PD_FF) && ESPectrum::SAA_emu && !ESPectrum::trdos) {
       if (address & 0x0100) {
         // Register select (bit 8 set): 0x01FF, 0x05FF, etc.
         // Generate samples before selectRegister — it advances external envelope clock
@@ -723,7 +766,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
 #endif
     // AY
     // ========================================================================
-    if ((ESPectrum::AY_emu) &&
+    if ((dec & PD_AY) && (ESPectrum::AY_emu) &&
         (Config::turbosound == 1 || Config::turbosound == 3) &&
         address == 0xFFFD) { // NedoPC way
       if (data == 0xFF) {
@@ -732,7 +775,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
         AySound::selected_chip = 1;
       }
     }
-    if ((ESPectrum::AY_emu) && ((address & 0x8002) == 0x8000)) {
+    if ((dec & PD_AY) && (ESPectrum::AY_emu) && ((address & 0x8002) == 0x8000)) {
       if (a8 == 0xFF) { // Old TS way
         AySound::selected_chip = 0;
       } else if (a8 == 0xFE && Config::turbosound > 1) {
@@ -740,15 +783,14 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
       } else if ((address & 0x4000) != 0) {
         chips[AySound::selected_chip]->selectRegister(data);
       } else {
-        if (Tape::tapeStatus != TAPE_LOADING) ESPectrum::AYGetSample();
-        chips[AySound::selected_chip]->setRegisterData(data);
+        ESPectrum::AYWrite(data);
       }
       ioContentionLate(MemESP::ramContended[rambank]);
       return;
     }
 #if !PICO_RP2040
     // MB-02+ ports: FDC (#0F/#2F/#4F/#6F), floppy control (#13), memory paging (#17)
-    if (MB02::enabled) {
+    if ((dec & PD_MB02) && MB02::enabled) {
       uint8_t lo = address & 0xFF;
       if ((lo & 0x9F) == 0x0F) { // WD2797 registers
         FDDStep_MB02(false);
@@ -773,7 +815,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
       }
     }
 
-    if (DivMMC::enabled) {
+    if ((dec & PD_DIVMMC) && DivMMC::enabled) {
       uint8_t lo = address & 0xFF;
       if (lo == 0xE3) {
         DivMMC::bank = data & (DIVMMC_NUM_BANKS - 1);
@@ -800,7 +842,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
       }
     }
 
-    if (DivMMC::zc_enabled) {
+    if ((dec & PD_ZC) && DivMMC::zc_enabled) {
       uint8_t lo = address & 0xFF;
       if (lo == 0x77) { DivMMC::zc_write_config(data); return; }
       if (lo == 0x57) { DivMMC::zc_write_data(data); return; }
@@ -808,7 +850,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
 #endif
 
     // Check if TRDOS Rom is mapped.
-    if (ESPectrum::trdos) {
+    if ((dec & PD_BETA) && ESPectrum::trdos) {
 
       switch (address & 0xe3) {
 
@@ -920,6 +962,7 @@ IRAM_ATTR void Ports::output(uint16_t address, uint8_t data) {
         MemESP::videoLatch = bitRead(data, 3);
         VIDEO::grmem = MemESP::videoLatch ? MemESP::ram[7].direct()
                                           : MemESP::ram[5].direct();
+        VIDEO::dirtyAll();
         if (Config::gigascreen_onoff == 2) VIDEO::gigascreen_auto_countdown = 3;
 #if !PICO_RP2040
         if (VIDEO::mode16col_enabled) VIDEO::mode16colUpdatePlanes();
@@ -1013,7 +1056,7 @@ IRAM_ATTR void Ports::dmaOutput(uint16_t address, uint8_t data) {
         if ((address & 0x4000) != 0) {
             chips[AySound::selected_chip]->selectRegister(data);
         } else {
-            chips[AySound::selected_chip]->setRegisterData(data);
+            ESPectrum::AYWrite(data);
         }
     }
 #if !PICO_RP2040
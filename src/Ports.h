@@ -57,6 +57,8 @@ public:
 
     static uint8_t portAFF7;
 
+    static void decodeInit(); // rebuild decode[] for the current machine
+
 #if !PICO_RP2040
     // KR580VI53 (Intel 8253 PIT) — Byte computer sound synthesizer
     struct PIT8253Channel {
@@ -73,6 +75,30 @@ public:
 
 private :
 
+    // Port decoder: for each low address byte, the devices whose address
+    // decoding can match it. input()/output() skip everything else with one
+    // table load. Machine-only devices are left out at CPU::reset(); the
+    // ones the OSD can switch on and off keep testing their flag behind
+    // their bit.
+    enum {
+        PD_PENT_RAM = 0x0001, // Pentagon hidden RAM #FB/#7B
+        PD_XMEM     = 0x0002, // #AFF7 RAM extension, #EFF7 16 colour mode
+        PD_ULAPLUS  = 0x0004, // #BF3B/#FF3B
+        PD_MIDI     = 0x0008, // ShamaZX #A0CF/#A1CF
+        PD_GS       = 0x0010, // General Sound #B3/#BB
+        PD_FF       = 0x0020, // Timex SCLD, SAA1099
+        PD_DMA      = 0x0040, // Z80 DMA #0B/#6B
+        PD_MB02     = 0x0080, // MB-02+ FDC, #13, #17
+        PD_DIVMMC   = 0x0100, // DivMMC/DivIDE
+        PD_ZC       = 0x0200, // Z-Controller #57/#77
+        PD_BETA     = 0x0400, // Beta-128
+        PD_MOUSE    = 0x0800, // Kempston mouse
+        PD_JOY      = 0x1000, // Kempston, Fuller
+        PD_AY       = 0x2000, // A1=0
+        PD_COVOX    = 0x4000, // #FB/#DD
+    };
+    static uint16_t decode[256];
+
     static void ioContentionLate(bool contend);
     static uint8_t port254;
     static uint8_t speaker_values[8];
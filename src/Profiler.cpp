@@ -0,0 +1,97 @@
+#include "Profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "ff.h"
+#include "FileUtils.h"
+
+#define PROF_CSV CONFIG_DIR "/profile.csv"
+
+bool Profiler::on = false;
+uint32_t Profiler::acc[PROF_COUNT];
+uint16_t Profiler::ring[PROF_FRAMES][PROF_COUNT];
+uint8_t Profiler::head = 0;
+uint8_t Profiler::filled = 0;
+uint32_t Profiler::hist[PROF_HIST];
+
+void Profiler::enable(bool en) {
+    if (en && !on) {
+        memset(acc, 0, sizeof(acc));
+        memset(hist, 0, sizeof(hist));
+        head = 0;
+        filled = 0;
+    }
+    on = en;
+}
+
+static inline uint32_t net(uint32_t total, uint32_t nested) {
+    return total > nested ? total - nested : 0;
+}
+
+void Profiler::frame(int64_t busy, int64_t idle) {
+    if (!on) return;
+
+    acc[PROF_Z80] = net(acc[PROF_Z80], acc[PROF_VID] + acc[PROF_FDC]);
+    acc[PROF_MIX] = net(acc[PROF_MIX], acc[PROF_AY] + acc[PROF_SAA]);
+    acc[PROF_BUSY] = busy > 0 ? busy : 0;
+    acc[PROF_IDLE] = idle > 0 ? idle : 0;
+
+    uint16_t* r = ring[head];
+    for (int i = 0; i < PROF_COUNT; i++) {
+        r[i] = acc[i] > 0xffff ? 0xffff : acc[i];
+        acc[i] = 0;
+    }
+    if (++head == PROF_FRAMES) head = 0;
+    if (filled < PROF_FRAMES) filled++;
+
+    uint32_t ms = r[PROF_BUSY] / 1000;
+    hist[ms < PROF_HIST - 1 ? ms : PROF_HIST - 1]++;
+}
+
+void Profiler::text(char* lin1, char* lin2, size_t len) {
+    uint32_t sum[PROF_COUNT] = { 0 };
+    uint32_t worst = 0;
+    for (int f = 0; f < filled; f++) {
+        for (int i = 0; i < PROF_COUNT; i++) sum[i] += ring[f][i];
+        if (ring[f][PROF_BUSY] > worst) worst = ring[f][PROF_BUSY];
+    }
+    float n = filled ? filled * 1000.0f : 1.0f;
+    snprintf(lin1, len, "Z80%5.1f VID%4.1f FDC%4.1f",
+             sum[PROF_Z80] / n, sum[PROF_VID] / n, sum[PROF_FDC] / n);
+    snprintf(lin2, len, "SND%4.1f IO%4.1f MAX%5.1f ",
+             (sum[PROF_AY] + sum[PROF_SAA] + sum[PROF_MIX]) / n, sum[PROF_IO] / n,
+             worst / 1000.0f);
+}
+
+// Per-frame stage times (us, oldest first) followed by the busy-time histogram
+bool Profiler::dump() {
+    if (!filled) return false;
+
+    FIL f;
+    if (f_open(&f, PROF_CSV, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return false;
+
+    char line[96];
+    UINT bw;
+    int l = snprintf(line, sizeof(line), "frame,z80,vid,fdc,io,ay,saa,mix,osd,busy,idle\n");
+    f_write(&f, line, l, &bw);
+
+    int idx = head - filled;
+    if (idx < 0) idx += PROF_FRAMES;
+    for (int n = 0; n < filled; n++) {
+        const uint16_t* r = ring[idx];
+        l = snprintf(line, sizeof(line), "%d,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", n,
+                     r[PROF_Z80], r[PROF_VID], r[PROF_FDC], r[PROF_IO], r[PROF_AY],
+                     r[PROF_SAA], r[PROF_MIX], r[PROF_OSD], r[PROF_BUSY], r[PROF_IDLE]);
+        f_write(&f, line, l, &bw);
+        if (++idx == PROF_FRAMES) idx = 0;
+    }
+
+    l = snprintf(line, sizeof(line), "\nbusy_ms,frames\n");
+    f_write(&f, line, l, &bw);
+    for (int i = 0; i < PROF_HIST; i++) {
+        l = snprintf(line, sizeof(line), i < PROF_HIST - 1 ? "%d,%u\n" : "%d+,%u\n", i, hist[i]);
+        f_write(&f, line, l, &bw);
+    }
+
+    return f_close(&f) == FR_OK;
+}
@@ -0,0 +1,52 @@
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#include <inttypes.h>
+#include <stddef.h>
+#include "pico/time.h"
+
+// Profiler: where each frame of ESPectrum::loop() goes, stage by stage, so a
+// title that misses the frame budget shows which subsystem is to blame.
+// It runs only while the OSD profiler page is shown; otherwise every scope is
+// a single flag test.
+//
+// Z80 is CPU::loop() net of the VID and FDC time spent inside it; MIX is the
+// audio block of loop() net of AY and SAA generation. VID is the whole-line
+// paper renderer plus VIDEO::EndFrame(): per-T-state drawing (raster effects,
+// snow) counts as Z80. IO is the once-per-frame SD work: swap cache, disk
+// write-back, rewind capture and tape prefetch.
+
+enum {
+    PROF_Z80, PROF_VID, PROF_FDC, PROF_IO, PROF_AY, PROF_SAA, PROF_MIX, PROF_OSD,
+    PROF_BUSY, PROF_IDLE, PROF_COUNT
+};
+
+#if !PICO_RP2040
+#define PROF_FRAMES 64   // per-frame history kept for averages and the dump
+#else
+#define PROF_FRAMES 16
+#endif
+#define PROF_HIST   26   // busy time per frame, 1 ms buckets, last is 25 ms+
+
+class Profiler {
+public:
+    static bool on;
+
+    static void enable(bool en);  // switching on clears history and histogram
+    static inline uint32_t begin() { return on ? (uint32_t)time_us_64() : 0; }
+    static inline void end(uint8_t stage, uint32_t t0) {
+        if (on) acc[stage] += (uint32_t)time_us_64() - t0;
+    }
+    static void frame(int64_t busy, int64_t idle); // once per loop() iteration
+    static void text(char* lin1, char* lin2, size_t len); // OSD page, ms
+    static bool dump();           // history and histogram as CSV on the SD card
+
+private:
+    static uint32_t acc[PROF_COUNT];               // current frame, us
+    static uint16_t ring[PROF_FRAMES][PROF_COUNT]; // last frames, us
+    static uint8_t head;
+    static uint8_t filled;
+    static uint32_t hist[PROF_HIST];
+};
+
+#endif
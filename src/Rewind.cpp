@@ -0,0 +1,317 @@
+#include "Rewind.h"
+
+#include <string.h>
+#include "pico/time.h"
+#include "psram_spi.h"
+#include "Config.h"
+#include "CPU.h"
+#include "ESPectrum.h"
+#include "MemESP.h"
+#include "Video.h"
+#include "Z80_JLS/z80.h"
+#include "Z80_JLS/z80operations.h"
+
+Rewind::stats_t Rewind::stats = { 0, 0, 0, 0, 0, REWIND_INTERVAL };
+uint32_t Rewind::base = 0;
+uint32_t Rewind::ring = 0;
+uint32_t Rewind::ringSize = 0;
+uint32_t Rewind::head = 0;
+uint32_t Rewind::used = 0;
+Rewind::rec_t Rewind::recs[REWIND_MAX_SNAPS];
+uint8_t Rewind::first = 0;
+uint8_t Rewind::cnt = 0;
+uint32_t Rewind::refSum[REWIND_PAGES];
+bool Rewind::refValid = false;
+uint32_t Rewind::frames = 0;
+
+// Record header; REWIND_PAGES x 16 chunks of deltas follow for every page set
+// in 'mask', each chunk a 16-bit length (0: unchanged) and its coded bytes.
+// Pointers are only ever restored into the same session.
+struct rewind_state_t {
+    uint16_t af, bc, de, hl, afx, bcx, dex, hlx, ix, iy, sp, pc, memptr;
+    uint8_t i, r, im, flags;
+    uint32_t tstates;
+    uint32_t page0ram, bankLatch;
+    uint8_t* ramCurrent[4];
+    uint8_t* grmem;
+    bool ramContended[4];
+    uint8_t videoLatch, romLatch, pagingLock, romInUse, notMore128, newSRAM;
+    uint8_t borderColor, trdos;
+    uint8_t mask;
+};
+
+#define RS_IFF1     0x01
+#define RS_IFF2     0x02
+#define RS_HALTED   0x04
+#define RS_EI       0x08
+
+static uint8_t xbuf[REWIND_CHUNK];
+static uint8_t cbuf[REWIND_CHUNK + REWIND_CHUNK / 128 + 8];
+
+// Zero-run coding of an XOR delta: 0x80|n = n+1 zero bytes, n = n+1 literal
+// bytes follow. An unchanged chunk codes to nothing.
+static uint32_t encode(const uint8_t* src, uint8_t* dst) {
+    uint32_t i = 0, o = 0;
+    bool any = false;
+    while (i < REWIND_CHUNK) {
+        uint32_t j = i;
+        while (j < REWIND_CHUNK && !src[j] && j - i < 128) ++j;
+        if (j > i) {
+            dst[o++] = 0x80 | (j - i - 1);
+            i = j;
+            continue;
+        }
+        // literals run on over single zeros
+        while (j < REWIND_CHUNK && j - i < 128 && (src[j] || (j + 1 < REWIND_CHUNK && src[j + 1]))) ++j;
+        dst[o++] = j - i - 1;
+        memcpy(dst + o, src + i, j - i);
+        o += j - i;
+        i = j;
+        any = true;
+    }
+    return any ? o : 0;
+}
+
+static void decode(const uint8_t* src, uint32_t n, uint8_t* dst) {
+    uint32_t o = 0;
+    for (uint32_t i = 0; i < n && o < REWIND_CHUNK; ) {
+        uint8_t t = src[i++];
+        uint32_t len = (t & 0x7F) + 1;
+        if (o + len > REWIND_CHUNK) len = REWIND_CHUNK - o;
+        if (t & 0x80) {
+            memset(dst + o, 0, len);
+        } else {
+            memcpy(dst + o, src + i, len);
+            i += len;
+        }
+        o += len;
+    }
+    if (o < REWIND_CHUNK) memset(dst + o, 0, REWIND_CHUNK - o);
+}
+
+bool Rewind::region() {
+    // Same reservations as SaveRect (Video.cpp) and GS::init()
+    uint32_t spi = psram_size();
+    uint32_t lo = (MEM_PG_CNT + 2) * MEM_PG_SZ + (64ul << 10);
+    if (lo < (2ul << 20)) lo = 2ul << 20;
+    lo += 256ul << 10;
+    uint32_t hi = spi;
+#ifdef USE_GS
+    if (Config::gs_enabled) hi = hi > (2ul << 20) ? hi - (2ul << 20) : 0;
+#endif
+    if (hi < lo + REWIND_PAGES * MEM_PG_SZ + REWIND_RING_MIN) return false;
+    base = lo;
+    ring = base + REWIND_PAGES * MEM_PG_SZ;
+    ringSize = hi - ring;
+    if (ringSize > REWIND_RING_MAX) ringSize = REWIND_RING_MAX;
+    return true;
+}
+
+void Rewind::reset() {
+    base = 0;
+    head = used = 0;
+    first = cnt = 0;
+    refValid = false;
+    frames = 0;
+    stats = { 0, 0, 0, 0, 0, REWIND_INTERVAL };
+    region();
+}
+
+// Byte ring access with wrap-around
+static void ring_write(uint32_t ring, uint32_t size, uint32_t pos, const uint8_t* src, uint32_t n) {
+    if (!n) return;
+    pos %= size;
+    uint32_t a = size - pos < n ? size - pos : n;
+    writepsram(ring + pos, (uint8_t*)src, a);
+    if (n > a) writepsram(ring, (uint8_t*)src + a, n - a);
+}
+
+static void ring_read(uint32_t ring, uint32_t size, uint32_t pos, uint8_t* dst, uint32_t n) {
+    pos %= size;
+    uint32_t a = size - pos < n ? size - pos : n;
+    readpsram(dst, ring + pos, a);
+    if (n > a) readpsram(dst + a, ring, n - a);
+}
+
+void Rewind::drop_oldest() {
+    used -= recs[first].len;
+    first = (first + 1) % REWIND_MAX_SNAPS;
+    --cnt;
+}
+
+bool Rewind::capturable() {
+    if (Z80Ops::is512 || Z80Ops::is1024 || Z80Ops::isALF) return false;
+#if !PICO_RP2040
+    if (MemESP::divmmc_mapped) return false;
+#endif
+    for (int pg = 0; pg < REWIND_PAGES; ++pg)
+        if (!MemESP::ram[pg].direct()) return false; // swapped out
+    return true;
+}
+
+bool Rewind::frame() {
+    if (!base || CPU::paused) return false;
+    if (++frames < stats.interval || !capturable()) return false;
+    capture();
+    frames = 0;
+    return true;
+}
+
+void Rewind::capture() {
+    uint64_t t0 = time_us_64();
+
+    rewind_state_t st;
+    st.af = Z80::getRegAF(); st.bc = Z80::getRegBC(); st.de = Z80::getRegDE(); st.hl = Z80::getRegHL();
+    st.afx = Z80::getRegAFx(); st.bcx = Z80::getRegBCx(); st.dex = Z80::getRegDEx(); st.hlx = Z80::getRegHLx();
+    st.ix = Z80::getRegIX(); st.iy = Z80::getRegIY(); st.sp = Z80::getRegSP(); st.pc = Z80::getRegPC();
+    st.memptr = Z80::getMemPtr();
+    st.i = Z80::getRegI(); st.r = Z80::getRegR(); st.im = Z80::getIM();
+    st.flags = (Z80::isIFF1() ? RS_IFF1 : 0) | (Z80::isIFF2() ? RS_IFF2 : 0) |
+               (Z80::isHalted() ? RS_HALTED : 0) | (Z80::isPendingEI() ? RS_EI : 0);
+    st.tstates = CPU::tstates;
+    st.page0ram = MemESP::page0ram;
+    for (int i = 0; i < 4; ++i) {
+        st.ramCurrent[i] = MemESP::ramCurrent[i];
+        st.ramContended[i] = MemESP::ramContended[i];
+    }
+    st.grmem = VIDEO::grmem;
+    st.bankLatch = MemESP::bankLatch; st.videoLatch = MemESP::videoLatch; st.romLatch = MemESP::romLatch;
+    st.pagingLock = MemESP::pagingLock; st.romInUse = MemESP::romInUse;
+    st.notMore128 = MemESP::notMore128; st.newSRAM = MemESP::newSRAM;
+    st.borderColor = VIDEO::borderColor; st.trdos = ESPectrum::trdos;
+    st.mask = 0;
+
+    // Deltas only matter once there is an older record to step back to; the
+    // first capture after a reset just fills the reference pages
+    bool deltas = refValid && cnt > 0;
+    if (cnt == REWIND_MAX_SNAPS) drop_oldest();
+    uint32_t start = head;
+    uint32_t len = sizeof(st);
+    bool ok = true;
+
+    for (int pg = 0; pg < REWIND_PAGES && ok; ++pg) {
+        uint8_t* p = MemESP::ram[pg].direct();
+        uint32_t sum = page_sum(p);
+        if (refValid && sum == refSum[pg]) continue;
+        uint32_t ref = base + pg * MEM_PG_SZ;
+        for (uint32_t off = 0; off < MEM_PG_SZ; off += REWIND_CHUNK) {
+            if (!refValid) {
+                writepsram(ref + off, p + off, REWIND_CHUNK);
+                continue;
+            }
+            readpsram(xbuf, ref + off, REWIND_CHUNK);
+            for (uint32_t k = 0; k < REWIND_CHUNK; ++k) xbuf[k] ^= p[off + k];
+            uint16_t n = encode(xbuf, cbuf);
+            if (n) writepsram(ref + off, p + off, REWIND_CHUNK);
+            if (!deltas) continue;
+            while (used + len + 2 + n > ringSize && cnt) drop_oldest();
+            if (used + len + 2 + n > ringSize) { ok = false; break; }
+            ring_write(ring, ringSize, start + len, (uint8_t*)&n, 2);
+            ring_write(ring, ringSize, start + len + 2, cbuf, n);
+            len += 2 + n;
+        }
+        refSum[pg] = sum;
+        if (deltas) st.mask |= 1 << pg;
+    }
+    while (ok && used + len > ringSize && cnt) drop_oldest();
+
+    if (!ok || used + len > ringSize) {
+        // larger than the whole ring: start over from the next capture
+        head = used = 0;
+        first = cnt = 0;
+        refValid = false;
+    } else {
+        refValid = true;
+        ring_write(ring, ringSize, start, (uint8_t*)&st, sizeof(st));
+        recs[(first + cnt) % REWIND_MAX_SNAPS] = { start % ringSize, len };
+        ++cnt;
+        used += len;
+        head = (start + len) % ringSize;
+        stats.last_bytes = len;
+    }
+
+    uint32_t us = time_us_64() - t0;
+    ++stats.snaps;
+    stats.last_us = us;
+    if (us > stats.max_us) stats.max_us = us;
+    stats.total_us += us;
+    // Keep the average cost per frame inside the budget
+    uint32_t iv = us / REWIND_BUDGET_US;
+    stats.interval = iv < REWIND_INTERVAL ? REWIND_INTERVAL : (iv > REWIND_INTERVAL_MAX ? REWIND_INTERVAL_MAX : iv);
+}
+
+// Turn the reference pages from record 'rec' state back into the one before
+void Rewind::undo(uint32_t rec) {
+    rewind_state_t st;
+    uint32_t pos = recs[rec].off;
+    ring_read(ring, ringSize, pos, (uint8_t*)&st, sizeof(st));
+    pos += sizeof(st);
+    for (int pg = 0; pg < REWIND_PAGES; ++pg) {
+        if (!(st.mask & (1 << pg))) continue;
+        uint32_t ref = base + pg * MEM_PG_SZ;
+        for (uint32_t off = 0; off < MEM_PG_SZ; off += REWIND_CHUNK) {
+            uint16_t n;
+            ring_read(ring, ringSize, pos, (uint8_t*)&n, 2);
+            pos += 2;
+            if (!n) continue;
+            ring_read(ring, ringSize, pos, cbuf, n);
+            pos += n;
+            decode(cbuf, n, xbuf);
+            readpsram(cbuf, ref + off, REWIND_CHUNK);
+            for (uint32_t k = 0; k < REWIND_CHUNK; ++k) cbuf[k] ^= xbuf[k];
+            writepsram(ref + off, cbuf, REWIND_CHUNK);
+        }
+        refSum[pg] = ~refSum[pg]; // force the copy in restore()
+    }
+}
+
+void Rewind::restore(uint32_t rec) {
+    rewind_state_t st;
+    ring_read(ring, ringSize, recs[rec].off, (uint8_t*)&st, sizeof(st));
+
+    for (int pg = 0; pg < REWIND_PAGES; ++pg) {
+        uint8_t* p = MemESP::ram[pg].direct();
+        if (page_sum(p) == refSum[pg]) continue;
+        readpsram(p, base + pg * MEM_PG_SZ, MEM_PG_SZ);
+        refSum[pg] = page_sum(p);
+    }
+
+    Z80::setRegAF(st.af); Z80::setRegBC(st.bc); Z80::setRegDE(st.de); Z80::setRegHL(st.hl);
+    Z80::setRegAFx(st.afx); Z80::setRegBCx(st.bcx); Z80::setRegDEx(st.dex); Z80::setRegHLx(st.hlx);
+    Z80::setRegIX(st.ix); Z80::setRegIY(st.iy); Z80::setRegSP(st.sp); Z80::setRegPC(st.pc);
+    Z80::setMemPtr(st.memptr);
+    Z80::setRegI(st.i); Z80::setRegR(st.r); Z80::setIM((Z80::IntMode)st.im);
+    Z80::setIFF1(st.flags & RS_IFF1); Z80::setIFF2(st.flags & RS_IFF2);
+    Z80::setHalted(st.flags & RS_HALTED); Z80::setPendingEI(st.flags & RS_EI);
+    CPU::tstates = st.tstates;
+    MemESP::page0ram = st.page0ram;
+    for (int i = 0; i < 4; ++i) {
+        MemESP::ramCurrent[i] = st.ramCurrent[i];
+        MemESP::ramContended[i] = st.ramContended[i];
+    }
+    VIDEO::grmem = st.grmem;
+    MemESP::bankLatch = st.bankLatch; MemESP::videoLatch = st.videoLatch; MemESP::romLatch = st.romLatch;
+    MemESP::pagingLock = st.pagingLock; MemESP::romInUse = st.romInUse;
+    MemESP::notMore128 = st.notMore128; MemESP::newSRAM = st.newSRAM;
+    VIDEO::borderColor = st.borderColor;
+    VIDEO::brd = VIDEO::border32[VIDEO::borderColor];
+    ESPectrum::trdos = st.trdos;
+    VIDEO::dirtyAll();
+}
+
+bool Rewind::stepBack() {
+    if (!base || !cnt) return false;
+    uint32_t last = (first + cnt - 1) % REWIND_MAX_SNAPS;
+    // Right after a capture or a previous step the newest record is "now":
+    // go one further back
+    if (frames < REWIND_INTERVAL / 2 && cnt > 1) {
+        undo(last);
+        used -= recs[last].len;
+        head = recs[last].off;
+        --cnt;
+        last = (first + cnt - 1) % REWIND_MAX_SNAPS;
+    }
+    restore(last);
+    frames = 0;
+    return true;
+}
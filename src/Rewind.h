@@ -0,0 +1,65 @@
+#ifndef __REWIND_H
+#define __REWIND_H
+
+#include <inttypes.h>
+
+// Rewind: every few frames the machine state goes into a ring in SPI PSRAM,
+// so a hotkey can step back in time. Z80/paging state is stored as is; the
+// 16 KB RAM pages are stored as XOR deltas against a reference copy of the
+// last snapshot, zero-run coded, and only for pages whose hash changed.
+//
+// PSRAM map (after the MemESP swap pool and the SaveRect area, below GS RAM):
+//   [base .. base + 128K)     reference copy of pages 0-7
+//   [base + 128K .. end)      byte ring of snapshot records
+
+#define REWIND_PAGES        8
+#define REWIND_CHUNK        1024     // XOR/codec granularity, bytes
+#define REWIND_RING_MIN     (256ul << 10)
+#define REWIND_RING_MAX     (1ul << 20)
+#define REWIND_MAX_SNAPS    64
+#define REWIND_INTERVAL     25       // frames between snapshots (0.5 s)
+#define REWIND_INTERVAL_MAX 250      // (5 s)
+#define REWIND_BUDGET_US    250      // average capture cost allowed per frame
+
+class Rewind {
+public:
+    struct stats_t {
+        uint32_t snaps;       // snapshots taken
+        uint32_t last_us;     // cost of the last capture
+        uint32_t max_us;      // worst capture
+        uint64_t total_us;    // all captures
+        uint32_t last_bytes;  // size of the last record
+        uint32_t interval;    // current frames between snapshots
+    };
+    static stats_t stats;
+
+    static void reset();      // drop every snapshot (machine reset, snapshot load)
+    static bool frame();      // once per frame after CPU::loop(); true if it captured
+    static bool stepBack();   // restore the previous snapshot
+    static uint8_t count() { return cnt; }
+
+private:
+    static bool region();
+    static bool capturable();
+    static void capture();
+    static void restore(uint32_t rec);
+    static void undo(uint32_t rec);
+    static void drop_oldest();
+
+    static uint32_t base;     // PSRAM offset of the reference pages, 0: unavailable
+    static uint32_t ring;     // PSRAM offset of the ring
+    static uint32_t ringSize;
+    static uint32_t head;     // ring offset the next record goes to
+    static uint32_t used;     // bytes held by records
+
+    struct rec_t { uint32_t off, len; };
+    static rec_t recs[REWIND_MAX_SNAPS];
+    static uint8_t first;     // oldest record
+    static uint8_t cnt;
+
+    static uint32_t refSum[REWIND_PAGES]; // page_sum() of the reference pages
+    static bool refValid;
+    static uint32_t frames;   // since the last capture or restore
+};
+
+#endif
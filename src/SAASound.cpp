@@ -113,6 +113,7 @@ void SAASound::init() {
 
     for (int i = 0; i < 6; i++) {
         channels[i].period = 511;
+        channels[i].step = 1;
         channels[i].level = 1; // INITIAL_LEVEL from stripwax
     }
 
@@ -127,6 +128,8 @@ void SAASound::init() {
         envs[i].right_level = 0;
     }
 
+    for (int i = 0; i < 6; i++) ampUpdate(i);
+
     memset(SamplebufSAA_L, 0, sizeof(SamplebufSAA_L));
     memset(SamplebufSAA_R, 0, sizeof(SamplebufSAA_R));
 }
@@ -171,6 +174,7 @@ void SAASound::setRegisterData(uint8_t data) {
     case 0: case 1: case 2: case 3: case 4: case 5:
         channels[selectedRegister].amp_left = data & 0x0F;
         channels[selectedRegister].amp_right = (data >> 4) & 0x0F;
+        ampUpdate(selectedRegister);
         break;
 
     // Frequency offset (=> CSAAFreq::SetFreqOffset)
@@ -190,6 +194,7 @@ void SAASound::setRegisterData(uint8_t data) {
             channels[ch].freq_offset = data;
             channels[ch].next_offset = data;
             channels[ch].octave = channels[ch].next_octave;
+            channels[ch].step = 1u << channels[ch].octave;
             int p = 511 - (int)data;
             channels[ch].period = (p < 1) ? 1 : (uint32_t)p;
         }
@@ -212,6 +217,7 @@ void SAASound::setRegisterData(uint8_t data) {
                 channels[ch].new_data = false;
                 channels[ch].ignore_offset = false;
                 channels[ch].octave = oct;
+                channels[ch].step = 1u << oct;
                 channels[ch].next_octave = oct;
                 channels[ch].freq_offset = channels[ch].next_offset;
                 int p = 511 - (int)channels[ch].freq_offset;
@@ -228,6 +234,7 @@ void SAASound::setRegisterData(uint8_t data) {
                 channels[i].mix_mode |= 1;
             else
                 channels[i].mix_mode &= ~1;
+            ampUpdate(i);
         }
         break;
 
@@ -238,6 +245,7 @@ void SAASound::setRegisterData(uint8_t data) {
                 channels[i].mix_mode |= 2;
             else
                 channels[i].mix_mode &= ~2;
+            ampUpdate(i);
         }
         break;
 
@@ -250,11 +258,13 @@ void SAASound::setRegisterData(uint8_t data) {
     // Envelope 0 (=> CSAAEnv::SetEnvControl)
     case 24:
         envSetControl(0, data);
+        ampUpdate(2);
         break;
 
     // Envelope 1 (=> CSAAEnv::SetEnvControl)
     case 25:
         envSetControl(1, data);
+        ampUpdate(5);
         break;
 
     // Global enable and sync (=> CSAADevice register 28)
@@ -268,6 +278,7 @@ void SAASound::setRegisterData(uint8_t data) {
                     channels[i].level = 1; // INITIAL_LEVEL
                     // Apply pending freq data immediately
                     channels[i].octave = channels[i].next_octave;
+                    channels[i].step = 1u << channels[i].octave;
                     channels[i].freq_offset = channels[i].next_offset;
                     int p = 511 - (int)channels[i].freq_offset;
                     channels[i].period = (p < 1) ? 1 : (uint32_t)p;
@@ -283,7 +294,10 @@ void SAASound::setRegisterData(uint8_t data) {
         }
 
         bool newEnabled = (data & 0x01) != 0;
-        outputEnabled = newEnabled;
+        if (newEnabled != outputEnabled) {
+            outputEnabled = newEnabled;
+            for (int i = 0; i < 6; i++) ampUpdate(i);
+        }
         break;
     }
 
@@ -302,6 +316,7 @@ void SAASound::toneUpdateData(int ch) {
 
     // Always apply octave
     c.octave = c.next_octave;
+    c.step = 1u << c.octave;
     // Only apply offset if not ignored (Philips quirk)
     if (!c.ignore_offset) {
         c.freq_offset = c.next_offset;
@@ -405,6 +420,7 @@ void SAASound::envTick(int env) {
     } else {
         envSetLevels(env);
     }
+    ampUpdate(env * 3 + 2);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -464,6 +480,84 @@ void SAASound::envSetNewData(int env, uint8_t data) {
     envSetLevels(env);
 }
 
+//////////////////////////////////////////////////////////////////////
+// Tone: half-cycle completed (from stripwax CSAAFreq::Tick)
+//////////////////////////////////////////////////////////////////////
+IRAM_ATTR void SAASound::toneWrap(int ch) {
+    Channel &c = channels[ch];
+    while (c.counter >= c.period) {
+        c.counter -= c.period;
+        c.level ^= 1;
+
+        // Trigger connected devices (from CSAAFreq constructor wiring):
+        // ch0 → noise[0] source 3, ch3 → noise[1] source 3
+        if (ch == 0 && noise[0].source == 3) {
+            if (noise[0].rand & 1)
+                noise[0].rand = (noise[0].rand >> 1) ^ 0x20400;
+            else
+                noise[0].rand >>= 1;
+        }
+        if (ch == 3 && noise[1].source == 3) {
+            if (noise[1].rand & 1)
+                noise[1].rand = (noise[1].rand >> 1) ^ 0x20400;
+            else
+                noise[1].rand >>= 1;
+        }
+        // ch1 → env[0] internal clock, ch4 → env[1] internal clock
+        if (ch == 1 && envs[0].enabled && !envs[0].clock_externally)
+            envTick(0);
+        if (ch == 4 && envs[1].enabled && !envs[1].clock_externally)
+            envTick(1);
+
+        // Update buffered octave/offset on half-cycle completion
+        toneUpdateData(ch);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+// Mixer output table (from stripwax CSAAAmp::Tick + TickAndOutputStereo)
+//////////////////////////////////////////////////////////////////////
+void SAASound::ampUpdate(int ch) {
+    const Channel &c = channels[ch];
+    // Envelope only applies to ch2 (env0) and ch5 (env1)
+    const EnvelopeGen *e = (ch == 2) ? &envs[0] : (ch == 5) ? &envs[1] : NULL;
+
+    for (int idx = 0; idx < 4; idx++) {
+        int tone_level = idx & 1;
+        int noise_level = idx >> 1;
+        int intermediate;
+
+        switch (c.mix_mode) {
+        case 1: intermediate = tone_level * 2; break;
+        case 2: intermediate = noise_level * 2; break;
+        case 3: intermediate = tone_level * (2 - noise_level); break;
+        default: intermediate = 0; break;
+        }
+
+        int l = 0, r = 0;
+        if (!outputEnabled) {
+            // Global mute — no output
+        } else if (e && e->enabled) {
+            // Envelope channel with active envelope: use PDM table
+            l = pdm_x4[c.amp_left >> 1][e->left_level] * (2 - intermediate);
+            r = pdm_x4[c.amp_right >> 1][e->right_level] * (2 - intermediate);
+        } else {
+            // Non-envelope channel: simple amplitude * intermediate
+            l = c.amp_left * intermediate * 16;
+            r = c.amp_right * intermediate * 16;
+        }
+        amp_out[ch][idx] = ((uint32_t)r << 16) | (uint32_t)l;
+    }
+}
+
+static inline void saa_lfsr_step(uint32_t &rand) {
+    // 18-bit Galois LFSR (x^18+x^11+x^1, verified against SAA1099P)
+    if (rand & 1)
+        rand = (rand >> 1) ^ 0x20400;
+    else
+        rand >>= 1;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Main audio generation — runs in RAM for speed on RP2350
 // (from stripwax CSAADevice::_TickAndOutputStereo)
@@ -472,116 +566,73 @@ void SAASound::envSetNewData(int env, uint8_t data) {
 //   1. Noise generators (sources 0-2)
 //   2. For each channel 0-5: tone tick → mix → accumulate
 //      Tone tick may trigger noise (source 3) or envelope (internal clock)
+//
+// Per sample a channel costs an add, a compare and one lookup into its
+// amp_out table; half-cycles (at most one per sample, as step <= 128 <
+// 256 <= period) go through toneWrap(). A noise generator on source 0-2
+// that no channel mixes in is advanced once for the whole call.
 //////////////////////////////////////////////////////////////////////
 IRAM_ATTR void SAASound::gen_sound(int bufsize, int bufpos) {
     uint8_t *buf_L = SamplebufSAA_L + bufpos;
     uint8_t *buf_R = SamplebufSAA_R + bufpos;
 
-    while (bufsize-- > 0) {
-        // During sync: output silence, don't advance generators
-        if (syncState) {
-            *buf_L++ = 0;
-            *buf_R++ = 0;
-            continue;
-        }
+    if (bufsize <= 0) return;
+
+    // During sync: output silence, don't advance generators
+    if (syncState) {
+        memset(buf_L, 0, bufsize);
+        memset(buf_R, 0, bufsize);
+        return;
+    }
 
+    // Noise sources 0-2 step every 1, 2 or 4 samples (31250/15625/7812.5 Hz)
+    bool live[2];
+    uint32_t nperiod[2];
+    for (int ng = 0; ng < 2; ng++) {
+        const Channel *c = &channels[ng * 3];
+        nperiod[ng] = 1u << noise[ng].source;
+        live[ng] = noise[ng].source < 3 && outputEnabled &&
+                   ((c[0].mix_mode | c[1].mix_mode | c[2].mix_mode) & 2);
+    }
+
+    for (int n = bufsize; n > 0; n--) {
         // 1. Tick noise generators (sources 0-2 only)
         for (int ng = 0; ng < 2; ng++) {
-            if (noise[ng].source < 3) {
-                uint32_t period;
-                switch (noise[ng].source) {
-                case 0: period = 1; break;  // 31250 Hz
-                case 1: period = 2; break;  // 15625 Hz
-                default: period = 4; break; // 7812.5 Hz
-                }
-                noise[ng].counter++;
-                while (noise[ng].counter >= period) {
-                    noise[ng].counter -= period;
-                    // 18-bit Galois LFSR (x^18+x^11+x^1, verified against SAA1099P)
-                    if (noise[ng].rand & 1)
-                        noise[ng].rand = (noise[ng].rand >> 1) ^ 0x20400;
-                    else
-                        noise[ng].rand >>= 1;
-                }
+            if (live[ng] && ++noise[ng].counter >= nperiod[ng]) {
+                // counter may still be above a period just shortened
+                do {
+                    noise[ng].counter -= nperiod[ng];
+                    saa_lfsr_step(noise[ng].rand);
+                } while (noise[ng].counter >= nperiod[ng]);
             }
         }
 
         // 2. Process channels 0-5
-        int output_l = 0, output_r = 0;
-
+        uint32_t output = 0;
         for (int ch = 0; ch < 6; ch++) {
             Channel &c = channels[ch];
-            int ng = ch / 3;
-
-            // --- Tone tick (CSAAFreq::Tick) ---
-            c.counter += (1 << c.octave);
-            while (c.counter >= c.period) {
-                c.counter -= c.period;
-                c.level ^= 1;
-
-                // Trigger connected devices (from CSAAFreq constructor wiring):
-                // ch0 → noise[0] source 3, ch3 → noise[1] source 3
-                if (ch == 0 && noise[0].source == 3) {
-                    if (noise[0].rand & 1)
-                        noise[0].rand = (noise[0].rand >> 1) ^ 0x20400;
-                    else
-                        noise[0].rand >>= 1;
-                }
-                if (ch == 3 && noise[1].source == 3) {
-                    if (noise[1].rand & 1)
-                        noise[1].rand = (noise[1].rand >> 1) ^ 0x20400;
-                    else
-                        noise[1].rand >>= 1;
-                }
-                // ch1 → env[0] internal clock, ch4 → env[1] internal clock
-                if (ch == 1 && envs[0].enabled && !envs[0].clock_externally)
-                    envTick(0);
-                if (ch == 4 && envs[1].enabled && !envs[1].clock_externally)
-                    envTick(1);
-
-                // Update buffered octave/offset on half-cycle completion
-                toneUpdateData(ch);
-            }
-
-            // --- Mixer (CSAAAmp::Tick + TickAndOutputStereo) ---
-            int tone_level = c.level;
-            int noise_level = noise[ng].rand & 1;
-            int intermediate;
-
-            switch (c.mix_mode) {
-            case 0: intermediate = 0; break;
-            case 1: intermediate = tone_level * 2; break;
-            case 2: intermediate = noise_level * 2; break;
-            case 3: intermediate = tone_level * (2 - noise_level); break;
-            default: intermediate = 0; break;
-            }
-
-            // Output amplitude
-            if (!outputEnabled) {
-                // Global mute — no output
-            } else if ((ch == 2 && envs[0].enabled) || (ch == 5 && envs[1].enabled)) {
-                // Envelope channel with active envelope: use PDM table
-                int env_idx = ch / 3;
-                int el = envs[env_idx].left_level;
-                int er = envs[env_idx].right_level;
-                int al_div2 = c.amp_left >> 1;
-                int ar_div2 = c.amp_right >> 1;
-                output_l += pdm_x4[al_div2][el] * (2 - intermediate);
-                output_r += pdm_x4[ar_div2][er] * (2 - intermediate);
-            } else {
-                // Non-envelope channel: simple amplitude * intermediate
-                output_l += c.amp_left * intermediate * 16;
-                output_r += c.amp_right * intermediate * 16;
-            }
+            c.counter += c.step;
+            if (c.counter >= c.period) toneWrap(ch);
+            output += amp_out[ch][c.level | ((noise[ch / 3].rand & 1) << 1)];
         }
 
         // 3. Scale to uint8_t
         // Max per channel (non-env): 15 * 2 * 16 = 480
         // Max per channel (env): pdm_x4[7][15] * 2 = 212 * 2 = 424
         // 6 channels max: ~2880. >>4 = 180.
-        int out_l = (output_l + 8) >> 4;
-        int out_r = (output_r + 8) >> 4;
+        int out_l = ((output & 0xFFFF) + 8) >> 4;
+        int out_r = ((output >> 16) + 8) >> 4;
         *buf_L++ = (uint8_t)(out_l > 255 ? 255 : out_l);
         *buf_R++ = (uint8_t)(out_r > 255 ? 255 : out_r);
     }
+
+    // Unheard noise generators catch up in one go
+    for (int ng = 0; ng < 2; ng++) {
+        if (noise[ng].source < 3 && !live[ng]) {
+            uint32_t ticks = noise[ng].counter + bufsize;
+            noise[ng].counter = ticks & (nperiod[ng] - 1);
+            for (ticks >>= noise[ng].source; ticks > 0; ticks--)
+                saa_lfsr_step(noise[ng].rand);
+        }
+    }
 }
@@ -54,6 +54,7 @@ private:
         bool ignore_offset;     // Philips quirk: defer offset after same-cycle octave
         uint32_t counter;       // tone accumulator
         uint32_t period;        // = max(511 - freq_offset, 1)
+        uint32_t step;          // = 1 << octave, added every sample
         uint8_t level;          // square wave output (0 or 1)
 
         // Amplifier/mixer (from CSAAAmp)
@@ -63,6 +64,11 @@ private:
     };
     Channel channels[6];
 
+    // Output of each channel for [level | noise bit << 1], left in the low
+    // and right in the high half so six channels sum in one word. Rebuilt
+    // by ampUpdate() whenever amplitude, mixer, enable or envelope change.
+    uint32_t amp_out[6][4];
+
     // Noise generator (from CSAANoise)
     struct NoiseGen {
         uint32_t counter;
@@ -92,6 +98,10 @@ private:
 
     // Tone: update buffered octave/offset on half-cycle
     void toneUpdateData(int ch);
+    // Tone: half-cycle completed, with the devices it clocks
+    void toneWrap(int ch);
+
+    void ampUpdate(int ch);
 
     // Envelope control
     void envSetControl(int env, uint8_t data);
@@ -558,10 +558,9 @@ bool FileZ80::load(const string& z80_fn) {
     uint8_t header[87];
 
     // read first 30 bytes
-    for (uint8_t i = 0; i < 30; i++) {
-        header[i] = readByteFile(file);
-        dataOffset ++;
-    }
+    UINT br;
+    f_read(file, header, 30, &br);
+    dataOffset += 30;
 
     // additional vars
     uint8_t b12, b29;
@@ -634,18 +633,20 @@ bool FileZ80::load(const string& z80_fn) {
         // version 1, the simplest, 48K only.
         uint32_t memRawLength = file_size - dataOffset;
 
+        // 0x4000-0xFFFF as one image across the three mapped pages
+        uint8_t* pages[3] = { MemESP::ramCurrent[1], MemESP::ramCurrent[2], MemESP::ramCurrent[3] };
+
         if (dataCompressed) {
             // assuming stupid 00 ED ED 00 terminator present, should check for it instead of assuming
-            uint16_t dataLen = (uint16_t)(memRawLength - 4);
+            uint32_t dataLen = memRawLength - 4;
 
             // load compressed data into memory
-            loadCompressedMemData(file, dataLen, 0x4000, 0xC000);
+            loadCompressedMemData(file, dataLen, pages, 3);
         } else {
-            uint16_t dataLen = (memRawLength < 0xC000) ? memRawLength : 0xC000;
+            uint32_t dataLen = (memRawLength < 0xC000) ? memRawLength : 0xC000;
 
             // load uncompressed data into memory
-            for (int i = 0; i < dataLen; i++)
-                MemESP::writebyte(0x4000 + i, readByteFile(file));
+            loadMemData(file, dataLen, pages, 3);
         }
 
         // latches for 48K
@@ -659,19 +660,16 @@ bool FileZ80::load(const string& z80_fn) {
     } else {
 
         // read 2 more bytes
-        for (uint8_t i = 30; i < 32; i++) {
-            header[i] = readByteFile(file);
-            dataOffset ++;
-        }
+        f_read(file, header + 30, 2, &br);
+        dataOffset += 2;
 
         // additional header block length
         uint16_t ahblen = mkword(header[30], header[31]);
+        if (ahblen > sizeof(header) - 32) ahblen = sizeof(header) - 32;
 
         // read additional header block
-        for (uint8_t i = 32; i < 32 + ahblen; i++) {
-            header[i] = readByteFile(file);
-            dataOffset ++;
-        }
+        f_read(file, header + 32, ahblen, &br);
+        dataOffset += ahblen;
 
         // program counter
         RegPC = mkword(header[32], header[33]);
@@ -690,12 +688,14 @@ bool FileZ80::load(const string& z80_fn) {
 
             uint32_t dataLen = file_size;
             while (dataOffset < dataLen) {
-                uint8_t hdr0 = readByteFile(file); dataOffset ++;
-                uint8_t hdr1 = readByteFile(file); dataOffset ++;
-                uint8_t hdr2 = readByteFile(file); dataOffset ++;
-                uint16_t compDataLen = mkword(hdr0, hdr1);
-                
-                uint16_t memoff = pageStart[hdr2];
+                uint8_t hdr[3];
+                f_read(file, hdr, 3, &br);
+                dataOffset += 3;
+                uint32_t compDataLen = mkword(hdr[0], hdr[1]);
+
+                // pages other than 4, 5 and 8 are skipped
+                uint16_t memoff = hdr[2] < 12 ? pageStart[hdr[2]] : 0;
+                uint8_t* page = memoff ? MemESP::ramCurrent[memoff >> 14] : NULL;
 
                 if (compDataLen == 0xffff) {                 
 
@@ -703,10 +703,9 @@ bool FileZ80::load(const string& z80_fn) {
 
                     compDataLen = MEM_PG_SZ;
 
-                    for (int i = 0; i < compDataLen; i++)                    
-                        MemESP::writebyte(memoff + i, readByteFile(file));
+                    loadMemData(file, compDataLen, &page, 1);
                 } else {
-                    loadCompressedMemData(file, compDataLen, memoff, MEM_PG_SZ);
+                    loadCompressedMemData(file, compDataLen, &page, 1);
                 }
                 dataOffset += compDataLen;
             }
@@ -734,25 +733,19 @@ bool FileZ80::load(const string& z80_fn) {
 
             uint32_t dataLen = file_size;
             while (dataOffset < dataLen) {
-                uint8_t hdr0 = readByteFile(file); dataOffset ++;
-                uint8_t hdr1 = readByteFile(file); dataOffset ++;
-                uint8_t hdr2 = readByteFile(file); dataOffset ++;
-                uint16_t compDataLen = mkword(hdr0, hdr1);
+                uint8_t hdr[3];
+                f_read(file, hdr, 3, &br);
+                dataOffset += 3;
+                uint32_t compDataLen = mkword(hdr[0], hdr[1]);
+                // only RAM pages are loaded, the rest is skipped
+                uint8_t* sp = (hdr[2] > 2) && (hdr[2] < 11) ? pages[hdr[2]]->sync(4) : NULL;
                 if (compDataLen == 0xffff) { 
                     // load uncompressed data into memory
-                    // printf("Loading uncompressed data\n");
                     compDataLen = MEM_PG_SZ;
-                    if ((hdr2 > 2) && (hdr2 < 11)) {
-                        uint8_t* sp = pages[hdr2]->sync(4);
-                        for (int i = 0; i < compDataLen; i++) {
-                            sp[i] = readByteFile(file);
-                        }
-                    }
+                    loadMemData(file, compDataLen, &sp, 1);
                 } else {
                     // Block is compressed
-                    if ((hdr2 > 2) && (hdr2 < 11)) {
-                        loadCompressedMemPage(file, compDataLen, pages[hdr2]->sync(4), MEM_PG_SZ);
-                    }
+                    loadCompressedMemData(file, compDataLen, &sp, 1);
                 }
                 dataOffset += compDataLen;
             }
@@ -768,82 +761,88 @@ bool FileZ80::load(const string& z80_fn) {
     return true;
 }
 
-void FileZ80::loadCompressedMemData(FIL* f, uint16_t dataLen, uint16_t memoff, uint16_t memlen) {
+// Compressed blocks are read Z80_CHUNK bytes at a time and the ED ED nn bb
+// runs expanded straight into the destination pages: a 16 KB page costs a few
+// f_read calls instead of one per byte. 'memPages' lists consecutive 16 KB
+// pages (a version 1 48K image spans three); NULL entries are skipped.
+#define Z80_CHUNK 512
 
-    uint16_t dataOff = 0;
+void FileZ80::loadCompressedMemData(FIL* f, uint32_t dataLen, uint8_t* const* memPages, uint8_t npages) {
+
+    uint8_t buf[Z80_CHUNK];
+    uint32_t memlen = npages * MEM_PG_SZ;
+    uint32_t memidx = 0;
     uint8_t ed_cnt = 0;
     uint8_t repcnt = 0;
-    uint8_t repval = 0;
-    uint16_t memidx = 0;
-
-    while(dataOff < dataLen && memidx < memlen) {
-        uint8_t databyte = readByteFile(f);
-        if (ed_cnt == 0) {
-            if (databyte != 0xED)
-                MemESP::writebyte(memoff + memidx++, databyte);
-            else
-                ed_cnt++;
-        }
-        else if (ed_cnt == 1) {
-            if (databyte != 0xED) {
-                MemESP::writebyte(memoff + memidx++, 0xED);
-                MemESP::writebyte(memoff + memidx++, databyte);
-                ed_cnt = 0;
-            }
-            else
-                ed_cnt++;
-        }
-        else if (ed_cnt == 2) {
-            repcnt = databyte;
-            ed_cnt++;
+
+    auto fill = [&](uint8_t v, uint32_t n) {
+        while (n && memidx < memlen) {
+            uint32_t off = memidx & (MEM_PG_SZ - 1);
+            uint32_t k = MEM_PG_SZ - off < n ? MEM_PG_SZ - off : n;
+            if (memPages[memidx / MEM_PG_SZ]) memset(memPages[memidx / MEM_PG_SZ] + off, v, k);
+            memidx += k;
+            n -= k;
         }
-        else if (ed_cnt == 3) {
-            repval = databyte;
-            for (uint16_t i = 0; i < repcnt; i++)
-                MemESP::writebyte(memoff + memidx++, repval);
-            ed_cnt = 0;
+    };
+    auto copy = [&](const uint8_t* src, uint32_t n) {
+        while (n && memidx < memlen) {
+            uint32_t off = memidx & (MEM_PG_SZ - 1);
+            uint32_t k = MEM_PG_SZ - off < n ? MEM_PG_SZ - off : n;
+            if (memPages[memidx / MEM_PG_SZ]) memcpy(memPages[memidx / MEM_PG_SZ] + off, src, k);
+            memidx += k;
+            src += k;
+            n -= k;
         }
-    }
-}
+    };
 
-void FileZ80::loadCompressedMemPage(FIL* f, uint16_t dataLen, uint8_t* memPage, uint16_t memlen)
-{
-    uint16_t dataOff = 0;
-    uint8_t ed_cnt = 0;
-    uint8_t repcnt = 0;
-    uint8_t repval = 0;
-    uint16_t memidx = 0;
-
-    while(dataOff < dataLen && memidx < memlen) {
-        uint8_t databyte = readByteFile(f);
-        if (ed_cnt == 0) {
-            if (databyte != 0xED)
-                memPage[memidx++] = databyte;
-            else
+    while (dataLen) {
+        UINT br;
+        if (f_read(f, buf, dataLen < Z80_CHUNK ? dataLen : Z80_CHUNK, &br) != FR_OK || !br) break;
+        dataLen -= br;
+        if (memidx >= memlen) continue; // keep the file position in step with the block
+        for (UINT i = 0; i < br; ) {
+            if (ed_cnt == 0) {
+                // literal span up to the next ED
+                UINT j = i;
+                while (j < br && buf[j] != 0xED) ++j;
+                copy(buf + i, j - i);
+                if (j < br) ed_cnt++;
+                i = j + 1;
+            }
+            else if (ed_cnt == 1) {
+                if (buf[i] != 0xED) {
+                    fill(0xED, 1);
+                    copy(buf + i, 1);
+                    ed_cnt = 0;
+                }
+                else
+                    ed_cnt++;
+                i++;
+            }
+            else if (ed_cnt == 2) {
+                repcnt = buf[i++];
                 ed_cnt++;
-        }
-        else if (ed_cnt == 1) {
-            if (databyte != 0xED) {
-                memPage[memidx++] = 0xED;
-                memPage[memidx++] = databyte;
+            }
+            else {
+                fill(buf[i++], repcnt);
                 ed_cnt = 0;
             }
-            else
-                ed_cnt++;
-        }
-        else if (ed_cnt == 2) {
-            repcnt = databyte;
-            ed_cnt++;
-        }
-        else if (ed_cnt == 3) {
-            repval = databyte;
-            for (uint16_t i = 0; i < repcnt; i++)
-                memPage[memidx++] = repval;
-            ed_cnt = 0;
         }
     }
 }
 
+void FileZ80::loadMemData(FIL* f, uint32_t dataLen, uint8_t* const* memPages, uint8_t npages) {
+    UINT br;
+    for (uint8_t pg = 0; pg < npages && dataLen; ++pg) {
+        uint32_t n = dataLen < MEM_PG_SZ ? dataLen : MEM_PG_SZ;
+        if (memPages[pg])
+            f_read(f, memPages[pg], n, &br);
+        else
+            f_lseek(f, f_tell(f) + n);
+        dataLen -= n;
+    }
+}
+
 void FileZ80::loader48() {
 
     unsigned char *z80_array = (unsigned char *) load48;
@@ -1139,6 +1138,7 @@ bool FileP::load(const string& p_fn) {
     uint16_t address = 16393;
     uint8_t page = address >> 14;
     fread(&MemESP::ramCurrent[page][address & 0x3fff], p_size, 1, *file);
+    VIDEO::dirtyAll();
 
     fclose2(file);
 
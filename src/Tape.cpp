@@ -34,6 +34,7 @@ visit https://zxespectrum.speccy.org/contacto
 */
 
 #include <stdio.h>
+#include <string.h>
 #include <vector>
 #include <string>
 #include <inttypes.h>
@@ -60,8 +61,88 @@ uint32_t Tape::wav_offset = 0;
 
 uint32_t Tape:: mp3_read = 0;
 
-FIL Tape::tape;
-FIL Tape::cswBlock;
+static uint8_t tapeWindow[TAPE_BUF_HALF * 2];
+static uint8_t cswWindow[CSW_BUF_HALF * 2];
+TapeFile Tape::tape(tapeWindow, TAPE_BUF_HALF);
+TapeFile Tape::cswBlock(cswWindow, CSW_BUF_HALF);
+
+// Load the window holding fptr: the aligned half it falls in plus the next one
+bool TapeFile::fill() {
+    if (fptr >= obj.objsize) return false;
+    FSIZE_t start = fptr & ~(FSIZE_t)(half - 1);
+    UINT br = 0;
+    len = 0;
+    if (fil.fptr != start && f_lseek(&fil, start) != FR_OK) return false;
+    if (f_read(&fil, buf, half * 2, &br) != FR_OK) return false;
+    base = start;
+    len = br;
+    return (FSIZE_t)(fptr - base) < len;
+}
+
+// Once the cursor has moved into the second half, drop the first one and read
+// the next half behind it, so the pulse generators rarely hit a refill mid-frame
+void TapeFile::prefetch() {
+    if (!obj.fs || len != half * 2) return;
+    FSIZE_t off = fptr - base;
+    if (off < half || off >= len) return;
+    FSIZE_t next = base + len;
+    if (next >= obj.objsize) return;
+    memmove(buf, buf + half, half);
+    base += half;
+    len = half;
+    UINT br = 0;
+    if (fil.fptr != next && f_lseek(&fil, next) != FR_OK) return;
+    if (f_read(&fil, buf + half, half, &br) == FR_OK) len += br;
+}
+
+UINT TapeFile::read(void* dst, UINT n) {
+    uint8_t* d = (uint8_t*)dst;
+    UINT done = 0;
+    while (done < n) {
+        FSIZE_t off = fptr - base;
+        if (off < len) {
+            UINT chunk = len - off;
+            if (chunk > n - done) chunk = n - done;
+            memcpy(d + done, buf + off, chunk);
+            fptr += chunk;
+            done += chunk;
+            continue;
+        }
+        if (n - done >= half * 2) {
+            // Bulk reads (FlashLoad, CSW inflate) go straight to the file
+            UINT br = 0;
+            if (fil.fptr != fptr && f_lseek(&fil, fptr) != FR_OK) break;
+            f_read(&fil, d + done, n - done, &br);
+            fptr += br;
+            done += br;
+            break;
+        }
+        if (!fill()) break;
+    }
+    return done;
+}
+
+void TapeFile::reset() {
+    fptr = 0;
+    base = 0;
+    len = 0;
+}
+
+FRESULT f_open(TapeFile* fp, const TCHAR* path, BYTE mode) {
+    fp->reset();
+    return f_open(&fp->fil, path, mode);
+}
+
+FRESULT f_close(TapeFile* fp) {
+    fp->reset();
+    return f_close(&fp->fil);
+}
+
+FRESULT f_read(TapeFile* fp, void* buff, UINT btr, UINT* br) {
+    if (!fp->obj.fs) { *br = 0; return FR_INVALID_OBJECT; }
+    *br = fp->read(buff, btr);
+    return FR_OK;
+}
 string Tape::tapeFileName = "none";
 string Tape::tapeSaveName = "none";
 int Tape::tapeFileType = TAPE_FTYPE_EMPTY;
@@ -96,6 +177,11 @@ uint8_t Tape::tapePhase = TAPE_PHASE_STOPPED;
 
 uint8_t Tape::tapeCurByte;
 uint64_t Tape::tapeStart;
+
+uint32_t Tape::tapeEdges[TAPE_EDGE_RING];
+uint16_t Tape::edgeHead = 0;
+uint16_t Tape::edgeTail = 0;
+uint8_t Tape::edgeLevel;
 uint16_t Tape::tapeHdrPulses;
 uint32_t Tape::tapeBlockLen;
 uint8_t Tape::tapeBitMask;
@@ -704,7 +790,7 @@ void Tape::MP3_Open(const string& name) {
     FSIZE_t lp = 0;
     uint32_t sample_rate = musicFileGetSampleRate(mf);
     uint16_t num_channels =  musicFileGetChannels(mf);
-    writeWavHeader(&tape, sample_rate, num_channels);
+    writeWavHeader(&tape.fil, sample_rate, num_channels);
     bool success = true;
     UINT num_samples, written = 0;
     OSD::progressDialog("Convert mp3 to wav", tapeFileName, 0, 0);
@@ -720,7 +806,7 @@ void Tape::MP3_Open(const string& name) {
             for (size_t i = 0; i < mp3_read; ++i) {
                 t[i] = d_buff[i] >> 8;
             }
-            if ((f_write(&tape, d_buff, mp3_read, &written) != FR_OK) || (written != mp3_read)) {
+            if ((f_write(&tape.fil, d_buff, mp3_read, &written) != FR_OK) || (written != mp3_read)) {
                 osd_printf("Error in f_write\n");
                 success = false;
             }
@@ -741,7 +827,7 @@ void Tape::MP3_Open(const string& name) {
         1000
     );
     if (success) {
-        updateWavHeader(&tape, num_samples, num_channels);
+        updateWavHeader(&tape.fil, num_samples, num_channels);
     }
     if (mf) {
         musicFileClose(mf);
@@ -782,7 +868,7 @@ void Tape::TAP_Open(const string& name) {
     int tapeContentIndex = 0;
     int tapeBlkLen = 0;
     TapeBlock block;
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     do {
         // Analyze .tap file
         tapeBlkLen = (readByteFile(tape) | (readByteFile(tape) << 8));
@@ -945,7 +1031,7 @@ string Tape::tapeBlockReadData(int Blocknum) {
     char fname[10];
 
     tapeContentIndex = Tape::CalcTapBlockPos(Blocknum);
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     // Analyze .tap file
     tapeBlkLen=(readByteFile(tape) | (readByteFile(tape) << 8));
 
@@ -1046,6 +1132,7 @@ void Tape::Play() {
     }
 
     // Init tape vars
+    FlushEdges();
     tapeEarBit = 1;
     tapeBitMask = 0x80;
     tapeLastByteUsedBits = 8;
@@ -1093,6 +1180,7 @@ void Tape::TAP_GetBlock() {
 
 void Tape::Stop() {
     OSD::osdCenteredMsg("Tape loading is stopped", LEVEL_INFO, 100);
+    FlushEdges();
     tapeEarBit = 0;
     tapeStatus = TAPE_STOPPED;
     tapePhase = TAPE_PHASE_STOPPED;
@@ -1111,7 +1199,7 @@ IRAM_ATTR void Tape::Read() {
     }
 #endif
     uint64_t tapeCurrent = CPU::global_tstates + CPU::tstates - tapeStart; // states since start
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     if ( tapeFileType == TAPE_FTYPE_MP3 ) {
         if (!mf) return;
         uint32_t FPS = 50;
@@ -1168,246 +1256,178 @@ IRAM_ATTR void Tape::Read() {
         tapeStart = CPU::global_tstates + CPU::tstates - tapeCurrent; // recover?
         return;
     }
-    if (tapeCurrent >= tapeNext) {
+    uint32_t due = edgeHead != edgeTail ? tapeEdges[edgeHead] & TAPE_EDGE_DT : tapeNext;
+    if (tapeCurrent >= due) {
         do {
-            tapeCurrent -= tapeNext;
-            switch (tapePhase) {
-            case TAPE_PHASE_CSW:
-                tapeEarBit ^= 1;
-                if (CSW_CompressionType == 1) { // RLE
-                    CSW_PulseLenght = readByteFile(tape);
-                    tapebufByteCount++;                
-                    if (tapebufByteCount == tapeBlockLen) {
-                        tapeCurByte = CSW_PulseLenght;
-                        if (tapeBlkPauseLen == 0) {
-                            tapeCurBlock++;
-                            GetBlock();
-                        } else {
-                            tapePhase = TAPE_PHASE_TAIL;
-                            tapeNext  = TAPE_PHASE_TAIL_LEN;
-                        }
-                        break;
-                    }
-                    if (CSW_PulseLenght == 0) {
-                        CSW_PulseLenght = readByteFile(tape) | (readByteFile(tape) << 8) | (readByteFile(tape) << 16) | (readByteFile(tape) << 24);
-                        tapebufByteCount += 4;
-                    }                
-                    tapeNext = CSW_SampleRate * CSW_PulseLenght;
-                } else { // Z-RLE
-                    CSW_PulseLenght = readByteFile(&cswBlock);
-                    if (f_eof(&cswBlock)) {
-                        f_close(&cswBlock);
-                        tapeCurByte = readByteFile(tape);
-                        if (tapeBlkPauseLen == 0) {
-                            tapeCurBlock++;
-                            GetBlock();
-                        } else {
-                            tapePhase = TAPE_PHASE_TAIL;
-                            tapeNext  = TAPE_PHASE_TAIL_LEN;
-                        }
-                        break;
-                    }
-                    if (CSW_PulseLenght == 0) {
-                        CSW_PulseLenght = readByteFile(&cswBlock) | (readByteFile(&cswBlock) << 8)
-                                      | (readByteFile(&cswBlock) << 16) | (readByteFile(&cswBlock) << 24);
-                    }                
-                    tapeNext = CSW_SampleRate * CSW_PulseLenght;
-                }
-                break;
-            case TAPE_PHASE_GDB_PILOTSYNC:
-
-                // Get next pulse lenght from current symbol
-                if (++curGDBPulse < npp)
-                    tapeNext = SymDefTable[GDBsymbol].PulseLenghts[curGDBPulse];
-
-                if (tapeNext == 0 || curGDBPulse == npp) {
-
-                    // printf("curGDBPulse: %d, npp: %d\n",(int)curGDBPulse,(int)npp);
-
-                    // Next repetition
-                    if (--tapeHdrPulses == 0) {
-                        
-                        // Get next symbol in PRLE
-                        curGDBSymbol++;
-
-                        if (curGDBSymbol < totp) { // If not end of PRLE
-
-                            // Read pulse data
-                            GDBsymbol = readByteFile(tape); // Read Symbol to be represented from PRLE
-
-                            // Get symbol flags
-                            switch (SymDefTable[GDBsymbol].SymbolFlags) {
-                                case 0:
-                                    tapeEarBit ^= 1;
-                                    break;
-                                case 1:
-                                    break;                                    
-                                case 2:
-                                    tapeEarBit = 0;
-                                    break;
-                                case 3:
-                                    tapeEarBit = 1;
-                                    break;
-                            }
+            tapeCurrent -= due;
+            if (edgeHead != edgeTail) {
+                tapeEarBit = tapeEdges[edgeHead] >> 31;
+                edgeHead = (edgeHead + 1) & (TAPE_EDGE_RING - 1);
+            } else {
+                Step();
+            }
+            if (edgeHead == edgeTail) Compile();
+            due = edgeHead != edgeTail ? tapeEdges[edgeHead] & TAPE_EDGE_DT : tapeNext;
+        } while (tapeCurrent >= due);
 
-                            // Get first pulse lenght from array of pulse lenghts
-                            tapeNext = SymDefTable[GDBsymbol].PulseLenghts[0];
-
-                            // Get number of repetitions from PRLE[0]
-                            tapeHdrPulses = readByteFile(tape) | (readByteFile(tape) << 8); // Number of repetitions of symbol
-                            
-                            curGDBPulse = 0;
-
-                            tapebufByteCount += 3;
-
-                        } else {
-                            
-                            // End of PRLE
-
-                            // Free SymDefTable
-                            FreeSymDefTable();
-
-                            // End of pilotsync. Is there data stream ?
-                            if (totd > 0) {
-
-                                // printf("\nPULSES (DATA)\n");
-
-                                // Allocate memory for the array of pointers to struct Symdef
-                                SymDefTable = new Symdef[asd];
-                                SymDefTableSize = asd;
-
-                                // Allocate memory for each row
-                                for (int i = 0; i < asd; i++) {
-                                    // Initialize each element in the row
-                                    SymDefTable[i].SymbolFlags = readByteFile(tape);
-                                    tapebufByteCount += 1;
-                                    SymDefTable[i].PulseLenghts = new uint16_t[npd];
-                                    for(int j = 0; j < npd; j++) {
-                                        SymDefTable[i].PulseLenghts[j] = readByteFile(tape) | (readByteFile(tape) << 8);
-                                        tapebufByteCount += 2;
-                                    }
-
-                                }
-
-                                // printf("-----------------------\n");
-                                // printf("Data Sync Symbol Table\n");
-                                // printf("Asd: %d, Npd: %d\n",asd,npd);
-                                // printf("-----------------------\n");
-                                // for (int i = 0; i < asd; i++) {
-                                //     printf("%d: %d; ",i,(int)SymDefTable[i].SymbolFlags);
-                                //     for (int j = 0; j < npd; j++) {
-                                //         printf("%d,",(int)SymDefTable[i].PulseLenghts[j]);
-                                //     }
-                                //     printf("\n");
-                                // }
-                                // printf("-----------------------\n");
-
-                                // printf("END DATA SYMBOL TABLE GDB -> tapeCurByte: %d, Tape pos: %d, Tapebbc: %d\n", tapeCurByte,(int)(ftell(tape)),tapebufByteCount);
-
-                                curGDBSymbol = 0;
-                                curGDBPulse = 0;
-                                curBit = 7;
+        // More precision just for DRB and CSW. Makes some loaders work but bigger TAIL_LEN also does and seems better solution.
+        // if (tapePhase == TAPE_PHASE_DRB || tapePhase == TAPE_PHASE_CSW)
+            tapeStart = CPU::global_tstates + CPU::tstates - tapeCurrent;
+        // else
+        //     tapeStart = CPU::global_tstates + CPU::tstates;
 
-                                // Read data stream first symbol
-                                GDBsymbol = 0;
+    }
+}
 
-                                tapeCurByte = readByteFile(tape);
-                                tapebufByteCount += 1;
+// One transition of the phase machine: the current interval (tapeNext) has
+// elapsed, set the level that follows it and the length of the next one.
+IRAM_ATTR void Tape::Step() {
+    TapeFile* tape = &Tape::tape;
+
+    switch (tapePhase) {
+    case TAPE_PHASE_CSW:
+        tapeEarBit ^= 1;
+        if (CSW_CompressionType == 1) { // RLE
+            CSW_PulseLenght = readByteFile(tape);
+            tapebufByteCount++;                
+            if (tapebufByteCount == tapeBlockLen) {
+                tapeCurByte = CSW_PulseLenght;
+                if (tapeBlkPauseLen == 0) {
+                    tapeCurBlock++;
+                    GetBlock();
+                } else {
+                    tapePhase = TAPE_PHASE_TAIL;
+                    tapeNext  = TAPE_PHASE_TAIL_LEN;
+                }
+                break;
+            }
+            if (CSW_PulseLenght == 0) {
+                CSW_PulseLenght = readByteFile(tape) | (readByteFile(tape) << 8) | (readByteFile(tape) << 16) | (readByteFile(tape) << 24);
+                tapebufByteCount += 4;
+            }                
+            tapeNext = CSW_SampleRate * CSW_PulseLenght;
+        } else { // Z-RLE
+            CSW_PulseLenght = readByteFile(&cswBlock);
+            if (f_eof(&cswBlock)) {
+                f_close(&cswBlock);
+                tapeCurByte = readByteFile(tape);
+                if (tapeBlkPauseLen == 0) {
+                    tapeCurBlock++;
+                    GetBlock();
+                } else {
+                    tapePhase = TAPE_PHASE_TAIL;
+                    tapeNext  = TAPE_PHASE_TAIL_LEN;
+                }
+                break;
+            }
+            if (CSW_PulseLenght == 0) {
+                CSW_PulseLenght = readByteFile(&cswBlock) | (readByteFile(&cswBlock) << 8)
+                              | (readByteFile(&cswBlock) << 16) | (readByteFile(&cswBlock) << 24);
+            }                
+            tapeNext = CSW_SampleRate * CSW_PulseLenght;
+        }
+        break;
+    case TAPE_PHASE_GDB_PILOTSYNC:
 
-                                // printf("tapeCurByte: %d, nb:%d\n", (int)tapeCurByte,(int)nb);
-
-                                for (int i = nb; i > 0; i--) {
-                                    GDBsymbol <<= 1;
-                                    GDBsymbol |= ((tapeCurByte >> (curBit)) & 0x01);
-                                    if (curBit == 0) {
-                                        tapeCurByte = readByteFile(tape);
-                                        tapebufByteCount += 1;
-                                        curBit = 7;
-                                    } else
-                                        curBit--;
-                                }
-                                
-                                // Get symbol flags
-                                switch (SymDefTable[GDBsymbol].SymbolFlags) {
-                                case 0:
-                                    tapeEarBit ^= 1;
-                                    break;
-                                case 1:
-                                    break;                                    
-                                case 2:
-                                    tapeEarBit = 0;
-                                    break;
-                                case 3:
-                                    tapeEarBit = 1;
-                                    break;
-                                }
-
-                                // Get first pulse lenght from array of pulse lenghts
-                                tapeNext = SymDefTable[GDBsymbol].PulseLenghts[0];
-
-                                tapePhase = TAPE_PHASE_GDB_DATA;
-
-                                // printf("Curbit: %d, GDBSymbol: %d, Flags: %d, tapeNext: %d\n",(int)curBit,(int)GDBsymbol,(int)(SymDefTable[GDBsymbol].SymbolFlags & 0x3),(int)tapeNext);
-
-                            } else {
+        // Get next pulse lenght from current symbol
+        if (++curGDBPulse < npp)
+            tapeNext = SymDefTable[GDBsymbol].PulseLenghts[curGDBPulse];
 
-                                tapeCurByte = readByteFile(tape);
-                                tapeEarBit ^= 1;
-                                tapePhase=TAPE_PHASE_TAIL_GDB;
-                                tapeNext = TAPE_PHASE_TAIL_LEN_GDB;
+        if (tapeNext == 0 || curGDBPulse == npp) {
 
-                            }
+            // printf("curGDBPulse: %d, npp: %d\n",(int)curGDBPulse,(int)npp);
 
-                        }
+            // Next repetition
+            if (--tapeHdrPulses == 0) {
+                
+                // Get next symbol in PRLE
+                curGDBSymbol++;
 
-                    } else {
+                if (curGDBSymbol < totp) { // If not end of PRLE
 
-                        // Modify tapeearbit according to symbol flags
-                        switch (SymDefTable[GDBsymbol].SymbolFlags) {
-                            case 0:
-                                tapeEarBit ^= 1;
-                                break;
-                            case 1:
-                                break;                                    
-                            case 2:
-                                tapeEarBit = 0;
-                                break;
-                            case 3:
-                                tapeEarBit = 1;
-                                break;
-                        }
-
-                        tapeNext = SymDefTable[GDBsymbol].PulseLenghts[0];
-
-                        curGDBPulse = 0;
+                    // Read pulse data
+                    GDBsymbol = readByteFile(tape); // Read Symbol to be represented from PRLE
 
+                    // Get symbol flags
+                    switch (SymDefTable[GDBsymbol].SymbolFlags) {
+                        case 0:
+                            tapeEarBit ^= 1;
+                            break;
+                        case 1:
+                            break;                                    
+                        case 2:
+                            tapeEarBit = 0;
+                            break;
+                        case 3:
+                            tapeEarBit = 1;
+                            break;
                     }
 
-                } else {
-
-                    tapeEarBit ^= 1;
-
-                }
+                    // Get first pulse lenght from array of pulse lenghts
+                    tapeNext = SymDefTable[GDBsymbol].PulseLenghts[0];
 
-                break;
-            
-            case TAPE_PHASE_GDB_DATA:
+                    // Get number of repetitions from PRLE[0]
+                    tapeHdrPulses = readByteFile(tape) | (readByteFile(tape) << 8); // Number of repetitions of symbol
+                    
+                    curGDBPulse = 0;
 
-                // Get next pulse lenght from current symbol
-                if (++curGDBPulse < npd)
-                    tapeNext = SymDefTable[GDBsymbol].PulseLenghts[curGDBPulse];
+                    tapebufByteCount += 3;
 
-                if (curGDBPulse == npd || tapeNext == 0) {
+                } else {
+                    
+                    // End of PRLE
+
+                    // Free SymDefTable
+                    FreeSymDefTable();
+
+                    // End of pilotsync. Is there data stream ?
+                    if (totd > 0) {
+
+                        // printf("\nPULSES (DATA)\n");
+
+                        // Allocate memory for the array of pointers to struct Symdef
+                        SymDefTable = new Symdef[asd];
+                        SymDefTableSize = asd;
+
+                        // Allocate memory for each row
+                        for (int i = 0; i < asd; i++) {
+                            // Initialize each element in the row
+                            SymDefTable[i].SymbolFlags = readByteFile(tape);
+                            tapebufByteCount += 1;
+                            SymDefTable[i].PulseLenghts = new uint16_t[npd];
+                            for(int j = 0; j < npd; j++) {
+                                SymDefTable[i].PulseLenghts[j] = readByteFile(tape) | (readByteFile(tape) << 8);
+                                tapebufByteCount += 2;
+                            }
 
-                    // Get next symbol in data stream
-                    curGDBSymbol++;
+                        }
 
-                    if (curGDBSymbol < totd) { // If not end of data stream
+                        // printf("-----------------------\n");
+                        // printf("Data Sync Symbol Table\n");
+                        // printf("Asd: %d, Npd: %d\n",asd,npd);
+                        // printf("-----------------------\n");
+                        // for (int i = 0; i < asd; i++) {
+                        //     printf("%d: %d; ",i,(int)SymDefTable[i].SymbolFlags);
+                        //     for (int j = 0; j < npd; j++) {
+                        //         printf("%d,",(int)SymDefTable[i].PulseLenghts[j]);
+                        //     }
+                        //     printf("\n");
+                        // }
+                        // printf("-----------------------\n");
+
+                        // printf("END DATA SYMBOL TABLE GDB -> tapeCurByte: %d, Tape pos: %d, Tapebbc: %d\n", tapeCurByte,(int)(ftell(tape)),tapebufByteCount);
+
+                        curGDBSymbol = 0;
+                        curGDBPulse = 0;
+                        curBit = 7;
 
-                        // Read data stream next symbol
+                        // Read data stream first symbol
                         GDBsymbol = 0;
 
-                        // printf("tapeCurByte: %d, NB: %d, ", tapeCurByte,nb);
+                        tapeCurByte = readByteFile(tape);
+                        tapebufByteCount += 1;
+
+                        // printf("tapeCurByte: %d, nb:%d\n", (int)tapeCurByte,(int)nb);
 
                         for (int i = nb; i > 0; i--) {
                             GDBsymbol <<= 1;
@@ -1419,293 +1439,435 @@ IRAM_ATTR void Tape::Read() {
                             } else
                                 curBit--;
                         }
-
+                        
                         // Get symbol flags
                         switch (SymDefTable[GDBsymbol].SymbolFlags) {
-                            case 0:
-                                tapeEarBit ^= 1;
-                                break;
-                            case 1:
-                                break;                                    
-                            case 2:
-                                tapeEarBit = 0;
-                                break;
-                            case 3:
-                                tapeEarBit = 1;
-                                break;
+                        case 0:
+                            tapeEarBit ^= 1;
+                            break;
+                        case 1:
+                            break;                                    
+                        case 2:
+                            tapeEarBit = 0;
+                            break;
+                        case 3:
+                            tapeEarBit = 1;
+                            break;
                         }
 
                         // Get first pulse lenght from array of pulse lenghts
                         tapeNext = SymDefTable[GDBsymbol].PulseLenghts[0];
 
-                        curGDBPulse = 0;
+                        tapePhase = TAPE_PHASE_GDB_DATA;
+
+                        // printf("Curbit: %d, GDBSymbol: %d, Flags: %d, tapeNext: %d\n",(int)curBit,(int)GDBsymbol,(int)(SymDefTable[GDBsymbol].SymbolFlags & 0x3),(int)tapeNext);
 
                     } else {
 
-                        // Needed Adjustment
-                        tapebufByteCount--;
+                        tapeCurByte = readByteFile(tape);
+                        tapeEarBit ^= 1;
+                        tapePhase=TAPE_PHASE_TAIL_GDB;
+                        tapeNext = TAPE_PHASE_TAIL_LEN_GDB;
 
-                        // printf("END DATA GDB -> tapeCurByte: %d, Tape pos: %d, Tapebbc: %d, TapeBlockLen: %d\n", tapeCurByte,(int)(ftell(tape)),tapebufByteCount, tapeBlockLen);
-                        
-                        // Free SymDefTable
-                        FreeSymDefTable();
+                    }
 
-                        if (tapeBlkPauseLen == 0) {
-                            if (tapeCurByte == 0x13) tapeEarBit ^= 1; // This is needed for Basil, maybe for others (next block == Pulse sequence)
-                            // if (tapeCurByte != 0x19) tapeEarBit ^= 1; // This is needed for Basil, maybe for others (next block != GDB)
+                }
 
-                            GDBEnd = true; // Provisional: add special end to GDB data blocks with pause 0
+            } else {
 
-                            tapeCurBlock++;
-                            GetBlock();
+                // Modify tapeearbit according to symbol flags
+                switch (SymDefTable[GDBsymbol].SymbolFlags) {
+                    case 0:
+                        tapeEarBit ^= 1;
+                        break;
+                    case 1:
+                        break;                                    
+                    case 2:
+                        tapeEarBit = 0;
+                        break;
+                    case 3:
+                        tapeEarBit = 1;
+                        break;
+                }
 
-                        } else {
+                tapeNext = SymDefTable[GDBsymbol].PulseLenghts[0];
 
-                            GDBEnd = false; // Provisional: add special end to GDB data blocks with pause 0
+                curGDBPulse = 0;
 
-                            tapeEarBit ^= 1;
-                            tapePhase=TAPE_PHASE_TAIL_GDB;
-                            tapeNext = TAPE_PHASE_TAIL_LEN_GDB;
+            }
 
-                        }
+        } else {
 
-                    }
-                } else {
-                    tapeEarBit ^= 1;
-                }
-                break;
+            tapeEarBit ^= 1;
 
-            case TAPE_PHASE_TAIL_GDB:
-                tapeEarBit = 0;
-                tapePhase=TAPE_PHASE_PAUSE_GDB;
-                tapeNext=tapeBlkPauseLen;
-                break;
+        }
 
-            case TAPE_PHASE_PAUSE_GDB:
-                tapeEarBit = 1;
-                tapeCurBlock++;
-                GetBlock();
-                break;
+        break;
+    
+    case TAPE_PHASE_GDB_DATA:
 
-            case TAPE_PHASE_DRB:
-                tapeBitMask = (tapeBitMask >> 1) | (tapeBitMask << 7);
-                if (tapeBitMask == tapeEndBitMask) {
-                    tapeCurByte = readByteFile(tape);
-                    tapebufByteCount++;
-                    if (tapebufByteCount == tapeBlockLen) {
-                        if (tapeBlkPauseLen == 0) {
-                            tapeCurBlock++;
-                            GetBlock();
-                        } else {
-                            tapePhase=TAPE_PHASE_TAIL;
-                            tapeNext = TAPE_PHASE_TAIL_LEN;
-                        }
-                        break;
-                    } else if ((tapebufByteCount + 1) == tapeBlockLen) {
-                        if (tapeLastByteUsedBits < 8 )
-                            tapeEndBitMask >>= tapeLastByteUsedBits;
-                        else
-                            tapeEndBitMask = 0x80;                        
-                    } else {
-                        tapeEndBitMask = 0x80;
-                    }
-                    tapeEarBit = tapeCurByte & tapeBitMask ? 1 : 0;
-                } else {
-                    tapeEarBit = tapeCurByte & tapeBitMask ? 1 : 0;
-                }
-                break;
-            case TAPE_PHASE_SYNC:
-                tapeEarBit ^= 1;
-                if (--tapeHdrPulses == 0) {
-                    tapePhase=TAPE_PHASE_SYNC1;
-                    tapeNext=tapeSync1Len;
-                }
-                break;
-            case TAPE_PHASE_SYNC1:
-                tapeEarBit ^= 1;
-                tapePhase=TAPE_PHASE_SYNC2;
-                tapeNext=tapeSync2Len;
-                break;
-            case TAPE_PHASE_SYNC2:
-                if (tapebufByteCount == tapeBlockLen) { // This is for blocks with data lenght == 0
-                    if (tapeBlkPauseLen == 0) {
-                        tapeCurBlock++;
-                        GetBlock();
-                    } else {
-                        tapePhase=TAPE_PHASE_TAIL;
-                        tapeNext=TAPE_PHASE_TAIL_LEN;                        
-                    }
-                    break;
+        // Get next pulse lenght from current symbol
+        if (++curGDBPulse < npd)
+            tapeNext = SymDefTable[GDBsymbol].PulseLenghts[curGDBPulse];
+
+        if (curGDBPulse == npd || tapeNext == 0) {
+
+            // Get next symbol in data stream
+            curGDBSymbol++;
+
+            if (curGDBSymbol < totd) { // If not end of data stream
+
+                // Read data stream next symbol
+                GDBsymbol = 0;
+
+                // printf("tapeCurByte: %d, NB: %d, ", tapeCurByte,nb);
+
+                for (int i = nb; i > 0; i--) {
+                    GDBsymbol <<= 1;
+                    GDBsymbol |= ((tapeCurByte >> (curBit)) & 0x01);
+                    if (curBit == 0) {
+                        tapeCurByte = readByteFile(tape);
+                        tapebufByteCount += 1;
+                        curBit = 7;
+                    } else
+                        curBit--;
                 }
-                tapeEarBit ^= 1;
-                tapePhase=TAPE_PHASE_DATA1;
-                tapeNext = tapeCurByte & tapeBitMask ? tapeBit1PulseLen : tapeBit0PulseLen;
-                break;
-            case TAPE_PHASE_DATA1:
-                tapeEarBit ^= 1;
-                tapePhase=TAPE_PHASE_DATA2;
-                tapeNext = tapeCurByte & tapeBitMask ? tapeBit1PulseLen2 : tapeBit0PulseLen2;
-                break;
-            case TAPE_PHASE_DATA2:
-                tapeEarBit ^= 1;
-                tapeBitMask = tapeBitMask >>1 | tapeBitMask <<7;
-                if (tapeBitMask == tapeEndBitMask) {
-                    tapeCurByte = readByteFile(tape);                    
-                    tapebufByteCount++;
-                    if (tapebufByteCount == tapeBlockLen) {
-                        if (tapeBlkPauseLen == 0) {
-                            if (tapeFileType == TAPE_FTYPE_PZX && pzxTailLen > 0) {
-                                tapePhase = TAPE_PHASE_TAIL;
-                                tapeNext = pzxTailLen;
-                            } else {
-                                tapeCurBlock++;
-                                GetBlock();
-                            }
-                        } else {
-                            tapePhase=TAPE_PHASE_TAIL;
-                            tapeNext=TAPE_PHASE_TAIL_LEN;
-                        }
+
+                // Get symbol flags
+                switch (SymDefTable[GDBsymbol].SymbolFlags) {
+                    case 0:
+                        tapeEarBit ^= 1;
+                        break;
+                    case 1:
+                        break;                                    
+                    case 2:
+                        tapeEarBit = 0;
+                        break;
+                    case 3:
+                        tapeEarBit = 1;
                         break;
-                    } else if ((tapebufByteCount + 1) == tapeBlockLen) {
-                        if (tapeLastByteUsedBits < 8 )
-                            tapeEndBitMask >>= tapeLastByteUsedBits;
-                        else
-                            tapeEndBitMask = 0x80;                        
-                    } else {
-                        tapeEndBitMask = 0x80;
-                    }
                 }
-                tapePhase=TAPE_PHASE_DATA1;
-                tapeNext = tapeCurByte & tapeBitMask ? tapeBit1PulseLen : tapeBit0PulseLen;
-                break;
-            case TAPE_PHASE_PURETONE:
-                tapeEarBit ^= 1;
-                if (--tapeHdrPulses == 0) {
-                    tapeCurByte = readByteFile(tape);
+
+                // Get first pulse lenght from array of pulse lenghts
+                tapeNext = SymDefTable[GDBsymbol].PulseLenghts[0];
+
+                curGDBPulse = 0;
+
+            } else {
+
+                // Needed Adjustment
+                tapebufByteCount--;
+
+                // printf("END DATA GDB -> tapeCurByte: %d, Tape pos: %d, Tapebbc: %d, TapeBlockLen: %d\n", tapeCurByte,(int)(ftell(tape)),tapebufByteCount, tapeBlockLen);
+                
+                // Free SymDefTable
+                FreeSymDefTable();
+
+                if (tapeBlkPauseLen == 0) {
+                    if (tapeCurByte == 0x13) tapeEarBit ^= 1; // This is needed for Basil, maybe for others (next block == Pulse sequence)
+                    // if (tapeCurByte != 0x19) tapeEarBit ^= 1; // This is needed for Basil, maybe for others (next block != GDB)
+
+                    GDBEnd = true; // Provisional: add special end to GDB data blocks with pause 0
+
                     tapeCurBlock++;
                     GetBlock();
+
+                } else {
+
+                    GDBEnd = false; // Provisional: add special end to GDB data blocks with pause 0
+
+                    tapeEarBit ^= 1;
+                    tapePhase=TAPE_PHASE_TAIL_GDB;
+                    tapeNext = TAPE_PHASE_TAIL_LEN_GDB;
+
                 }
-                break;
-            case TAPE_PHASE_PULSESEQ:
-                tapeEarBit ^= 1;
-                if (--tapeHdrPulses == 0) {
-                    tapeCurByte = readByteFile(tape);
+
+            }
+        } else {
+            tapeEarBit ^= 1;
+        }
+        break;
+
+    case TAPE_PHASE_TAIL_GDB:
+        tapeEarBit = 0;
+        tapePhase=TAPE_PHASE_PAUSE_GDB;
+        tapeNext=tapeBlkPauseLen;
+        break;
+
+    case TAPE_PHASE_PAUSE_GDB:
+        tapeEarBit = 1;
+        tapeCurBlock++;
+        GetBlock();
+        break;
+
+    case TAPE_PHASE_DRB:
+        tapeBitMask = (tapeBitMask >> 1) | (tapeBitMask << 7);
+        if (tapeBitMask == tapeEndBitMask) {
+            tapeCurByte = readByteFile(tape);
+            tapebufByteCount++;
+            if (tapebufByteCount == tapeBlockLen) {
+                if (tapeBlkPauseLen == 0) {
                     tapeCurBlock++;
                     GetBlock();
                 } else {
-                    tapeNext=(readByteFile(tape) | (readByteFile(tape) << 8));
-                    tapebufByteCount += 2;
+                    tapePhase=TAPE_PHASE_TAIL;
+                    tapeNext = TAPE_PHASE_TAIL_LEN;
                 }
                 break;
-            case TAPE_PHASE_PZX_PULS:
-                tapeEarBit ^= 1;
-                pzxPulseRep--;
-                // Read next pulse entry when current one exhausted
-                while (pzxPulseRep == 0) {
-                    if ((uint32_t)f_tell(tape) >= pzxPulseBlockEnd) {
-                        // End of PULS block
+            } else if ((tapebufByteCount + 1) == tapeBlockLen) {
+                if (tapeLastByteUsedBits < 8 )
+                    tapeEndBitMask >>= tapeLastByteUsedBits;
+                else
+                    tapeEndBitMask = 0x80;                        
+            } else {
+                tapeEndBitMask = 0x80;
+            }
+            tapeEarBit = tapeCurByte & tapeBitMask ? 1 : 0;
+        } else {
+            tapeEarBit = tapeCurByte & tapeBitMask ? 1 : 0;
+        }
+        break;
+    case TAPE_PHASE_SYNC:
+        tapeEarBit ^= 1;
+        if (--tapeHdrPulses == 0) {
+            tapePhase=TAPE_PHASE_SYNC1;
+            tapeNext=tapeSync1Len;
+        }
+        break;
+    case TAPE_PHASE_SYNC1:
+        tapeEarBit ^= 1;
+        tapePhase=TAPE_PHASE_SYNC2;
+        tapeNext=tapeSync2Len;
+        break;
+    case TAPE_PHASE_SYNC2:
+        if (tapebufByteCount == tapeBlockLen) { // This is for blocks with data lenght == 0
+            if (tapeBlkPauseLen == 0) {
+                tapeCurBlock++;
+                GetBlock();
+            } else {
+                tapePhase=TAPE_PHASE_TAIL;
+                tapeNext=TAPE_PHASE_TAIL_LEN;                        
+            }
+            break;
+        }
+        tapeEarBit ^= 1;
+        tapePhase=TAPE_PHASE_DATA1;
+        tapeNext = tapeCurByte & tapeBitMask ? tapeBit1PulseLen : tapeBit0PulseLen;
+        break;
+    case TAPE_PHASE_DATA1:
+        tapeEarBit ^= 1;
+        tapePhase=TAPE_PHASE_DATA2;
+        tapeNext = tapeCurByte & tapeBitMask ? tapeBit1PulseLen2 : tapeBit0PulseLen2;
+        break;
+    case TAPE_PHASE_DATA2:
+        tapeEarBit ^= 1;
+        tapeBitMask = tapeBitMask >>1 | tapeBitMask <<7;
+        if (tapeBitMask == tapeEndBitMask) {
+            tapeCurByte = readByteFile(tape);                    
+            tapebufByteCount++;
+            if (tapebufByteCount == tapeBlockLen) {
+                if (tapeBlkPauseLen == 0) {
+                    if (tapeFileType == TAPE_FTYPE_PZX && pzxTailLen > 0) {
+                        tapePhase = TAPE_PHASE_TAIL;
+                        tapeNext = pzxTailLen;
+                    } else {
                         tapeCurBlock++;
                         GetBlock();
-                        goto pzx_puls_done;
-                    }
-                    // Decode next PULS entry
-                    uint16_t w;
-                    pzxPulseRep = 1;
-                    w = readByteFile(tape) | (readByteFile(tape) << 8);
-                    if (w > 0x8000) {
-                        pzxPulseRep = w & 0x7FFF;
-                        w = readByteFile(tape) | (readByteFile(tape) << 8);
-                    }
-                    if (w >= 0x8000) {
-                        pzxPulseDur = ((uint32_t)(w & 0x7FFF) << 16) | (readByteFile(tape) | (readByteFile(tape) << 8));
-                    } else {
-                        pzxPulseDur = w;
                     }
-                    if (pzxPulseDur == 0) {
-                        // Zero-duration: toggle for odd count, consume entry
-                        if (pzxPulseRep & 1) tapeEarBit ^= 1;
-                        pzxPulseRep = 0; // loop will read next entry
-                        continue;
-                    }
-                }
-                tapeNext = pzxPulseDur;
-                pzx_puls_done:
-                break;
-
-            case TAPE_PHASE_PZX_DATA: {
-                // Multi-pulse symbol playback for PZX DATA blocks
-                tapeEarBit ^= 1;
-                uint16_t* seq;
-                uint8_t pN;
-                // Determine which symbol we're in based on current bit
-                if (tapeCurByte & tapeBitMask) {
-                    seq = pzxS1; pN = pzxP1;
                 } else {
-                    seq = pzxS0; pN = pzxP0;
-                }
-                pzxCurSymPulse++;
-                if (pzxCurSymPulse < pN) {
-                    tapeNext = seq[pzxCurSymPulse];
-                } else {
-                    // Symbol complete, advance to next bit
-                    pzxBitCount--;
-                    if (pzxBitCount == 0) {
-                        // All bits done, output tail pulse
-                        if (pzxTailLen == 0) {
-                            tapeCurBlock++;
-                            GetBlock();
-                        } else {
-                            tapeEarBit ^= 1;
-                            tapePhase = TAPE_PHASE_TAIL;
-                            tapeBlkPauseLen = 0;
-                            tapeNext = pzxTailLen;
-                        }
-                        break;
-                    }
-                    // Next bit
-                    tapeBitMask >>= 1;
-                    if (tapeBitMask == 0) {
-                        tapeBitMask = 0x80;
-                        tapeCurByte = readByteFile(tape);
-                    }
-                    // Start new symbol
-                    if (tapeCurByte & tapeBitMask) {
-                        seq = pzxS1; pN = pzxP1;
-                    } else {
-                        seq = pzxS0; pN = pzxP0;
-                    }
-                    pzxCurSymPulse = 0;
-                    tapeNext = seq[0];
+                    tapePhase=TAPE_PHASE_TAIL;
+                    tapeNext=TAPE_PHASE_TAIL_LEN;
                 }
                 break;
+            } else if ((tapebufByteCount + 1) == tapeBlockLen) {
+                if (tapeLastByteUsedBits < 8 )
+                    tapeEndBitMask >>= tapeLastByteUsedBits;
+                else
+                    tapeEndBitMask = 0x80;                        
+            } else {
+                tapeEndBitMask = 0x80;
             }
-
-            case TAPE_PHASE_END:
-                tapeEarBit = 1;
-                tapeCurBlock = 0;
-                Stop();
-                f_lseek(tape, 0);
-                tapeNext = 0xFFFFFFFF;
-                break;
-            case TAPE_PHASE_TAIL:
-                tapeEarBit = 0;
-                tapePhase=TAPE_PHASE_PAUSE;
-                tapeNext=tapeBlkPauseLen;
-                break;
-            case TAPE_PHASE_PAUSE:
-                tapeEarBit = 1;
+        }
+        tapePhase=TAPE_PHASE_DATA1;
+        tapeNext = tapeCurByte & tapeBitMask ? tapeBit1PulseLen : tapeBit0PulseLen;
+        break;
+    case TAPE_PHASE_PURETONE:
+        tapeEarBit ^= 1;
+        if (--tapeHdrPulses == 0) {
+            tapeCurByte = readByteFile(tape);
+            tapeCurBlock++;
+            GetBlock();
+        }
+        break;
+    case TAPE_PHASE_PULSESEQ:
+        tapeEarBit ^= 1;
+        if (--tapeHdrPulses == 0) {
+            tapeCurByte = readByteFile(tape);
+            tapeCurBlock++;
+            GetBlock();
+        } else {
+            tapeNext=(readByteFile(tape) | (readByteFile(tape) << 8));
+            tapebufByteCount += 2;
+        }
+        break;
+    case TAPE_PHASE_PZX_PULS:
+        tapeEarBit ^= 1;
+        pzxPulseRep--;
+        // Read next pulse entry when current one exhausted
+        while (pzxPulseRep == 0) {
+            if ((uint32_t)f_tell(tape) >= pzxPulseBlockEnd) {
+                // End of PULS block
                 tapeCurBlock++;
                 GetBlock();
-            } 
-        } while (tapeCurrent >= tapeNext);
+                goto pzx_puls_done;
+            }
+            // Decode next PULS entry
+            uint16_t w;
+            pzxPulseRep = 1;
+            w = readByteFile(tape) | (readByteFile(tape) << 8);
+            if (w > 0x8000) {
+                pzxPulseRep = w & 0x7FFF;
+                w = readByteFile(tape) | (readByteFile(tape) << 8);
+            }
+            if (w >= 0x8000) {
+                pzxPulseDur = ((uint32_t)(w & 0x7FFF) << 16) | (readByteFile(tape) | (readByteFile(tape) << 8));
+            } else {
+                pzxPulseDur = w;
+            }
+            if (pzxPulseDur == 0) {
+                // Zero-duration: toggle for odd count, consume entry
+                if (pzxPulseRep & 1) tapeEarBit ^= 1;
+                pzxPulseRep = 0; // loop will read next entry
+                continue;
+            }
+        }
+        tapeNext = pzxPulseDur;
+        pzx_puls_done:
+        break;
+
+    case TAPE_PHASE_PZX_DATA: {
+        // Multi-pulse symbol playback for PZX DATA blocks
+        tapeEarBit ^= 1;
+        uint16_t* seq;
+        uint8_t pN;
+        // Determine which symbol we're in based on current bit
+        if (tapeCurByte & tapeBitMask) {
+            seq = pzxS1; pN = pzxP1;
+        } else {
+            seq = pzxS0; pN = pzxP0;
+        }
+        pzxCurSymPulse++;
+        if (pzxCurSymPulse < pN) {
+            tapeNext = seq[pzxCurSymPulse];
+        } else {
+            // Symbol complete, advance to next bit
+            pzxBitCount--;
+            if (pzxBitCount == 0) {
+                // All bits done, output tail pulse
+                if (pzxTailLen == 0) {
+                    tapeCurBlock++;
+                    GetBlock();
+                } else {
+                    tapeEarBit ^= 1;
+                    tapePhase = TAPE_PHASE_TAIL;
+                    tapeBlkPauseLen = 0;
+                    tapeNext = pzxTailLen;
+                }
+                break;
+            }
+            // Next bit
+            tapeBitMask >>= 1;
+            if (tapeBitMask == 0) {
+                tapeBitMask = 0x80;
+                tapeCurByte = readByteFile(tape);
+            }
+            // Start new symbol
+            if (tapeCurByte & tapeBitMask) {
+                seq = pzxS1; pN = pzxP1;
+            } else {
+                seq = pzxS0; pN = pzxP0;
+            }
+            pzxCurSymPulse = 0;
+            tapeNext = seq[0];
+        }
+        break;
+    }
 
-        // More precision just for DRB and CSW. Makes some loaders work but bigger TAIL_LEN also does and seems better solution.
-        // if (tapePhase == TAPE_PHASE_DRB || tapePhase == TAPE_PHASE_CSW)
-            tapeStart = CPU::global_tstates + CPU::tstates - tapeCurrent;
-        // else
-        //     tapeStart = CPU::global_tstates + CPU::tstates;
+    case TAPE_PHASE_END:
+        tapeEarBit = 1;
+        tapeCurBlock = 0;
+        Stop();
+        f_lseek(tape, 0);
+        tapeNext = 0xFFFFFFFF;
+        break;
+    case TAPE_PHASE_TAIL:
+        tapeEarBit = 0;
+        tapePhase=TAPE_PHASE_PAUSE;
+        tapeNext=tapeBlkPauseLen;
+        break;
+    case TAPE_PHASE_PAUSE:
+        tapeEarBit = 1;
+        tapeCurBlock++;
+        GetBlock();
+    }
+}
 
+// True when the next Step() stays inside the current block: no GetBlock(),
+// no Stop() and no TAIL/PAUSE/END phase. Those steps change state that
+// TapePortRead() and FlashLoad() look at (tapeCurBlock, tapePhase), so they
+// only run from Read() once the loader has actually heard every edge before.
+// GDB blocks are rare enough to always take the synchronous path.
+bool Tape::EdgeStreamable() {
+    switch (tapePhase) {
+    case TAPE_PHASE_SYNC:
+    case TAPE_PHASE_SYNC1:
+    case TAPE_PHASE_DATA1:
+        return true;
+    case TAPE_PHASE_SYNC2:
+        return tapebufByteCount != tapeBlockLen;
+    case TAPE_PHASE_DATA2:
+    case TAPE_PHASE_DRB:
+        return (uint8_t)(tapeBitMask >> 1 | tapeBitMask << 7) != tapeEndBitMask ||
+               tapebufByteCount + 1 != tapeBlockLen;
+    case TAPE_PHASE_PURETONE:
+    case TAPE_PHASE_PULSESEQ:
+        return tapeHdrPulses > 1;
+    case TAPE_PHASE_CSW:
+        if (CSW_CompressionType == 1) return tapebufByteCount + 1 != tapeBlockLen;
+        return cswBlock.fptr + 1 < cswBlock.obj.objsize;
+    case TAPE_PHASE_PZX_PULS:
+        return pzxPulseRep > 1;
+    case TAPE_PHASE_PZX_DATA:
+        return pzxBitCount > 1 ||
+               pzxCurSymPulse + 1 < (tapeCurByte & tapeBitMask ? pzxP1 : pzxP0);
     }
+    return false;
+}
+
+// Producer side of the edge list: run the phase machine ahead of the loader
+// and queue (T-states, level) pairs until the ring is full or a block
+// boundary comes up. Called from Read() when the ring runs dry and once per
+// frame from the main loop, so file reads mostly happen outside port reads.
+void Tape::Compile() {
+    if (tapeStatus != TAPE_LOADING) return;
+    if (tapeFileType != TAPE_FTYPE_TAP && tapeFileType != TAPE_FTYPE_TZX && tapeFileType != TAPE_FTYPE_PZX) return;
+
+    // Step() drives tapeEarBit; swap in the level at the tail of the ring
+    uint8_t earBit = tapeEarBit;
+    if (edgeHead == edgeTail) edgeLevel = earBit;
+    tapeEarBit = edgeLevel;
+
+    uint16_t tail = edgeTail;
+    while (((tail + 1) & (TAPE_EDGE_RING - 1)) != edgeHead && EdgeStreamable()) {
+        uint32_t dt = tapeNext;
+        Step();
+        tapeEdges[tail] = (dt & TAPE_EDGE_DT) | ((uint32_t)tapeEarBit << 31);
+        tail = (tail + 1) & (TAPE_EDGE_RING - 1);
+    }
+    edgeTail = tail;
+
+    edgeLevel = tapeEarBit;
+    tapeEarBit = earBit;
 }
 
 void Tape::Save() {
@@ -1753,12 +1915,13 @@ bool Tape::FlashLoad() {
     if (Z80Ops::isALF) { // unsupported now
         return false;
     }
+    VIDEO::dirtyAll(); // the block goes straight into RAM, maybe onto the screen
 
     if (tapeFileType == TAPE_FTYPE_TZX) {
         // TZX flash load: supported for 0x10 (Standard) and 0x14 (Pure Data) blocks.
         // Skip metadata/non-data blocks (archive info, text, group markers, pure tone,
         // pulse sequence, etc.) to find the next loadable block.
-        FIL* tape = &Tape::tape;
+        TapeFile* tape = &Tape::tape;
         uint8_t foundId = 0;
         while (tapeCurBlock < tapeNumBlocks) {
             CalcTZXBlockPos(tapeCurBlock);
@@ -1867,7 +2030,7 @@ bool Tape::FlashLoad() {
     }
 
     if (tapeFileType == TAPE_FTYPE_PZX) {
-        FIL* tape = &Tape::tape;
+        TapeFile* tape = &Tape::tape;
         int savedBlock = tapeCurBlock;
         FSIZE_t savedPos = f_tell(tape);
         // Skip non-DATA blocks to find next DATA block
@@ -2052,7 +2215,7 @@ bool Tape::FlashLoad() {
     CalcTapBlockPos(tapeCurBlock);
 
     // printf("--< BLOCK: %d >--------------------------------\n",(int)tapeCurBlock);
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     uint16_t blockLen=(readByteFile(tape) | (readByteFile(tape) <<8));
     uint8_t tapeFlag = readByteFile(tape);
 
@@ -2169,7 +2332,7 @@ bool Tape::FlashLoad() {
 // We read the TAP block, apply the same decryption, and write directly to (IX).
 bool Tape::CerikopikFlashLoad() {
 
-    FIL* tp = &Tape::tape;
+    TapeFile* tp = &Tape::tape;
     uint16_t blockLen;
     uint8_t tapeFlag;
 
@@ -2267,7 +2430,7 @@ static const uint32_t JJ_TSTATES_PER_GROUP = 205128 >> 2;
 
 int Tape::JJFlashLoad() {
 
-    FIL* tp = &Tape::tape;
+    TapeFile* tp = &Tape::tape;
 
     if (tapeFileType != TAPE_FTYPE_TZX) return 0;
 
@@ -2385,6 +2548,74 @@ int Tape::JJFlashLoad() {
     }
 }
 
+// Generic turbo for custom loaders: an edge-polling loop is IN from port FE
+// at the same PC every L T-states where nothing but B (the timing counter,
+// +1 or -1 per pass or untouched) and R changes and the EAR level stays put.
+// Once that pattern holds for TURBO_HITS passes, jump straight to the last
+// pass before the next tape edge: advance the clock (through VIDEO::Draw, so
+// the screen keeps up), B and R by the skipped passes and let the loader
+// read the edge itself. B never wraps and the clock stays inside the frame,
+// so timeouts and interrupts happen exactly as in real time.
+#define TURBO_HITS 8
+#define TURBO_MAX_LOOP 256
+
+void Tape::TurboSkip(uint16_t pc) {
+    static uint16_t lastPC;
+    static uint64_t lastT;
+    static uint32_t lastLoop;
+    static uint8_t lastB, lastR, lastRStep, lastEar, hits;
+    static int8_t lastDir;
+    static uint16_t lastC, lastDE, lastHL, lastSP;
+
+    if (tapeFileType != TAPE_FTYPE_TAP && tapeFileType != TAPE_FTYPE_TZX && tapeFileType != TAPE_FTYPE_PZX) return;
+
+    uint64_t now = CPU::global_tstates + CPU::tstates;
+    uint32_t loop = (uint32_t)(now - lastT);
+    uint8_t b = Z80::getRegB();
+    uint8_t r = Z80::getRegR();
+    int8_t dir = (int8_t)(b - lastB);
+    uint8_t rStep = (r - lastR) & 0x7F;
+
+    bool same = pc == lastPC && loop == lastLoop && loop && loop <= TURBO_MAX_LOOP &&
+        dir == lastDir && dir >= -1 && dir <= 1 && rStep == lastRStep &&
+        tapeEarBit == lastEar && Z80::getRegC() == lastC &&
+        Z80::getRegDE() == lastDE && Z80::getRegHL() == lastHL && Z80::getRegSP() == lastSP;
+    hits = same ? (hits < TURBO_HITS ? hits + 1 : hits) : 0;
+
+    lastPC = pc; lastT = now; lastLoop = loop;
+    lastB = b; lastR = r; lastDir = dir; lastRStep = rStep; lastEar = tapeEarBit;
+    lastC = Z80::getRegC(); lastDE = Z80::getRegDE(); lastHL = Z80::getRegHL(); lastSP = Z80::getRegSP();
+
+    if (hits < TURBO_HITS) return;
+
+    // T-states to the next edge, as Read() would see it
+    uint64_t elapsed = now - tapeStart;
+    uint32_t due = edgeHead != edgeTail ? tapeEdges[edgeHead] & TAPE_EDGE_DT : tapeNext;
+    if (elapsed >= due) return;
+    uint32_t n = (uint32_t)(due - elapsed) / loop;
+
+    // passes left before the counter runs out
+    if (dir > 0) n = min<uint32_t>(n, 0xFF - b);
+    else if (dir < 0) n = min<uint32_t>(n, (b - 1) & 0xFF);
+    if (CPU::tstates >= CPU::statesInFrame) return;
+    n = min<uint32_t>(n, (CPU::statesInFrame - CPU::tstates) / loop);
+    if (n < 2) return;
+    n--;
+
+    uint32_t skip = n * loop;
+    while (skip) {
+        uint32_t st = skip < VIDEO::tStatesPerLine ? skip : VIDEO::tStatesPerLine;
+        VIDEO::Draw(st, false);
+        skip -= st;
+    }
+    Z80::setRegB(b + dir * (int)n);
+    Z80::incRegR((n * rStep) & 0x7F);
+
+    lastT = CPU::global_tstates + CPU::tstates;
+    lastB = Z80::getRegB();
+    lastR = Z80::getRegR();
+}
+
 // Called from port 0xFE read handler. Handles all tape-related logic:
 // - Cerikopik FlashLoad detection (PC >= 0xFE00, Byte ROM)
 // - Jumping Jack variant detection (different signature at 0xFE00)
@@ -2514,6 +2745,7 @@ bool Tape::TapePortRead() {
             return false;
         }
         loopPC = 0; loopCount = 0;
+        if (Config::flashload) TurboSkip(pc);
         Read();
         // If tape advanced into a turbo pilot block (PureTone) while non-turbo
         // code is running: stop the tape. Turbo autostart will resume Play()
@@ -2543,6 +2775,7 @@ bool Tape::TapePortRead() {
                 if (++loopCount > 200) {
                     loopCount = 0;
                     pzxFlashCont = false;
+                    FlushEdges();
                     tapeStatus = TAPE_LOADING;
                     tapeStart = CPU::global_tstates + CPU::tstates;
                     Read();
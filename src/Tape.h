@@ -114,6 +114,66 @@ using namespace std;
 
 #define TAPE_LISTING_DIV 16
 
+// Tape read window: two sector-aligned halves, the cursor half plus one read ahead
+#if PICO_RP2040
+#define TAPE_BUF_HALF 2048
+#else
+#define TAPE_BUF_HALF 4096
+#endif
+#define CSW_BUF_HALF 512
+
+// Compiled edge list: T-states until the edge in the low 31 bits, the EAR
+// level after it in bit 31. Power of two.
+#if PICO_RP2040
+#define TAPE_EDGE_RING 128
+#else
+#define TAPE_EDGE_RING 512
+#endif
+#define TAPE_EDGE_DT 0x7FFFFFFFUL
+
+// Buffered read stream over a tape image. The pulse generators pull the file
+// a byte (WAV: a sample) at a time; a 1-byte f_read per call costs a FatFs
+// round trip each, so reads are served from an aligned window instead and
+// seeks inside it are free. fptr is the logical position and obj aliases the
+// FIL's, so the f_tell()/f_size()/f_eof() macros work on it unchanged.
+class TapeFile {
+public:
+    TapeFile(uint8_t* window, UINT halfSize) : buf(window), half(halfSize) {}
+
+    FIL fil;
+    FFOBJID& obj = fil.obj;
+    FSIZE_t fptr = 0;
+
+    inline uint8_t get() {
+        if ((FSIZE_t)(fptr - base) >= len && !fill()) return 0xFF;
+        return buf[fptr++ - base];
+    }
+    UINT read(void* dst, UINT n);
+    void prefetch();    // slide the window ahead of the cursor (once per frame)
+    void reset();
+
+private:
+    bool fill();
+    uint8_t* const buf;
+    const UINT half;    // power of two, multiple of the sector size
+    FSIZE_t base = 0;   // file offset of buf[0]
+    UINT len = 0;       // valid bytes in buf
+};
+
+FRESULT f_open(TapeFile* fp, const TCHAR* path, BYTE mode);
+FRESULT f_close(TapeFile* fp);
+FRESULT f_read(TapeFile* fp, void* buff, UINT btr, UINT* br);
+
+static inline FRESULT f_lseek(TapeFile* fp, FSIZE_t ofs) {
+    if (!fp->obj.fs) return FR_INVALID_OBJECT;
+    fp->fptr = ofs > fp->obj.objsize ? fp->obj.objsize : ofs;
+    return FR_OK;
+}
+
+static inline uint8_t readByteFile(TapeFile* f) {
+    return f->get();
+}
+
 #define CHUNK_SIZE 1024
 struct TZXBlock {
     uint8_t BlockType;   
@@ -186,8 +246,8 @@ public:
     static wav_t wav;
     static uint32_t wav_offset;
     static uint32_t mp3_read;
-    static FIL tape;
-    static FIL cswBlock;    
+    static TapeFile tape;
+    static TapeFile cswBlock;
     static string tapeFileName;
     static string tapeSaveName;
     static int tapeFileType;
@@ -216,6 +276,8 @@ public:
     static int JJFlashLoad(); // 0=not applicable, 1=in progress, 2=done
     static bool jjScreenAnimating; // true while JJ screen animation in progress
     static bool TapePortRead();
+    static void Compile();
+    static void FlushEdges() { edgeHead = edgeTail = 0; }
     static void Save();
     static void FreeSymDefTable();
 
@@ -247,6 +309,16 @@ private:
 
     static int inflateCSW(int blocknumber, long startPos, long data_length);
 
+    static void Step();
+    static bool EdgeStreamable();
+    static void TurboSkip(uint16_t pc);
+
+    // Edge list between Compile() (producer) and Read() (consumer)
+    static uint32_t tapeEdges[TAPE_EDGE_RING];
+    static uint16_t edgeHead;
+    static uint16_t edgeTail;
+    static uint8_t edgeLevel; // level after the last queued edge
+
     // Tape timing values
     static uint16_t tapeSyncLen;
     static uint16_t tapeSync1Len;
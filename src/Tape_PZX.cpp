@@ -48,16 +48,28 @@ using namespace std;
 #include "Debug.h"
 #include "Z80_JLS/z80.h"
 
-int fseek (FIL* stream, long offset, int origin);
-inline static void fclose(FIL& stream) {
+inline static int fseek(TapeFile* stream, long offset, int origin) {
+    if ( origin == SEEK_CUR ) {
+        return FR_OK != f_lseek(stream, f_tell(stream) + offset);
+    }
+    if ( origin == SEEK_END ) {
+        return FR_OK != f_lseek(stream, f_size(stream) + offset);
+    }
+    return FR_OK != f_lseek(stream, offset);
+}
+inline static void fclose(TapeFile& stream) {
     f_close(&stream);
 }
 #define ftell(x) f_tell(&x)
 #define feof(x) f_eof(&x)
-inline void rewind(FIL& f) {
+inline void rewind(TapeFile& f) {
     f_lseek(&f, 0);
 }
-size_t fread(uint8_t* v, size_t sz1, size_t sz2, FIL& f);
+inline static size_t fread(uint8_t* v, size_t sz1, size_t sz2, TapeFile& f) {
+    UINT br;
+    if (f_read(&f, v, sz1 * sz2, &br) != FR_OK) return -1;
+    return sz2;
+}
 
 // PZX block tags (4 ASCII bytes, little-endian)
 enum PZXTag : uint32_t {
@@ -85,7 +97,7 @@ bool Tape::pzxFlashCont = false;
 
 // Read PZX block tag and size, leaves file position after the size field
 void Tape::PZX_BlockLen(uint32_t &tag, uint32_t &size) {
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     tag = readByteFile(tape) | (readByteFile(tape) << 8) |
           (readByteFile(tape) << 16) | (readByteFile(tape) << 24);
     size = readByteFile(tape) | (readByteFile(tape) << 8) |
@@ -126,7 +138,7 @@ void Tape::PZX_Open(const string& name) {
     }
 
     // Check version
-    FIL* tp = &tape;
+    TapeFile* tp = &tape;
     uint8_t major = readByteFile(tp);
     if (major > 1) {
         OSD::osdCenteredMsg("Unsupported PZX version", LEVEL_ERROR);
@@ -177,7 +189,7 @@ uint32_t Tape::CalcPZXBlockPos(int block) {
     int TapeBlockRest = block & (TAPE_LISTING_DIV - 1);
     int CurrentPos = TapeListing[block / TAPE_LISTING_DIV].StartPosition;
 
-    FIL* tp = &tape;
+    TapeFile* tp = &tape;
     fseek(tp, CurrentPos, SEEK_SET);
 
     while (TapeBlockRest-- != 0) {
@@ -191,7 +203,7 @@ uint32_t Tape::CalcPZXBlockPos(int block) {
 }
 
 void Tape::PZX_GetBlock() {
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
 
     // Always seek to correct block position (PZX blocks are self-contained,
     // unlike TZX which chains via tapeCurByte)
@@ -389,7 +401,7 @@ string Tape::pzxBlockReadData(int Blocknum) {
 
     CalcPZXBlockPos(Blocknum);
 
-    FIL* tp = &tape;
+    TapeFile* tp = &tape;
     uint32_t tag, size;
     PZX_BlockLen(tag, size);
 
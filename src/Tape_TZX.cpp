@@ -47,21 +47,33 @@ using namespace std;
 #include "messages.h"
 #include "Z80_JLS/z80.h"
 
-int fseek (FIL* stream, long offset, int origin);
-inline static void fclose(FIL& stream) {
+inline static int fseek(TapeFile* stream, long offset, int origin) {
+    if ( origin == SEEK_CUR ) {
+        return FR_OK != f_lseek(stream, f_tell(stream) + offset);
+    }
+    if ( origin == SEEK_END ) {
+        return FR_OK != f_lseek(stream, f_size(stream) + offset);
+    }
+    return FR_OK != f_lseek(stream, offset);
+}
+inline static void fclose(TapeFile& stream) {
     f_close(&stream);
 }
 #define ftell(x) f_tell(&x)
 #define feof(x) f_eof(&x)
-inline void rewind(FIL& f) {
+inline void rewind(TapeFile& f) {
     f_lseek(&f, 0);
 }
-size_t fread(uint8_t* v, size_t sz1, size_t sz2, FIL& f);
+inline static size_t fread(uint8_t* v, size_t sz1, size_t sz2, TapeFile& f) {
+    UINT br;
+    if (f_read(&f, v, sz1 * sz2, &br) != FR_OK) return -1;
+    return sz2;
+}
 
 void Tape::TZX_BlockLen(TZXBlock &blockdata) {
 
     uint32_t tapeBlkLen;
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     uint8_t tzx_blk_type = readByteFile(tape);
 
     switch (tzx_blk_type) {
@@ -447,7 +459,7 @@ void Tape::TZX_Open(const string& name) {
 
     tapeFileName = name;
 
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     fseek(tape, 2, SEEK_CUR); // Jump TZX version bytes
     // printf("TZX version: %d.%d\n",(int)readByteFile(tape),(int)readByteFile(tape));
 
@@ -532,7 +544,7 @@ void Tape::TZX_GetBlock() {
     int tapeData;
     short jumpDistance;
     char cswFileName[16]; // Nombre del archivo descomprimido    
-    FIL* tape = &Tape::tape;
+    TapeFile* tape = &Tape::tape;
     for (;;) {
         if (tapeCurBlock >= tapeNumBlocks) {
             if (GDBEnd) {
@@ -39,19 +39,38 @@ static inline void initAluBytes() {
         AluByte[n] = (unsigned int*)AluBytesStd_flash[n];
 }
 
-#if PICO_RP2040
-// RP2040: SRAM lookup tables replace 16KB flash AluByte.
-// Precomputed splat arrays eliminate runtime multiplications in computePixels.
+// Word-parallel pixel generation for the standard palette (line renderer):
+// 4 pixels at a time, ink or paper picked per byte by a nibble mask, with no
+// AluByte (flash) lookups. Byte order within the word follows AluByte.
 // Defined once in Video.cpp, declared extern here.
 extern uint32_t attrPaperSplat[256]; // paper * 0x01010101
 extern uint32_t attrDiffSplat[256];  // (ink ^ paper) * 0x01010101
 extern uint32_t nibbleMask[16];
 void initInkPaper();
 
+// 8 pixels of bitmap byte bmp under attribute att (flash already applied)
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+// Cortex-M33: spread the byte over the word, keep one pixel bit per byte lane
+// and let USUB8 flag the clear lanes for SEL. No mask table.
 static inline __attribute__((always_inline))
-uint32_t computePixels(uint8_t nibble, uint8_t att) {
-    return attrPaperSplat[att] ^ (nibbleMask[nibble] & attrDiffSplat[att]);
+void computePixels(uint32_t* dst, uint8_t bmp, uint8_t att) {
+    uint32_t paper = attrPaperSplat[att];
+    uint32_t ink = paper ^ attrDiffSplat[att];
+    uint32_t spread = bmp * 0x01010101u;
+    __usub8(0, spread & 0x40801020u); // pixels 0-3: GE set where clear
+    dst[0] = __sel(paper, ink);
+    __usub8(0, spread & 0x04080102u); // pixels 4-7
+    dst[1] = __sel(paper, ink);
 }
-#endif // PICO_RP2040
+#else
+static inline __attribute__((always_inline))
+void computePixels(uint32_t* dst, uint8_t bmp, uint8_t att) {
+    uint32_t paper = attrPaperSplat[att];
+    uint32_t diff = attrDiffSplat[att];
+    dst[0] = paper ^ (nibbleMask[bmp >> 4] & diff);
+    dst[1] = paper ^ (nibbleMask[bmp & 0xF] & diff);
+}
+#endif
 
 #endif // VIDPRECALC_h
@@ -47,6 +47,8 @@ visit https://zxespectrum.speccy.org/contacto
 #include "Z80_JLS/z80.h"
 #include "Z80_JLS/z80operations.h"
 #include "psram_spi.h"
+#include "hardware/sync.h"
+#include "Profiler.h"
 #if !PICO_RP2040
 #include "Z80DMA.h"
 #endif
@@ -111,6 +113,9 @@ uint8_t VIDEO::tStatesPerLine;
 int VIDEO::tStatesScreen;
 int VIDEO::tStatesBorder;
 uint8_t* VIDEO::grmem;
+bool VIDEO::line_ahead = false;
+uint32_t VIDEO::line_bmp;
+uint32_t VIDEO::line_att;
 uint16_t VIDEO::offBmp[SPEC_H];
 uint16_t VIDEO::offAtt[SPEC_H];
 SaveRectT VIDEO::SaveRect;
@@ -183,14 +188,26 @@ const uint8_t* VIDEO::mode16col_planes[4] = { nullptr, nullptr, nullptr, nullptr
 
 #ifdef DIRTY_LINES
 uint8_t VIDEO::dirty_lines[SPEC_H];
-// uint8_t VIDEO::linecalc[SPEC_H];
+static bool line_dirty; // current paper line has to be drawn
+
+// Flash phase flipped: only character rows with a FLASH attribute change
+void VIDEO::dirtyFlash() {
+    for (int row = 0; row < 24; row++) {
+        const uint8_t* att = grmem + 6144 + (row << 5);
+        for (int i = 0; i < 32; i++) {
+            if (att[i] & 0x80) {
+                memset(dirty_lines + (row << 3), 1, 8);
+                break;
+            }
+        }
+    }
+}
 #endif //  DIRTY_LINES
 static unsigned int is169;
 static unsigned int isFullBorder;
 static unsigned int lineptr_offset; // uint32_t offset for screen start in line buffer
 
 static uint32_t* lineptr32;
-static uint16_t* prevLineptr16; // 4-bit packed: 1 uint16 = 4 pixels
 
 static unsigned int tstateDraw; // Drawing start point (in Tstates)
 static unsigned int linedraw_cnt;
@@ -210,6 +227,7 @@ static unsigned int attOffset;  // offset for attrib in graphic memory
 #if !PICO_RP2040
 // Per-scanline DMA attr shadow: non-null when DMA wrote attrs for current scanline
 static const uint8_t* dma_attr_override = nullptr;
+static bool line_giga; // current paper line goes to the gigascreen pass
 #endif
 
 static const uint8_t wait_st[128] = {
@@ -667,6 +685,7 @@ void VIDEO::regenerateUlaPlusAluBytes() {
     // fixed mapping that depends only on attribute format, not palette contents)
     for (int n = 0; n < 16; n++)
         AluByte[n] = (unsigned int*)AluBytesUlaPlus_flash[n];
+    line_ahead = false;
 
     graphics_set_dither(Config::hdmi_dither);
 }
@@ -718,6 +737,7 @@ void VIDEO::ulaPlusDisable() {
 
     for (int n = 0; n < 16; n++)
         AluByte[n] = (unsigned int*)AluBytesStd_flash[n];
+    line_ahead = false;
     brd = border32[borderColor];
     brdChange = true;
 }
@@ -937,6 +957,7 @@ void VIDEO::Init() {
 
     // Generate AluBytes table with palette indices (no sync bits)
     initAluBytes();
+    initInkPaper();
 
 #if !PICO_RP2040
     // Precompute 16col byte->2-pixel LUT (used by 16col rasterizer hot loop)
@@ -1237,10 +1258,7 @@ void VIDEO::Reset() {
 
     grmem = MemESP::videoLatch ? MemESP::ram[7].direct() : MemESP::ram[5].direct();
 
-    #ifdef DIRTY_LINES
-    // for (int i=0; i < SPEC_H; i++) VIDEO::dirty_lines[i] = 0x01;
-    memset((uint8_t *)VIDEO::dirty_lines,0x01,SPEC_H);
-    #endif // DIRTY_LINES
+    dirtyAll();
 
     VIDEO::snow_toggle = Config::arch != "P1024" && Config::arch != "P512" && Config::arch != "Pentagon" ? Config::render : false;
 
@@ -1348,6 +1366,47 @@ void VIDEO::InitPrevBuffer() {
 }
 #endif
 
+uint32_t attrPaperSplat[256];
+uint32_t attrDiffSplat[256];
+uint32_t nibbleMask[16];
+
+void initInkPaper() {
+    for (int a = 0; a < 256; a++) {
+        uint32_t bright = (a >> 3) & 0x08;
+        uint32_t ink = (a & 0x07) | bright;
+        uint32_t paper = ((a >> 3) & 0x07) | bright;
+        attrPaperSplat[a] = paper * 0x01010101;
+        attrDiffSplat[a] = (ink ^ paper) * 0x01010101;
+    }
+    // Nibble bits 3,2,1,0 land in bytes 2,3,0,1 (AluByte order)
+    for (int n = 0; n < 16; n++)
+        nibbleMask[n] = (n & 8 ? 0x00FF0000 : 0) | (n & 4 ? 0xFF000000 : 0)
+                      | (n & 2 ? 0x000000FF : 0) | (n & 1 ? 0x0000FF00 : 0);
+}
+
+// Whole paper line for line_ahead, at the offsets MainScreen_Blank set up
+IRAM_ATTR static void drawLine() {
+    const uint8_t* bmp = VIDEO::grmem + bmpOffset;
+    const uint8_t* att = VIDEO::grmem + attOffset;
+    const uint8_t flash = VIDEO::flashing;
+    uint32_t* dst = lineptr32;
+#if !PICO_RP2040
+    if (VIDEO::ulaplus_enabled) {
+        for (int i = 0; i < 32; i++, dst += 2) {
+            uint8_t a = att[i];
+            uint8_t b = bmp[i] ^ (-((a & flash) >> 7));
+            dst[0] = AluByte[b >> 4][a];
+            dst[1] = AluByte[b & 0xF][a];
+        }
+        return;
+    }
+#endif
+    for (int i = 0; i < 32; i++, dst += 2) {
+        uint8_t a = att[i];
+        computePixels(dst, bmp[i] ^ (-((a & flash) >> 7)), a);
+    }
+}
+
 //  VIDEO DRAW FUNCTIONS
 IRAM_ATTR void VIDEO::MainScreen_Blank(unsigned int statestoadd, bool contended) {    
     
@@ -1358,7 +1417,6 @@ IRAM_ATTR void VIDEO::MainScreen_Blank(unsigned int statestoadd, bool contended)
         if (brdChange) DrawBorder(); // Needed to avoid tearing in demos like Gabba (Pentagon)
         
         lineptr32 = (uint32_t *)(vga.frameBuffer[linedraw_cnt]) + lineptr_offset;
-        prevLineptr16 = (uint16_t *)(vga.prevFrameBuffer[linedraw_cnt]) + lineptr_offset;
 
         coldraw_cnt = 0;
 
@@ -1390,10 +1448,6 @@ IRAM_ATTR void VIDEO::MainScreen_Blank(unsigned int statestoadd, bool contended)
             attOffset = offAtt[curline];
         }
 
-        #ifdef DIRTY_LINES
-        // Force line draw (for testing)
-        // dirty_lines[curline] = 1;
-        #endif // DIRTY_LINES
 
 #if !PICO_RP2040
         // DMA per-scanline attr shadow: use snapshot if DMA wrote attrs for this scanline
@@ -1406,6 +1460,41 @@ IRAM_ATTR void VIDEO::MainScreen_Blank(unsigned int statestoadd, bool contended)
         Draw = linedraw_cnt >= 176 && linedraw_cnt <= 191 ? Draw_OSD169 : MainScreen;
         Draw_Opcode = MainScreen_Opcode;
 
+#ifdef DIRTY_LINES
+        // Gigascreen blends with the previous frame, DMA attrs are per frame:
+        // neither can be skipped
+        line_dirty = dirty_lines[curline] || gigascreen_enabled
+#if !PICO_RP2040
+            || dma_attr_override
+#endif
+            ;
+        if (Draw == MainScreen) dirty_lines[curline] = 0;
+#endif
+
+        // No raster effect so far: draw the whole line now, MainScreen only
+        // has to keep count unless the line gets written during its scan
+        line_ahead = Draw == MainScreen
+#if !PICO_RP2040
+            && !dma_attr_override && !mode16col_enabled
+            && !(Config::timex_video && timex_mode == 6)
+#endif
+            ;
+#if !PICO_RP2040
+        line_giga = gigascreen_enabled && Draw == MainScreen && !mode16col_enabled
+            && !(Config::timex_video && timex_mode == 6);
+#endif
+        if (line_ahead) {
+            line_bmp = bmpOffset;
+            line_att = attOffset;
+#ifdef DIRTY_LINES
+            if (line_dirty)
+#endif
+            {
+                uint32_t prof = Profiler::begin();
+                drawLine();
+                Profiler::end(PROF_VID, prof);
+            }
+        }
 
         video_rest = CPU::tstates - tstateDraw;
         Draw(0,false);
@@ -1425,7 +1514,6 @@ IRAM_ATTR void VIDEO::MainScreen_Blank_Snow(unsigned int statestoadd, bool conte
         if (brdChange) DrawBorder();
 
         lineptr32 = (uint32_t *)(vga.frameBuffer[linedraw_cnt]) + lineptr_offset;
-        prevLineptr16 = (uint16_t *)(vga.prevFrameBuffer[linedraw_cnt]) + lineptr_offset;
 
         coldraw_cnt = 0;
 
@@ -1461,10 +1549,6 @@ IRAM_ATTR void VIDEO::MainScreen_Blank_Snow(unsigned int statestoadd, bool conte
         
         dispUpdCycle = 0; // For ULA cycle perfect emulation
 
-        #ifdef DIRTY_LINES
-        // Force line draw (for testing)
-        // dirty_lines[curline] = 1;
-        #endif // DIRTY_LINES
 
         Draw = &MainScreen_Snow;
         Draw_Opcode = &MainScreen_Snow_Opcode;
@@ -1489,7 +1573,6 @@ IRAM_ATTR void VIDEO::MainScreen_Blank_Snow_Opcode(bool contended) {
         if (brdChange) DrawBorder();
 
         lineptr32 = (uint32_t *)(vga.frameBuffer[linedraw_cnt]) + lineptr_offset;
-        prevLineptr16 = (uint16_t *)(vga.prevFrameBuffer[linedraw_cnt]) + lineptr_offset;
 
         coldraw_cnt = 0;
 
@@ -1501,10 +1584,6 @@ IRAM_ATTR void VIDEO::MainScreen_Blank_Snow_Opcode(bool contended) {
         
         dispUpdCycle = 0; // For ptime-128 compliant version
 
-        #ifdef DIRTY_LINES
-        // Force line draw (for testing)
-        // dirty_lines[curline] = 1;
-        #endif // DIRTY_LINES
 
         Draw = &MainScreen_Snow;
         Draw_Opcode = &MainScreen_Snow_Opcode;
@@ -1521,8 +1600,6 @@ IRAM_ATTR void VIDEO::MainScreen_Blank_Snow_Opcode(bool contended) {
 
 }    
 
-#ifndef DIRTY_LINES
-
 #if !PICO_RP2040
 // GigaScreen blend LUT: maps (prev_palette_idx, cur_palette_idx) → blended palette_idx
 // Supports standard 16 Spectrum colors (indices 0-15)
@@ -1599,6 +1676,37 @@ inline uint32_t blendPixels32_packed(uint32_t cur, uint16_t prev16) {
     uint8_t r3 = ((c3 & 0x0F) == p3) ? c3 : gigsBlendLUT[p3 * 16 + (c3 & 0x0F)];
     return r0 | (r1 << 8) | (r2 << 16) | (r3 << 24);
 }
+
+// Gigascreen is a deferred pass: MainScreen draws paper lines raw, exactly as
+// with gigascreen off, and queues each finished line. Core1 then blends the
+// line with the previous frame's raw pixels (prevFrameBuffer) and keeps this
+// frame's in their place. Single producer (core0), single consumer (core1);
+// 256 entries so the uint8_t indexes wrap by themselves.
+static volatile uint8_t gigsQueue[256];
+static volatile uint8_t gigsHead, gigsTail;
+
+static inline void gigsQueueLine(unsigned int line) {
+    gigsQueue[gigsHead] = line;
+    __dmb(); // pixels and entry visible before the head moves
+    gigsHead = gigsHead + 1;
+}
+
+void VIDEO::gigascreenPass() {
+    while (gigsTail != gigsHead) {
+        __dmb();
+        unsigned int row = gigsQueue[gigsTail] + lin_end;
+        if (vga.prevFrameBuffer) {
+            uint32_t* cur = (uint32_t *)(vga.frameBuffer[row]) + lineptr_offset;
+            uint16_t* prev = (uint16_t *)(vga.prevFrameBuffer[row]) + lineptr_offset;
+            for (int i = 0; i < 64; i++) {
+                uint32_t raw = cur[i];
+                cur[i] = blendPixels32_packed(raw, prev[i]);
+                prev[i] = packPixels32(raw);
+            }
+        }
+        gigsTail = gigsTail + 1;
+    }
+}
 #else
 // RP2040: gigascreen_enabled is always false, but compiler still needs the symbol
 inline uint32_t blendPixels32(uint32_t cur, uint32_t) { return cur; }
@@ -1618,6 +1726,7 @@ IRAM_ATTR void VIDEO::MainScreen(unsigned int statestoadd, bool contended) {
     video_rest = statestoadd & 0x03;
     unsigned int loopCount = statestoadd >> 2;
     coldraw_cnt += loopCount;
+    bool lineDone = false;
 
     if (coldraw_cnt >= 32) {
         tstateDraw += tStatesPerLine;
@@ -1629,8 +1738,16 @@ IRAM_ATTR void VIDEO::MainScreen(unsigned int statestoadd, bool contended) {
             Draw_Opcode = &MainScreen_Blank_Opcode;
         }
         loopCount -= coldraw_cnt - 32;
+        lineDone = true;
     }
 
+    if (line_ahead) {
+        // Already drawn by MainScreen_Blank
+        attOffset += loopCount;
+        bmpOffset += loopCount;
+        lineptr32 += loopCount << 1;
+        if (coldraw_cnt >= 32) line_ahead = false;
+    } else
 #if !PICO_RP2040
     if (Config::timex_video && VIDEO::timex_mode == 6) {
         // Hi-res mode 6 (512->256): real SCLD alternates byte-columns from
@@ -1668,27 +1785,15 @@ IRAM_ATTR void VIDEO::MainScreen(unsigned int statestoadd, bool contended) {
         }
     } else
 #endif
-    if (VIDEO::gigascreen_enabled) {
-        for (; loopCount--; ) {
-#if !PICO_RP2040
-            uint8_t att = dma_attr_override ? dma_attr_override[attOffset & 0x1F] : grmem[attOffset];
-            attOffset++;
-#else
-            uint8_t att = grmem[attOffset++];
+#ifdef DIRTY_LINES
+    if (!line_dirty && !dirty_lines[curline]) {
+        // Not written since last drawn: the frame buffer already holds it
+        attOffset += loopCount;
+        bmpOffset += loopCount;
+        lineptr32 += loopCount << 1;
+    } else
 #endif
-            uint8_t bmp = grmem[bmpOffset++] ^ (-((att & flashing) >> 7));
-            uint32_t newPixel1 = AluByte[bmp >> 4][att];
-            uint32_t newPixel2 = AluByte[bmp & 0xF][att];
-
-            uint32_t mix1 = blendPixels32_packed(newPixel1, prevLineptr16[0]);
-            uint32_t mix2 = blendPixels32_packed(newPixel2, prevLineptr16[1]);
-            prevLineptr16[0] = packPixels32(newPixel1);
-            prevLineptr16[1] = packPixels32(newPixel2);
-            prevLineptr16 += 2;
-            *lineptr32++ = mix1;
-            *lineptr32++ = mix2;
-        }
-    } else {
+    {
         for (; loopCount--; ) {
 #if !PICO_RP2040
             uint8_t att = dma_attr_override ? dma_attr_override[attOffset & 0x1F] : grmem[attOffset];
@@ -1701,6 +1806,10 @@ IRAM_ATTR void VIDEO::MainScreen(unsigned int statestoadd, bool contended) {
             *lineptr32++ = AluByte[bmp & 0xF][att];
         }
     }
+
+#if !PICO_RP2040
+    if (lineDone && line_giga) gigsQueueLine(curline);
+#endif
 }
 
 IRAM_ATTR void VIDEO::MainScreen_OSD(unsigned int statestoadd, bool contended) {    
@@ -1956,50 +2065,6 @@ IRAM_ATTR void VIDEO::MainScreen_Snow_Opcode(bool contended) {
 
 }
 
-#else
-
-// IRAM_ATTR void VIDEO::MainScreen(unsigned int statestoadd, bool contended) {    
-
-//     if (contended) statestoadd += wait_st[CPU::tstates - tstateDraw];
-
-//     CPU::tstates += statestoadd;
-//     statestoadd += video_rest;
-//     video_rest = statestoadd & 0x03;
-//     unsigned int loopCount = statestoadd >> 2;
-//     coldraw_cnt += loopCount;
-
-//     if (coldraw_cnt >= 32) {
-//         tstateDraw += tStatesPerLine;
-//         Draw = ++linedraw_cnt == lin_end2 ? &Blank : &MainScreen_Blank;
-//         if (dirty_lines[curline]) {
-//             loopCount -= coldraw_cnt - 32;
-//             for (;loopCount--;) {
-//                 uint8_t att = grmem[attOffset++];
-//                 uint8_t bmp = att & flashing ? ~grmem[bmpOffset++] : grmem[bmpOffset++];
-//                 *lineptr32++ = AluByte[bmp >> 4][att];
-//                 *lineptr32++ = AluByte[bmp & 0xF][att];
-//             }
-//             dirty_lines[curline] &= 0x80;
-//         }
-//         return;
-//     }
-
-//     if (dirty_lines[curline]) {
-//         for (;loopCount--;) {
-//             uint8_t att = grmem[attOffset++];
-//             uint8_t bmp = att & flashing ? ~grmem[bmpOffset++] : grmem[bmpOffset++];
-//             *lineptr32++ = AluByte[bmp >> 4][att];
-//             *lineptr32++ = AluByte[bmp & 0xF][att];
-//         }
-//     } else {
-//         attOffset += loopCount;
-//         bmpOffset += loopCount;
-//         lineptr32 += loopCount << 1;
-//     }
-
-// }
-
-#endif
 
 IRAM_ATTR void VIDEO::Blank(unsigned int statestoadd, bool contended) { CPU::tstates += statestoadd; }
 IRAM_ATTR void VIDEO::Blank_Opcode(bool contended) { CPU::tstates += 4; }
@@ -2008,8 +2073,26 @@ IRAM_ATTR void VIDEO::Blank_Snow_Opcode(bool contended) { CPU::tstates += 4; }
 
 IRAM_ATTR void VIDEO::EndFrame() {
 
+    uint32_t prof = Profiler::begin();
+
     linedraw_cnt = lin_end;
 
+#ifdef DIRTY_LINES
+    // Anything that changes how the whole paper area is drawn
+    static const void* lastKey[4];
+    const void* key[4] = { grmem, AluByte[0], (const void*)(uintptr_t)gigascreen_enabled,
+#if !PICO_RP2040
+        (const void*)(uintptr_t)((Config::timex_video ? timex_mode : 0) | (mode16col_enabled << 3))
+#else
+        nullptr
+#endif
+    };
+    if (memcmp(key, lastKey, sizeof(key)) || !(framecnt % DIRTY_REFRESH)) {
+        memcpy(lastKey, key, sizeof(key));
+        dirtyAll();
+    }
+#endif
+
     tstateDraw = tStatesScreen;
 
 #if !PICO_RP2040
@@ -2091,6 +2174,8 @@ IRAM_ATTR void VIDEO::EndFrame() {
 #endif
 
     framecnt++;
+
+    Profiler::end(PROF_VID, prof);
 }
 
 //----------------------------------------------------------------------------------------------------------------
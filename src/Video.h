@@ -152,6 +152,7 @@ public:
   // static void DrawBorderFast();
 #if !PICO_RP2040
   static void InitPrevBuffer();
+  static void gigascreenPass(); // core1: blend the paper lines MainScreen queued
 #endif
 
   static void Border_Blank();
@@ -212,9 +213,32 @@ public:
   static bool snow_toggle;
   
   #ifdef DIRTY_LINES
-  static uint8_t dirty_lines[SPEC_H];
-  // static uint8_t linecalc[SPEC_H];
+  static uint8_t dirty_lines[SPEC_H]; // written since last drawn
+  // Byte 'off' of the 6912-byte screen at grmem was written
+  static inline void dirtyScreen(uint32_t off) {
+    if (off < 6144)
+      dirty_lines[((off >> 5) & 0xC0) | ((off >> 2) & 0x38) | ((off >> 8) & 0x07)] = 1;
+    else
+      memset(dirty_lines + (((off - 6144) >> 5) << 3), 1, 8);
+  }
+  static void dirtyFlash();
   #endif // DIRTY_LINES
+  static inline void dirtyAll() {
+    line_ahead = false;
+  #ifdef DIRTY_LINES
+    memset(dirty_lines, 1, SPEC_H);
+  #endif
+  }
+
+  // Paper line drawn whole when the beam entered it. MainScreen then only
+  // counts columns, until a write to the line's bitmap or attributes (or a
+  // mode change) hands the rest of the line back to the per-T-state loop.
+  static bool line_ahead;
+  static uint32_t line_bmp, line_att; // the line's offsets in grmem
+  static inline void lineWrite(const uint8_t* p) {
+    uint32_t off = (uint32_t)(p - grmem);
+    if (off - line_bmp < 32 || off - line_att < 32) line_ahead = false;
+  }
  
   static uint8_t OSD;
 
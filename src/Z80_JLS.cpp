@@ -1230,13 +1230,49 @@ IRAM_ATTR void Z80::execute() {
 
 }
 
-IRAM_ATTR void Z80::exec_nocheck() {
+// execute() en bucle hasta el horizonte 'horizon' (t-states), sin pasar por CPU::loop
+IRAM_ATTR void Z80::execUntil(uint32_t horizon) {
 
-    int nbp = Config::numPcBP;
+    while (CPU::tstates < horizon) {
 
-    while (CPU::tstates < CPU::stFrame) {
+        opCode = Z80Ops::fetchOpcode();
+
+        regR++;
+
+        if (!halted) {
+
+            REG_PC++;
+
+            if (prefixOpcode == 0) {
+                flagQ = pendingEI = false;
+                dcOpcode[opCode]();
+            } else if (prefixOpcode == 0xDD) {
+                prefixOpcode = 0;
+                decodeDDFD(regIX);
+            } else if (prefixOpcode == 0xED) {
+                prefixOpcode = 0;
+                decodeED();
+            } else if (prefixOpcode == 0xFD) {
+                prefixOpcode = 0;
+                decodeDDFD(regIY);
+            } else continue;
+
+            if (prefixOpcode != 0) continue;
+
+            lastFlagQ = flagQ;
+
+        }
+
+        checkINT();
+
+    }
+
+}
+
+// Breakpoints are checked by CPU::loop, which only calls this with none armed
+IRAM_ATTR void Z80::exec_nocheck() {
 
-        if (nbp > 0 && Config::hasBreakPoint(REG_PC, Config::BP_PC)) return;
+    while (CPU::tstates < CPU::stFrame) {
 
         uint8_t pg = REG_PCh >> 6;
         VIDEO::Draw_Opcode(MemESP::ramContended[pg]);
@@ -4780,1706 +4816,1669 @@ void (*Z80::dcCB[256])() = {
  * Naturalmente, en una serie repetida de DDFD no hay que comprobar las
  * interrupciones entre cada prefijo.
  */
-void Z80::decodeDDFD(RegisterPair& regIXY) {
-    switch (opCode) {
-        case 0x09:
-        { /* ADD IX,BC */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            add16(regIXY, REG_BC);
-            break;
-        }
-        case 0x19:
-        { /* ADD IX,DE */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            add16(regIXY, REG_DE);
-            break;
-        }
-        case 0x21:
-        { /* LD IX,nn */
-            regIXY.word = Z80Ops::peek16(REG_PC);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x22:
-        { /* LD (nn),IX */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            Z80Ops::poke16(REG_WZ++, regIXY);
-            REG_PC = REG_PC + 2;
-            break;
+void Z80::dcDDFD09(RegisterPair& regIXY)
+{ /* ADD IX,BC */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    add16(regIXY, REG_BC);
+}
+
+void Z80::dcDDFD19(RegisterPair& regIXY)
+{ /* ADD IX,DE */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    add16(regIXY, REG_DE);
+}
+
+void Z80::dcDDFD21(RegisterPair& regIXY)
+{ /* LD IX,nn */
+    regIXY.word = Z80Ops::peek16(REG_PC);
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcDDFD22(RegisterPair& regIXY)
+{ /* LD (nn),IX */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    Z80Ops::poke16(REG_WZ++, regIXY);
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcDDFD23(RegisterPair& regIXY)
+{ /* INC IX */
+    Z80Ops::addressOnBus(getPairIR().word, 2);
+    regIXY.word++;
+}
+
+void Z80::dcDDFD24(RegisterPair& regIXY)
+{ /* INC IXh */
+    inc8(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFD25(RegisterPair& regIXY)
+{ /* DEC IXh */
+    dec8(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFD26(RegisterPair& regIXY)
+{ /* LD IXh,n */
+    regIXY.byte8.hi = Z80Ops::peek8(REG_PC);
+    REG_PC++;
+}
+
+void Z80::dcDDFD29(RegisterPair& regIXY)
+{ /* ADD IX,IX */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    add16(regIXY, regIXY.word);
+}
+
+void Z80::dcDDFD2A(RegisterPair& regIXY)
+{ /* LD IX,(nn) */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    regIXY.word = Z80Ops::peek16(REG_WZ++);
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcDDFD2B(RegisterPair& regIXY)
+{ /* DEC IX */
+    Z80Ops::addressOnBus(getPairIR().word, 2);
+    regIXY.word--;
+
+    if (REG_PC == 0x04d4) { // Save trap
+
+        static bool SaveFileExists;
+
+        if (REG_HL == 0x1F80) {
+            SaveFileExists = (Tape::tapeFileType == TAPE_FTYPE_TAP);
+            if (!SaveFileExists)
+                OSD::osdCenteredMsg(OSD_TAPE_SELECT_ERR[Config::lang], LEVEL_WARN);
         }
-        case 0x23:
-        { /* INC IX */
-            Z80Ops::addressOnBus(getPairIR().word, 2);
+
+        if (SaveFileExists) {
+            regA = REG_HL == 0x1F80 ? 0x00 : 0xFF;
             regIXY.word++;
-            break;
-        }
-        case 0x24:
-        { /* INC IXh */
-            inc8(regIXY.byte8.hi);
-            break;
-        }
-        case 0x25:
-        { /* DEC IXh */
-            dec8(regIXY.byte8.hi);
-            break;
-        }
-        case 0x26:
-        { /* LD IXh,n */
-            regIXY.byte8.hi = Z80Ops::peek8(REG_PC);
-            REG_PC++;
-            break;
-        }
-        case 0x29:
-        { /* ADD IX,IX */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            add16(regIXY, regIXY.word);
-            break;
+            REG_DE--;
+            Tape::Save();
+            REG_PC = 0x555;
         }
-        case 0x2A:
-        { /* LD IX,(nn) */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            regIXY.word = Z80Ops::peek16(REG_WZ++);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x2B:
-        { /* DEC IX */
-            Z80Ops::addressOnBus(getPairIR().word, 2);
-            regIXY.word--;
 
-            if (REG_PC == 0x04d4) { // Save trap
+        // static uint8_t SaveRes;
 
-                static bool SaveFileExists;
+        // if (REG_HL == 0x1F80) {
 
-                if (REG_HL == 0x1F80) {
-                    SaveFileExists = (Tape::tapeFileType == TAPE_FTYPE_TAP);
-                    if (!SaveFileExists)
-                        OSD::osdCenteredMsg(OSD_TAPE_SELECT_ERR[Config::lang], LEVEL_WARN);
-                }
+        //     // printf("Saving header!\n");
 
-                if (SaveFileExists) {
-                    regA = REG_HL == 0x1F80 ? 0x00 : 0xFF;
-                    regIXY.word++;
-                    REG_DE--;
-                    Tape::Save();
-                    REG_PC = 0x555;
-                }
+        //     regIXY.word++;
 
-                // static uint8_t SaveRes;
+        //     // remove .tap output file if exists
 
-                // if (REG_HL == 0x1F80) {
+        //     // Get save name
+        //     string name;
+        //     uint16_t header_data = REG_IX;
+        //     for (int i=0; i < 10; i++)
+        //         name += MemESP::ramCurrent[header_data++ >> 14][header_data & 0x3fff];
+        //     rtrim(name);
 
-                //     // printf("Saving header!\n");
+        //     SaveRes = DLG_YES;
 
-                //     regIXY.word++;
+        //     struct stat stat_buf;
 
-                //     // remove .tap output file if exists
+        //     printf("Tapesavename: %s\n",Tape::tapeSaveName.c_str());
+        //     if ( Tape::tapeSaveName == "" || Tape::tapeSaveName == "none" || !FileUtils::hasTAPextension(Tape::tapeSaveName) || stat(Tape::tapeSaveName.c_str(), &stat_buf) ) {
+        //         OSD::osdCenteredMsg(OSD_TAPE_SELECT_ERR[Config::lang], LEVEL_WARN);
+        //         SaveRes = DLG_NO;
+        //     } else {
+        //         REG_DE--;
+        //         regA = 0x00;
 
-                //     // Get save name
-                //     string name;
-                //     uint16_t header_data = REG_IX;
-                //     for (int i=0; i < 10; i++)
-                //         name += MemESP::ramCurrent[header_data++ >> 14][header_data & 0x3fff];
-                //     rtrim(name);
+        //         Tape::Save();
 
-                //     SaveRes = DLG_YES;
+        //         REG_PC = 0x555;
+        //     }
 
-                //     struct stat stat_buf;
+        // } else {
 
-                //     printf("Tapesavename: %s\n",Tape::tapeSaveName.c_str());
-                //     if ( Tape::tapeSaveName == "" || Tape::tapeSaveName == "none" || !FileUtils::hasTAPextension(Tape::tapeSaveName) || stat(Tape::tapeSaveName.c_str(), &stat_buf) ) {
-                //         OSD::osdCenteredMsg(OSD_TAPE_SELECT_ERR[Config::lang], LEVEL_WARN);
-                //         SaveRes = DLG_NO;
-                //     } else {
-                //         REG_DE--;
-                //         regA = 0x00;
+        //     // printf("Saving data!\n");
 
-                //         Tape::Save();
+        //     // Call Save function
 
-                //         REG_PC = 0x555;
-                //     }
+        //     // printf("Saving %s block.\n",Tape::tapeSaveName.c_str());
 
-                // } else {
+        //     if (SaveRes == DLG_YES) {
 
-                //     // printf("Saving data!\n");
+        //         REG_DE--;
+        //         regIXY.word++;
+        //         regA = 0xFF;
 
-                //     // Call Save function
+        //         Tape::Save();
 
-                //     // printf("Saving %s block.\n",Tape::tapeSaveName.c_str());
+        //         REG_PC = 0x555;
 
-                //     if (SaveRes == DLG_YES) {
+        //     }
 
-                //         REG_DE--;
-                //         regIXY.word++;
-                //         regA = 0xFF;
+        // }
 
-                //         Tape::Save();
+    }
+}
 
-                //         REG_PC = 0x555;
+void Z80::dcDDFD2C(RegisterPair& regIXY)
+{ /* INC IXl */
+    inc8(regIXY.byte8.lo);
+}
 
-                //     }
+void Z80::dcDDFD2D(RegisterPair& regIXY)
+{ /* DEC IXl */
+    dec8(regIXY.byte8.lo);
+}
 
-                // }
+void Z80::dcDDFD2E(RegisterPair& regIXY)
+{ /* LD IXl,n */
+    regIXY.byte8.lo = Z80Ops::peek8(REG_PC);
+    REG_PC++;
+}
 
-            }
+void Z80::dcDDFD34(RegisterPair& regIXY)
+{ /* INC (IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    uint8_t work8 = Z80Ops::peek8(REG_WZ);
+    Z80Ops::addressOnBus(REG_WZ, 1);
+    inc8(work8);
+    Z80Ops::poke8(REG_WZ, work8);
+}
 
-            break;
-        }
-        case 0x2C:
-        { /* INC IXl */
-            inc8(regIXY.byte8.lo);
-            break;
-        }
-        case 0x2D:
-        { /* DEC IXl */
-            dec8(regIXY.byte8.lo);
-            break;
-        }
-        case 0x2E:
-        { /* LD IXl,n */
-            regIXY.byte8.lo = Z80Ops::peek8(REG_PC);
-            REG_PC++;
-            break;
-        }
-        case 0x34:
-        { /* INC (IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            uint8_t work8 = Z80Ops::peek8(REG_WZ);
-            Z80Ops::addressOnBus(REG_WZ, 1);
-            inc8(work8);
-            Z80Ops::poke8(REG_WZ, work8);
-            break;
-        }
-        case 0x35:
-        { /* DEC (IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            uint8_t work8 = Z80Ops::peek8(REG_WZ);
-            Z80Ops::addressOnBus(REG_WZ, 1);
-            dec8(work8);
-            Z80Ops::poke8(REG_WZ, work8);
-            break;
-        }
-        case 0x36:
-        { /* LD (IX+d),n */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            REG_PC++;
-            uint8_t work8 = Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 2);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, work8);
-            break;
-        }
-        case 0x39:
-        { /* ADD IX,SP */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            add16(regIXY, REG_SP);
-            break;
-        }
-        case 0x44:
-        { /* LD B,IXh */
-            REG_B = regIXY.byte8.hi;
-            break;
-        }
-        case 0x45:
-        { /* LD B,IXl */
-            REG_B = regIXY.byte8.lo;
-            break;
-        }
-        case 0x46:
-        { /* LD B,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            REG_B = Z80Ops::peek8(REG_WZ);
-            break;
-        }
-        case 0x4C:
-        { /* LD C,IXh */
-            REG_C = regIXY.byte8.hi;
-            break;
-        }
-        case 0x4D:
-        { /* LD C,IXl */
-            REG_C = regIXY.byte8.lo;
-            break;
-        }
-        case 0x4E:
-        { /* LD C,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            REG_C = Z80Ops::peek8(REG_WZ);
-            break;
-        }
-        case 0x54:
-        { /* LD D,IXh */
-            REG_D = regIXY.byte8.hi;
-            break;
-        }
-        case 0x55:
-        { /* LD D,IXl */
-            REG_D = regIXY.byte8.lo;
-            break;
-        }
-        case 0x56:
-        { /* LD D,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            REG_D = Z80Ops::peek8(REG_WZ);
-            break;
-        }
-        case 0x5C:
-        { /* LD E,IXh */
-            REG_E = regIXY.byte8.hi;
-            break;
-        }
-        case 0x5D:
-        { /* LD E,IXl */
-            REG_E = regIXY.byte8.lo;
-            break;
-        }
-        case 0x5E:
-        { /* LD E,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            REG_E = Z80Ops::peek8(REG_WZ);
-            break;
-        }
-        case 0x60:
-        { /* LD IXh,B */
-            regIXY.byte8.hi = REG_B;
-            break;
-        }
-        case 0x61:
-        { /* LD IXh,C */
-            regIXY.byte8.hi = REG_C;
-            break;
-        }
-        case 0x62:
-        { /* LD IXh,D */
-            regIXY.byte8.hi = REG_D;
-            break;
-        }
-        case 0x63:
-        { /* LD IXh,E */
-            regIXY.byte8.hi = REG_E;
-            break;
-        }
-        case 0x64:
-        { /* LD IXh,IXh */
-            break;
-        }
-        case 0x65:
-        { /* LD IXh,IXl */
-            regIXY.byte8.hi = regIXY.byte8.lo;
-            break;
-        }
-        case 0x66:
-        { /* LD H,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            REG_H = Z80Ops::peek8(REG_WZ);
-            break;
-        }
-        case 0x67:
-        { /* LD IXh,A */
-            regIXY.byte8.hi = regA;
-            break;
-        }
-        case 0x68:
-        { /* LD IXl,B */
-            regIXY.byte8.lo = REG_B;
-            break;
-        }
-        case 0x69:
-        { /* LD IXl,C */
-            regIXY.byte8.lo = REG_C;
-            break;
-        }
-        case 0x6A:
-        { /* LD IXl,D */
-            regIXY.byte8.lo = REG_D;
-            break;
-        }
-        case 0x6B:
-        { /* LD IXl,E */
-            regIXY.byte8.lo = REG_E;
-            break;
-        }
-        case 0x6C:
-        { /* LD IXl,IXh */
-            regIXY.byte8.lo = regIXY.byte8.hi;
-            break;
-        }
-        case 0x6D:
-        { /* LD IXl,IXl */
-            break;
-        }
-        case 0x6E:
-        { /* LD L,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            REG_L = Z80Ops::peek8(REG_WZ);
-            break;
-        }
-        case 0x6F:
-        { /* LD IXl,A */
-            regIXY.byte8.lo = regA;
-            break;
-        }
-        case 0x70:
-        { /* LD (IX+d),B */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, REG_B);
-            break;
-        }
-        case 0x71:
-        { /* LD (IX+d),C */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, REG_C);
-            break;
-        }
-        case 0x72:
-        { /* LD (IX+d),D */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, REG_D);
-            break;
-        }
-        case 0x73:
-        { /* LD (IX+d),E */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, REG_E);
-            break;
-        }
-        case 0x74:
-        { /* LD (IX+d),H */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, REG_H);
-            break;
-        }
-        case 0x75:
-        { /* LD (IX+d),L */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, REG_L);
-            break;
-        }
-        case 0x77:
-        { /* LD (IX+d),A */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            Z80Ops::poke8(REG_WZ, regA);
-            break;
-        }
-        case 0x7C:
-        { /* LD A,IXh */
-            regA = regIXY.byte8.hi;
-            break;
-        }
-        case 0x7D:
-        { /* LD A,IXl */
-            regA = regIXY.byte8.lo;
-            break;
-        }
-        case 0x7E:
-        { /* LD A,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            regA = Z80Ops::peek8(REG_WZ);
-            break;
-        }
-        case 0x84:
-        { /* ADD A,IXh */
-            add(regIXY.byte8.hi);
-            break;
-        }
-        case 0x85:
-        { /* ADD A,IXl */
-            add(regIXY.byte8.lo);
-            break;
-        }
-        case 0x86:
-        { /* ADD A,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            add(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0x8C:
-        { /* ADC A,IXh */
-            adc(regIXY.byte8.hi);
-            break;
-        }
-        case 0x8D:
-        { /* ADC A,IXl */
-            adc(regIXY.byte8.lo);
-            break;
-        }
-        case 0x8E:
-        { /* ADC A,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            adc(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0x94:
-        { /* SUB IXh */
-            sub(regIXY.byte8.hi);
-            break;
-        }
-        case 0x95:
-        { /* SUB IXl */
-            sub(regIXY.byte8.lo);
-            break;
-        }
-        case 0x96:
-        { /* SUB (IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            sub(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0x9C:
-        { /* SBC A,IXh */
-            sbc(regIXY.byte8.hi);
-            break;
-        }
-        case 0x9D:
-        { /* SBC A,IXl */
-            sbc(regIXY.byte8.lo);
-            break;
-        }
-        case 0x9E:
-        { /* SBC A,(IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            sbc(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0xA4:
-        { /* AND IXh */
-            and_(regIXY.byte8.hi);
-            break;
-        }
-        case 0xA5:
-        { /* AND IXl */
-            and_(regIXY.byte8.lo);
-            break;
-        }
-        case 0xA6:
-        { /* AND (IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            and_(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0xAC:
-        { /* XOR IXh */
-            xor_(regIXY.byte8.hi);
-            break;
-        }
-        case 0xAD:
-        { /* XOR IXl */
-            xor_(regIXY.byte8.lo);
-            break;
-        }
-        case 0xAE:
-        { /* XOR (IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            xor_(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0xB4:
-        { /* OR IXh */
-            or_(regIXY.byte8.hi);
-            break;
-        }
-        case 0xB5:
-        { /* OR IXl */
-            or_(regIXY.byte8.lo);
-            break;
-        }
-        case 0xB6:
-        { /* OR (IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            or_(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0xBC:
-        { /* CP IXh */
-            cp(regIXY.byte8.hi);
-            break;
-        }
-        case 0xBD:
-        { /* CP IXl */
-            cp(regIXY.byte8.lo);
-            break;
-        }
-        case 0xBE:
-        { /* CP (IX+d) */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 5);
-            REG_PC++;
-            cp(Z80Ops::peek8(REG_WZ));
-            break;
-        }
-        case 0xCB:
-        { /* Subconjunto de instrucciones */
-            REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
-            REG_PC++;
-            opCode = Z80Ops::peek8(REG_PC);
-            Z80Ops::addressOnBus(REG_PC, 2);
-            REG_PC++;
-            decodeDDFDCB(REG_WZ);
-            break;
-        }
-        case 0xDD:
-            prefixOpcode = 0xDD;
-            break;
-        case 0xE1:
-        { /* POP IX */
-            regIXY.word = pop();
-            break;
-        }
-        case 0xE3:
-        { /* EX (SP),IX */
-            // Instrucción de ejecución sutil como pocas... atento al dato.
-            RegisterPair work16 = regIXY;
-            regIXY.word = Z80Ops::peek16(REG_SP);
-            Z80Ops::addressOnBus(REG_SP + 1, 1);
-            // I can't call to poke16 from here because the Z80 do the writes in inverted order
-            // Same for EX (SP), HL
-            Z80Ops::poke8(REG_SP + 1, work16.byte8.hi);
-            Z80Ops::poke8(REG_SP, work16.byte8.lo);
-            Z80Ops::addressOnBus(REG_SP, 2);
-            REG_WZ = regIXY.word;
-            break;
-        }
-        case 0xE5:
-        { /* PUSH IX */
-            Z80Ops::addressOnBus(getPairIR().word, 1);
-            push(regIXY.word);
-            break;
-        }
-        case 0xE9:
-        { /* JP (IX) */
-            REG_PC = regIXY.word;
+void Z80::dcDDFD35(RegisterPair& regIXY)
+{ /* DEC (IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    uint8_t work8 = Z80Ops::peek8(REG_WZ);
+    Z80Ops::addressOnBus(REG_WZ, 1);
+    dec8(work8);
+    Z80Ops::poke8(REG_WZ, work8);
+}
 
-            check_trdos();
+void Z80::dcDDFD36(RegisterPair& regIXY)
+{ /* LD (IX+d),n */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    REG_PC++;
+    uint8_t work8 = Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 2);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, work8);
+}
 
-            break;
-        }
-        case 0xED:
-        {
-            prefixOpcode = 0xED;
-            break;
-        }
-        case 0xF9:
-        { /* LD SP,IX */
-            Z80Ops::addressOnBus(getPairIR().word, 2);
-            REG_SP = regIXY.word;
-            break;
-        }
-        case 0xFD:
-        {
-            prefixOpcode = 0xFD;
-            break;
-        }
-        default:
-        {
-            // Detrás de un DD/FD o varios en secuencia venía un código
-            // que no correspondía con una instrucción que involucra a
-            // IX o IY. Se trata como si fuera un código normal.
-            // Sin esto, además de emular mal, falla el test
-            // ld <bcdexya>,<bcdexya> de ZEXALL.
+void Z80::dcDDFD39(RegisterPair& regIXY)
+{ /* ADD IX,SP */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    add16(regIXY, REG_SP);
+}
+
+void Z80::dcDDFD44(RegisterPair& regIXY)
+{ /* LD B,IXh */
+    REG_B = regIXY.byte8.hi;
+}
+
+void Z80::dcDDFD45(RegisterPair& regIXY)
+{ /* LD B,IXl */
+    REG_B = regIXY.byte8.lo;
+}
+
+void Z80::dcDDFD46(RegisterPair& regIXY)
+{ /* LD B,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    REG_B = Z80Ops::peek8(REG_WZ);
+}
+
+void Z80::dcDDFD4C(RegisterPair& regIXY)
+{ /* LD C,IXh */
+    REG_C = regIXY.byte8.hi;
+}
+
+void Z80::dcDDFD4D(RegisterPair& regIXY)
+{ /* LD C,IXl */
+    REG_C = regIXY.byte8.lo;
+}
+
+void Z80::dcDDFD4E(RegisterPair& regIXY)
+{ /* LD C,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    REG_C = Z80Ops::peek8(REG_WZ);
+}
+
+void Z80::dcDDFD54(RegisterPair& regIXY)
+{ /* LD D,IXh */
+    REG_D = regIXY.byte8.hi;
+}
+
+void Z80::dcDDFD55(RegisterPair& regIXY)
+{ /* LD D,IXl */
+    REG_D = regIXY.byte8.lo;
+}
+
+void Z80::dcDDFD56(RegisterPair& regIXY)
+{ /* LD D,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    REG_D = Z80Ops::peek8(REG_WZ);
+}
+
+void Z80::dcDDFD5C(RegisterPair& regIXY)
+{ /* LD E,IXh */
+    REG_E = regIXY.byte8.hi;
+}
+
+void Z80::dcDDFD5D(RegisterPair& regIXY)
+{ /* LD E,IXl */
+    REG_E = regIXY.byte8.lo;
+}
+
+void Z80::dcDDFD5E(RegisterPair& regIXY)
+{ /* LD E,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    REG_E = Z80Ops::peek8(REG_WZ);
+}
+
+void Z80::dcDDFD60(RegisterPair& regIXY)
+{ /* LD IXh,B */
+    regIXY.byte8.hi = REG_B;
+}
+
+void Z80::dcDDFD61(RegisterPair& regIXY)
+{ /* LD IXh,C */
+    regIXY.byte8.hi = REG_C;
+}
+
+void Z80::dcDDFD62(RegisterPair& regIXY)
+{ /* LD IXh,D */
+    regIXY.byte8.hi = REG_D;
+}
+
+void Z80::dcDDFD63(RegisterPair& regIXY)
+{ /* LD IXh,E */
+    regIXY.byte8.hi = REG_E;
+}
+
+void Z80::dcDDFD64(RegisterPair& regIXY)
+{ /* LD IXh,IXh */
+}
+
+void Z80::dcDDFD65(RegisterPair& regIXY)
+{ /* LD IXh,IXl */
+    regIXY.byte8.hi = regIXY.byte8.lo;
+}
+
+void Z80::dcDDFD66(RegisterPair& regIXY)
+{ /* LD H,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    REG_H = Z80Ops::peek8(REG_WZ);
+}
+
+void Z80::dcDDFD67(RegisterPair& regIXY)
+{ /* LD IXh,A */
+    regIXY.byte8.hi = regA;
+}
+
+void Z80::dcDDFD68(RegisterPair& regIXY)
+{ /* LD IXl,B */
+    regIXY.byte8.lo = REG_B;
+}
+
+void Z80::dcDDFD69(RegisterPair& regIXY)
+{ /* LD IXl,C */
+    regIXY.byte8.lo = REG_C;
+}
+
+void Z80::dcDDFD6A(RegisterPair& regIXY)
+{ /* LD IXl,D */
+    regIXY.byte8.lo = REG_D;
+}
+
+void Z80::dcDDFD6B(RegisterPair& regIXY)
+{ /* LD IXl,E */
+    regIXY.byte8.lo = REG_E;
+}
+
+void Z80::dcDDFD6C(RegisterPair& regIXY)
+{ /* LD IXl,IXh */
+    regIXY.byte8.lo = regIXY.byte8.hi;
+}
+
+void Z80::dcDDFD6D(RegisterPair& regIXY)
+{ /* LD IXl,IXl */
+}
+
+void Z80::dcDDFD6E(RegisterPair& regIXY)
+{ /* LD L,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    REG_L = Z80Ops::peek8(REG_WZ);
+}
+
+void Z80::dcDDFD6F(RegisterPair& regIXY)
+{ /* LD IXl,A */
+    regIXY.byte8.lo = regA;
+}
+
+void Z80::dcDDFD70(RegisterPair& regIXY)
+{ /* LD (IX+d),B */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, REG_B);
+}
+
+void Z80::dcDDFD71(RegisterPair& regIXY)
+{ /* LD (IX+d),C */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, REG_C);
+}
+
+void Z80::dcDDFD72(RegisterPair& regIXY)
+{ /* LD (IX+d),D */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, REG_D);
+}
+
+void Z80::dcDDFD73(RegisterPair& regIXY)
+{ /* LD (IX+d),E */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, REG_E);
+}
+
+void Z80::dcDDFD74(RegisterPair& regIXY)
+{ /* LD (IX+d),H */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, REG_H);
+}
+
+void Z80::dcDDFD75(RegisterPair& regIXY)
+{ /* LD (IX+d),L */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, REG_L);
+}
+
+void Z80::dcDDFD77(RegisterPair& regIXY)
+{ /* LD (IX+d),A */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    Z80Ops::poke8(REG_WZ, regA);
+}
+
+void Z80::dcDDFD7C(RegisterPair& regIXY)
+{ /* LD A,IXh */
+    regA = regIXY.byte8.hi;
+}
+
+void Z80::dcDDFD7D(RegisterPair& regIXY)
+{ /* LD A,IXl */
+    regA = regIXY.byte8.lo;
+}
+
+void Z80::dcDDFD7E(RegisterPair& regIXY)
+{ /* LD A,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    regA = Z80Ops::peek8(REG_WZ);
+}
+
+void Z80::dcDDFD84(RegisterPair& regIXY)
+{ /* ADD A,IXh */
+    add(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFD85(RegisterPair& regIXY)
+{ /* ADD A,IXl */
+    add(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFD86(RegisterPair& regIXY)
+{ /* ADD A,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    add(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFD8C(RegisterPair& regIXY)
+{ /* ADC A,IXh */
+    adc(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFD8D(RegisterPair& regIXY)
+{ /* ADC A,IXl */
+    adc(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFD8E(RegisterPair& regIXY)
+{ /* ADC A,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    adc(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFD94(RegisterPair& regIXY)
+{ /* SUB IXh */
+    sub(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFD95(RegisterPair& regIXY)
+{ /* SUB IXl */
+    sub(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFD96(RegisterPair& regIXY)
+{ /* SUB (IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    sub(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFD9C(RegisterPair& regIXY)
+{ /* SBC A,IXh */
+    sbc(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFD9D(RegisterPair& regIXY)
+{ /* SBC A,IXl */
+    sbc(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFD9E(RegisterPair& regIXY)
+{ /* SBC A,(IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    sbc(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFDA4(RegisterPair& regIXY)
+{ /* AND IXh */
+    and_(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFDA5(RegisterPair& regIXY)
+{ /* AND IXl */
+    and_(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFDA6(RegisterPair& regIXY)
+{ /* AND (IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    and_(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFDAC(RegisterPair& regIXY)
+{ /* XOR IXh */
+    xor_(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFDAD(RegisterPair& regIXY)
+{ /* XOR IXl */
+    xor_(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFDAE(RegisterPair& regIXY)
+{ /* XOR (IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    xor_(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFDB4(RegisterPair& regIXY)
+{ /* OR IXh */
+    or_(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFDB5(RegisterPair& regIXY)
+{ /* OR IXl */
+    or_(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFDB6(RegisterPair& regIXY)
+{ /* OR (IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    or_(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFDBC(RegisterPair& regIXY)
+{ /* CP IXh */
+    cp(regIXY.byte8.hi);
+}
+
+void Z80::dcDDFDBD(RegisterPair& regIXY)
+{ /* CP IXl */
+    cp(regIXY.byte8.lo);
+}
+
+void Z80::dcDDFDBE(RegisterPair& regIXY)
+{ /* CP (IX+d) */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 5);
+    REG_PC++;
+    cp(Z80Ops::peek8(REG_WZ));
+}
+
+void Z80::dcDDFDCBprefix(RegisterPair& regIXY)
+{ /* Subconjunto de instrucciones */
+    REG_WZ = regIXY.word + (int8_t) Z80Ops::peek8(REG_PC);
+    REG_PC++;
+    opCode = Z80Ops::peek8(REG_PC);
+    Z80Ops::addressOnBus(REG_PC, 2);
+    REG_PC++;
+    decodeDDFDCB(REG_WZ);
+}
+
+void Z80::dcDDFDDD(RegisterPair& regIXY)
+{
+    prefixOpcode = 0xDD;
+}
+
+void Z80::dcDDFDE1(RegisterPair& regIXY)
+{ /* POP IX */
+    regIXY.word = pop();
+}
+
+void Z80::dcDDFDE3(RegisterPair& regIXY)
+{ /* EX (SP),IX */
+    // Instrucción de ejecución sutil como pocas... atento al dato.
+    RegisterPair work16 = regIXY;
+    regIXY.word = Z80Ops::peek16(REG_SP);
+    Z80Ops::addressOnBus(REG_SP + 1, 1);
+    // I can't call to poke16 from here because the Z80 do the writes in inverted order
+    // Same for EX (SP), HL
+    Z80Ops::poke8(REG_SP + 1, work16.byte8.hi);
+    Z80Ops::poke8(REG_SP, work16.byte8.lo);
+    Z80Ops::addressOnBus(REG_SP, 2);
+    REG_WZ = regIXY.word;
+}
+
+void Z80::dcDDFDE5(RegisterPair& regIXY)
+{ /* PUSH IX */
+    Z80Ops::addressOnBus(getPairIR().word, 1);
+    push(regIXY.word);
+}
+
+void Z80::dcDDFDE9(RegisterPair& regIXY)
+{ /* JP (IX) */
+    REG_PC = regIXY.word;
+
+    check_trdos();
+}
+
+void Z80::dcDDFDED(RegisterPair& regIXY)
+{
+    prefixOpcode = 0xED;
+}
+
+void Z80::dcDDFDF9(RegisterPair& regIXY)
+{ /* LD SP,IX */
+    Z80Ops::addressOnBus(getPairIR().word, 2);
+    REG_SP = regIXY.word;
+}
+
+void Z80::dcDDFDFD(RegisterPair& regIXY)
+{
+    prefixOpcode = 0xFD;
+}
+
+void Z80::dcDDFDdefault(RegisterPair& regIXY)
+{
+    // Detrás de un DD/FD o varios en secuencia venía un código
+    // que no correspondía con una instrucción que involucra a
+    // IX o IY. Se trata como si fuera un código normal.
+    // Sin esto, además de emular mal, falla el test
+    // ld <bcdexya>,<bcdexya> de ZEXALL.
 #ifdef WITH_BREAKPOINT_SUPPORT
-            if (breakpointEnabled && prefixOpcode == 0) {
-                opCode = Z80Ops::breakpoint(REG_PC, opCode);
-            }
+    if (breakpointEnabled && prefixOpcode == 0) {
+        opCode = Z80Ops::breakpoint(REG_PC, opCode);
+    }
 #endif
-            dcOpcode[opCode]();
-            // decodeOpcode();
-            break;
-        }
+    dcOpcode[opCode]();
+}
+
+void (*Z80::dcDDFD[256])(RegisterPair& regIXY) = {
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFD09, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFD19, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFD21, &dcDDFD22, &dcDDFD23,
+    &dcDDFD24, &dcDDFD25, &dcDDFD26, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFD29, &dcDDFD2A, &dcDDFD2B,
+    &dcDDFD2C, &dcDDFD2D, &dcDDFD2E, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD34, &dcDDFD35, &dcDDFD36, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFD39, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD44, &dcDDFD45, &dcDDFD46, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD4C, &dcDDFD4D, &dcDDFD4E, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD54, &dcDDFD55, &dcDDFD56, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD5C, &dcDDFD5D, &dcDDFD5E, &dcDDFDdefault,
+
+    &dcDDFD60, &dcDDFD61, &dcDDFD62, &dcDDFD63,
+    &dcDDFD64, &dcDDFD65, &dcDDFD66, &dcDDFD67,
+    &dcDDFD68, &dcDDFD69, &dcDDFD6A, &dcDDFD6B,
+    &dcDDFD6C, &dcDDFD6D, &dcDDFD6E, &dcDDFD6F,
+
+    &dcDDFD70, &dcDDFD71, &dcDDFD72, &dcDDFD73,
+    &dcDDFD74, &dcDDFD75, &dcDDFDdefault, &dcDDFD77,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD7C, &dcDDFD7D, &dcDDFD7E, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD84, &dcDDFD85, &dcDDFD86, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD8C, &dcDDFD8D, &dcDDFD8E, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD94, &dcDDFD95, &dcDDFD96, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFD9C, &dcDDFD9D, &dcDDFD9E, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDA4, &dcDDFDA5, &dcDDFDA6, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDAC, &dcDDFDAD, &dcDDFDAE, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDB4, &dcDDFDB5, &dcDDFDB6, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDBC, &dcDDFDBD, &dcDDFDBE, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDCBprefix,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDDD, &dcDDFDdefault, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDE1, &dcDDFDdefault, &dcDDFDE3,
+    &dcDDFDdefault, &dcDDFDE5, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDE9, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDED, &dcDDFDdefault, &dcDDFDdefault,
+
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDF9, &dcDDFDdefault, &dcDDFDdefault,
+    &dcDDFDdefault, &dcDDFDFD, &dcDDFDdefault, &dcDDFDdefault
+};
+
+// Subconjunto de instrucciones 0xDDCB
+void Z80::dcDDFDCB00(uint16_t address)
+{ /* RLC (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    rlc(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB08(uint16_t address)
+{ /* RRC (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    rrc(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB10(uint16_t address)
+{ /* RL (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    rl(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB18(uint16_t address)
+{ /* RR (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    rr(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB20(uint16_t address)
+{ /* SLA (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    sla(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB28(uint16_t address)
+{ /* SRA (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    sra(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB30(uint16_t address)
+{ /* SLL (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    sll(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB38(uint16_t address)
+{ /* SRL (IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address);
+    srl(work8);
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB40(uint16_t address)
+{ /* BIT 0,(IX+d) */
+    bitTest(0x01, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB48(uint16_t address)
+{ /* BIT 1,(IX+d) */
+    bitTest(0x02, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB50(uint16_t address)
+{ /* BIT 2,(IX+d) */
+    bitTest(0x04, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB58(uint16_t address)
+{ /* BIT 3,(IX+d) */
+    bitTest(0x08, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB60(uint16_t address)
+{ /* BIT 4,(IX+d) */
+    bitTest(0x10, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB68(uint16_t address)
+{ /* BIT 5,(IX+d) */
+    bitTest(0x20, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB70(uint16_t address)
+{ /* BIT 6,(IX+d) */
+    bitTest(0x40, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB78(uint16_t address)
+{ /* BIT 7,(IX+d) */
+    bitTest(0x80, Z80Ops::peek8(address));
+    sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
+            | ((address >> 8) & FLAG_53_MASK);
+    Z80Ops::addressOnBus(address, 1);
+}
+
+void Z80::dcDDFDCB80(uint16_t address)
+{ /* RES 0,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0xFE;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB88(uint16_t address)
+{ /* RES 1,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0xFD;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB90(uint16_t address)
+{ /* RES 2,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0xFB;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCB98(uint16_t address)
+{ /* RES 3,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0xF7;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBA0(uint16_t address)
+{ /* RES 4,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0xEF;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBA8(uint16_t address)
+{ /* RES 5,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0xDF;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBB0(uint16_t address)
+{ /* RES 6,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0xBF;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBB8(uint16_t address)
+{ /* RES 7,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) & 0x7F;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBC0(uint16_t address)
+{ /* SET 0,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x01;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBC8(uint16_t address)
+{ /* SET 1,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x02;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBD0(uint16_t address)
+{ /* SET 2,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x04;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBD8(uint16_t address)
+{ /* SET 3,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x08;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBE0(uint16_t address)
+{ /* SET 4,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x10;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBE8(uint16_t address)
+{ /* SET 5,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x20;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBF0(uint16_t address)
+{ /* SET 6,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x40;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void Z80::dcDDFDCBF8(uint16_t address)
+{ /* SET 7,(IX+d),r */
+    uint8_t work8 = Z80Ops::peek8(address) | 0x80;
+    Z80Ops::addressOnBus(address, 1);
+    Z80Ops::poke8(address, work8);
+    copyToRegister(work8);
+}
+
+void (*Z80::dcDDFDCB[256])(uint16_t address) = {
+    &dcDDFDCB00, &dcDDFDCB00, &dcDDFDCB00, &dcDDFDCB00,
+    &dcDDFDCB00, &dcDDFDCB00, &dcDDFDCB00, &dcDDFDCB00,
+    &dcDDFDCB08, &dcDDFDCB08, &dcDDFDCB08, &dcDDFDCB08,
+    &dcDDFDCB08, &dcDDFDCB08, &dcDDFDCB08, &dcDDFDCB08,
+
+    &dcDDFDCB10, &dcDDFDCB10, &dcDDFDCB10, &dcDDFDCB10,
+    &dcDDFDCB10, &dcDDFDCB10, &dcDDFDCB10, &dcDDFDCB10,
+    &dcDDFDCB18, &dcDDFDCB18, &dcDDFDCB18, &dcDDFDCB18,
+    &dcDDFDCB18, &dcDDFDCB18, &dcDDFDCB18, &dcDDFDCB18,
+
+    &dcDDFDCB20, &dcDDFDCB20, &dcDDFDCB20, &dcDDFDCB20,
+    &dcDDFDCB20, &dcDDFDCB20, &dcDDFDCB20, &dcDDFDCB20,
+    &dcDDFDCB28, &dcDDFDCB28, &dcDDFDCB28, &dcDDFDCB28,
+    &dcDDFDCB28, &dcDDFDCB28, &dcDDFDCB28, &dcDDFDCB28,
+
+    &dcDDFDCB30, &dcDDFDCB30, &dcDDFDCB30, &dcDDFDCB30,
+    &dcDDFDCB30, &dcDDFDCB30, &dcDDFDCB30, &dcDDFDCB30,
+    &dcDDFDCB38, &dcDDFDCB38, &dcDDFDCB38, &dcDDFDCB38,
+    &dcDDFDCB38, &dcDDFDCB38, &dcDDFDCB38, &dcDDFDCB38,
+
+    &dcDDFDCB40, &dcDDFDCB40, &dcDDFDCB40, &dcDDFDCB40,
+    &dcDDFDCB40, &dcDDFDCB40, &dcDDFDCB40, &dcDDFDCB40,
+    &dcDDFDCB48, &dcDDFDCB48, &dcDDFDCB48, &dcDDFDCB48,
+    &dcDDFDCB48, &dcDDFDCB48, &dcDDFDCB48, &dcDDFDCB48,
+
+    &dcDDFDCB50, &dcDDFDCB50, &dcDDFDCB50, &dcDDFDCB50,
+    &dcDDFDCB50, &dcDDFDCB50, &dcDDFDCB50, &dcDDFDCB50,
+    &dcDDFDCB58, &dcDDFDCB58, &dcDDFDCB58, &dcDDFDCB58,
+    &dcDDFDCB58, &dcDDFDCB58, &dcDDFDCB58, &dcDDFDCB58,
+
+    &dcDDFDCB60, &dcDDFDCB60, &dcDDFDCB60, &dcDDFDCB60,
+    &dcDDFDCB60, &dcDDFDCB60, &dcDDFDCB60, &dcDDFDCB60,
+    &dcDDFDCB68, &dcDDFDCB68, &dcDDFDCB68, &dcDDFDCB68,
+    &dcDDFDCB68, &dcDDFDCB68, &dcDDFDCB68, &dcDDFDCB68,
+
+    &dcDDFDCB70, &dcDDFDCB70, &dcDDFDCB70, &dcDDFDCB70,
+    &dcDDFDCB70, &dcDDFDCB70, &dcDDFDCB70, &dcDDFDCB70,
+    &dcDDFDCB78, &dcDDFDCB78, &dcDDFDCB78, &dcDDFDCB78,
+    &dcDDFDCB78, &dcDDFDCB78, &dcDDFDCB78, &dcDDFDCB78,
+
+    &dcDDFDCB80, &dcDDFDCB80, &dcDDFDCB80, &dcDDFDCB80,
+    &dcDDFDCB80, &dcDDFDCB80, &dcDDFDCB80, &dcDDFDCB80,
+    &dcDDFDCB88, &dcDDFDCB88, &dcDDFDCB88, &dcDDFDCB88,
+    &dcDDFDCB88, &dcDDFDCB88, &dcDDFDCB88, &dcDDFDCB88,
+
+    &dcDDFDCB90, &dcDDFDCB90, &dcDDFDCB90, &dcDDFDCB90,
+    &dcDDFDCB90, &dcDDFDCB90, &dcDDFDCB90, &dcDDFDCB90,
+    &dcDDFDCB98, &dcDDFDCB98, &dcDDFDCB98, &dcDDFDCB98,
+    &dcDDFDCB98, &dcDDFDCB98, &dcDDFDCB98, &dcDDFDCB98,
+
+    &dcDDFDCBA0, &dcDDFDCBA0, &dcDDFDCBA0, &dcDDFDCBA0,
+    &dcDDFDCBA0, &dcDDFDCBA0, &dcDDFDCBA0, &dcDDFDCBA0,
+    &dcDDFDCBA8, &dcDDFDCBA8, &dcDDFDCBA8, &dcDDFDCBA8,
+    &dcDDFDCBA8, &dcDDFDCBA8, &dcDDFDCBA8, &dcDDFDCBA8,
+
+    &dcDDFDCBB0, &dcDDFDCBB0, &dcDDFDCBB0, &dcDDFDCBB0,
+    &dcDDFDCBB0, &dcDDFDCBB0, &dcDDFDCBB0, &dcDDFDCBB0,
+    &dcDDFDCBB8, &dcDDFDCBB8, &dcDDFDCBB8, &dcDDFDCBB8,
+    &dcDDFDCBB8, &dcDDFDCBB8, &dcDDFDCBB8, &dcDDFDCBB8,
+
+    &dcDDFDCBC0, &dcDDFDCBC0, &dcDDFDCBC0, &dcDDFDCBC0,
+    &dcDDFDCBC0, &dcDDFDCBC0, &dcDDFDCBC0, &dcDDFDCBC0,
+    &dcDDFDCBC8, &dcDDFDCBC8, &dcDDFDCBC8, &dcDDFDCBC8,
+    &dcDDFDCBC8, &dcDDFDCBC8, &dcDDFDCBC8, &dcDDFDCBC8,
+
+    &dcDDFDCBD0, &dcDDFDCBD0, &dcDDFDCBD0, &dcDDFDCBD0,
+    &dcDDFDCBD0, &dcDDFDCBD0, &dcDDFDCBD0, &dcDDFDCBD0,
+    &dcDDFDCBD8, &dcDDFDCBD8, &dcDDFDCBD8, &dcDDFDCBD8,
+    &dcDDFDCBD8, &dcDDFDCBD8, &dcDDFDCBD8, &dcDDFDCBD8,
+
+    &dcDDFDCBE0, &dcDDFDCBE0, &dcDDFDCBE0, &dcDDFDCBE0,
+    &dcDDFDCBE0, &dcDDFDCBE0, &dcDDFDCBE0, &dcDDFDCBE0,
+    &dcDDFDCBE8, &dcDDFDCBE8, &dcDDFDCBE8, &dcDDFDCBE8,
+    &dcDDFDCBE8, &dcDDFDCBE8, &dcDDFDCBE8, &dcDDFDCBE8,
+
+    &dcDDFDCBF0, &dcDDFDCBF0, &dcDDFDCBF0, &dcDDFDCBF0,
+    &dcDDFDCBF0, &dcDDFDCBF0, &dcDDFDCBF0, &dcDDFDCBF0,
+    &dcDDFDCBF8, &dcDDFDCBF8, &dcDDFDCBF8, &dcDDFDCBF8,
+    &dcDDFDCBF8, &dcDDFDCBF8, &dcDDFDCBF8, &dcDDFDCBF8
+};
+
+//Subconjunto de instrucciones 0xED
+
+void Z80::dcED40(void)
+{ /* IN B,(C) */
+    REG_WZ = REG_BC;
+    REG_B = Ports::input(REG_WZ);
+    REG_WZ++;
+    sz5h3pnFlags = sz53pn_addTable[REG_B];
+    flagQ = true;
+}
+
+void Z80::dcED41(void)
+{ /* OUT (C),B */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ, REG_B);
+    // REG_WZ++;
+
+    Ports::output(REG_BC, REG_B);
+    REG_WZ = REG_BC + 1;
+}
+
+void Z80::dcED42(void)
+{ /* SBC HL,BC */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    sbc16(REG_BC);
+}
+
+void Z80::dcED43(void)
+{ /* LD (nn),BC */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    Z80Ops::poke16(REG_WZ, regBC);
+    REG_WZ++;
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcED44(void)
+{ /* NEG */
+    uint8_t aux = regA;
+    regA = 0;
+    carryFlag = false;
+    sbc(aux);
+}
+
+void Z80::dcED4D(void)
+{ /* RETI */
+    ffIFF1 = ffIFF2;
+    REG_PC = REG_WZ = pop();
+    check_trdos();
+}
+
+void Z80::dcED45(void)
+{ /* RETN */
+    ffIFF1 = ffIFF2;
+    REG_PC = REG_WZ = pop();
+    check_trdos();
+}
+
+void Z80::dcED46(void)
+{ /* IM 0 */
+    modeINT = IntMode::IM0;
+}
+
+void Z80::dcED47(void)
+{ /* LD I,A */
+    /*
+     * El par IR se pone en el bus de direcciones *antes*
+     * de poner A en el registro I. Detalle importante.
+     */
+    Z80Ops::addressOnBus(getPairIR().word, 1);
+    regI = regA;
+}
+
+void Z80::dcED48(void)
+{ /* IN C,(C) */
+    REG_WZ = REG_BC;
+    REG_C = Ports::input(REG_WZ);
+    REG_WZ++;
+    sz5h3pnFlags = sz53pn_addTable[REG_C];
+    flagQ = true;
+}
+
+void Z80::dcED49(void)
+{ /* OUT (C),C */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ, REG_C);
+    // REG_WZ++;
+
+    Ports::output(REG_BC, REG_C);
+    REG_WZ = REG_BC + 1;
+}
+
+void Z80::dcED4A(void)
+{ /* ADC HL,BC */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    adc16(REG_BC);
+}
+
+void Z80::dcED4B(void)
+{ /* LD BC,(nn) */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    REG_BC = Z80Ops::peek16(REG_WZ);
+    REG_WZ++;
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcED4F(void)
+{ /* LD R,A */
+    /*
+     * El par IR se pone en el bus de direcciones *antes*
+     * de poner A en el registro R. Detalle importante.
+     */
+    Z80Ops::addressOnBus(getPairIR().word, 1);
+    setRegR(regA);
+}
+
+void Z80::dcED50(void)
+{ /* IN D,(C) */
+    REG_WZ = REG_BC;
+    REG_D = Ports::input(REG_WZ);
+    REG_WZ++;
+    sz5h3pnFlags = sz53pn_addTable[REG_D];
+    flagQ = true;
+}
+
+void Z80::dcED51(void)
+{ /* OUT (C),D */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ++, REG_D);
+
+    Ports::output(REG_BC, REG_D);
+    REG_WZ = REG_BC + 1;
+}
+
+void Z80::dcED52(void)
+{ /* SBC HL,DE */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    sbc16(REG_DE);
+}
+
+void Z80::dcED53(void)
+{ /* LD (nn),DE */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    Z80Ops::poke16(REG_WZ++, regDE);
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcED56(void)
+{ /* IM 1 */
+    modeINT = IntMode::IM1;
+}
+
+void Z80::dcED57(void)
+{ /* LD A,I */
+    Z80Ops::addressOnBus(getPairIR().word, 1);
+    regA = regI;
+    sz5h3pnFlags = sz53n_addTable[regA];
+    if (ffIFF2 && !Z80Ops::isActiveINT()) {
+        sz5h3pnFlags |= PARITY_MASK;
+    }
+    flagQ = true;
+}
+
+void Z80::dcED58(void)
+{ /* IN E,(C) */
+    REG_WZ = REG_BC;
+    REG_E = Ports::input(REG_WZ++);
+    sz5h3pnFlags = sz53pn_addTable[REG_E];
+    flagQ = true;
+}
+
+void Z80::dcED59(void)
+{ /* OUT (C),E */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ++, REG_E);
+
+    Ports::output(REG_BC, REG_E);
+    REG_WZ = REG_BC + 1;
+}
+
+void Z80::dcED5A(void)
+{ /* ADC HL,DE */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    adc16(REG_DE);
+}
+
+void Z80::dcED5B(void)
+{ /* LD DE,(nn) */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    REG_DE = Z80Ops::peek16(REG_WZ++);
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcED5E(void)
+{ /* IM 2 */
+    modeINT = IntMode::IM2;
+}
+
+void Z80::dcED5F(void)
+{ /* LD A,R */
+    Z80Ops::addressOnBus(getPairIR().word, 1);
+    regA = getRegR();
+    sz5h3pnFlags = sz53n_addTable[regA];
+    if (ffIFF2 && !Z80Ops::isActiveINT()) {
+        sz5h3pnFlags |= PARITY_MASK;
     }
+    flagQ = true;
+}
+
+void Z80::dcED60(void)
+{ /* IN H,(C) */
+    REG_WZ = REG_BC;
+    REG_H = Ports::input(REG_WZ++);
+    sz5h3pnFlags = sz53pn_addTable[REG_H];
+    flagQ = true;
+}
+
+void Z80::dcED61(void)
+{ /* OUT (C),H */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ++, REG_H);
+
+    Ports::output(REG_BC, REG_H);
+    REG_WZ = REG_BC + 1;
+}
+
+void Z80::dcED62(void)
+{ /* SBC HL,HL */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    sbc16(REG_HL);
+}
+
+void Z80::dcED63(void)
+{ /* LD (nn),HL */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    Z80Ops::poke16(REG_WZ++, regHL);
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcED67(void)
+{ /* RRD */
+    // A = A7 A6 A5 A4 (HL)3 (HL)2 (HL)1 (HL)0
+    // (HL) = A3 A2 A1 A0 (HL)7 (HL)6 (HL)5 (HL)4
+    // Los bits 3,2,1 y 0 de (HL) se copian a los bits 3,2,1 y 0 de A.
+    // Los 4 bits bajos que había en A se copian a los bits 7,6,5 y 4 de (HL).
+    // Los 4 bits altos que había en (HL) se copian a los 4 bits bajos de (HL)
+    // Los 4 bits superiores de A no se tocan. ¡p'habernos matao!
+    uint8_t aux = regA << 4;
+    REG_WZ = REG_HL;
+    uint16_t memHL = Z80Ops::peek8(REG_WZ);
+    regA = (regA & 0xf0) | (memHL & 0x0f);
+    Z80Ops::addressOnBus(REG_WZ, 4);
+    Z80Ops::poke8(REG_WZ++, (memHL >> 4) | aux);
+    sz5h3pnFlags = sz53pn_addTable[regA];
+    flagQ = true;
+}
+
+void Z80::dcED68(void)
+{ /* IN L,(C) */
+    REG_WZ = REG_BC;
+    REG_L = Ports::input(REG_WZ++);
+    sz5h3pnFlags = sz53pn_addTable[REG_L];
+    flagQ = true;
+}
+
+void Z80::dcED69(void)
+{ /* OUT (C),L */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ++, REG_L);
+
+    Ports::output(REG_BC, REG_L);
+    REG_WZ = REG_BC + 1;
+}
+
+void Z80::dcED6A(void)
+{ /* ADC HL,HL */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    adc16(REG_HL);
+}
+
+void Z80::dcED6B(void)
+{ /* LD HL,(nn) */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    REG_HL = Z80Ops::peek16(REG_WZ++);
+    REG_PC = REG_PC + 2;
+}
+
+void Z80::dcED6F(void)
+{ /* RLD */
+    // A = A7 A6 A5 A4 (HL)7 (HL)6 (HL)5 (HL)4
+    // (HL) = (HL)3 (HL)2 (HL)1 (HL)0 A3 A2 A1 A0
+    // Los 4 bits bajos que había en (HL) se copian a los bits altos de (HL).
+    // Los 4 bits altos que había en (HL) se copian a los 4 bits bajos de A
+    // Los bits 3,2,1 y 0 de A se copian a los bits 3,2,1 y 0 de (HL).
+    // Los 4 bits superiores de A no se tocan. ¡p'habernos matao!
+    uint8_t aux = regA & 0x0f;
+    REG_WZ = REG_HL;
+    uint16_t memHL = Z80Ops::peek8(REG_WZ);
+    regA = (regA & 0xf0) | (memHL >> 4);
+    Z80Ops::addressOnBus(REG_WZ, 4);
+    Z80Ops::poke8(REG_WZ++, (memHL << 4) | aux);
+    sz5h3pnFlags = sz53pn_addTable[regA];
+    flagQ = true;
+}
+
+void Z80::dcED70(void)
+{ /* IN (C) */
+    REG_WZ = REG_BC;
+    uint8_t inPort = Ports::input(REG_WZ++);
+    sz5h3pnFlags = sz53pn_addTable[inPort];
+    flagQ = true;
 }
 
-// Subconjunto de instrucciones 0xDDCB
-void Z80::decodeDDFDCB(uint16_t address) {
-
-    switch (opCode) {
-        case 0x00: /* RLC (IX+d),B */
-        case 0x01: /* RLC (IX+d),C */
-        case 0x02: /* RLC (IX+d),D */
-        case 0x03: /* RLC (IX+d),E */
-        case 0x04: /* RLC (IX+d),H */
-        case 0x05: /* RLC (IX+d),L */
-        case 0x06: /* RLC (IX+d)   */
-        case 0x07: /* RLC (IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address);
-            rlc(work8);
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x08: /* RRC (IX+d),B */
-        case 0x09: /* RRC (IX+d),C */
-        case 0x0A: /* RRC (IX+d),D */
-        case 0x0B: /* RRC (IX+d),E */
-        case 0x0C: /* RRC (IX+d),H */
-        case 0x0D: /* RRC (IX+d),L */
-        case 0x0E: /* RRC (IX+d)   */
-        case 0x0F: /* RRC (IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address);
-            rrc(work8);
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x10: /* RL (IX+d),B */
-        case 0x11: /* RL (IX+d),C */
-        case 0x12: /* RL (IX+d),D */
-        case 0x13: /* RL (IX+d),E */
-        case 0x14: /* RL (IX+d),H */
-        case 0x15: /* RL (IX+d),L */
-        case 0x16: /* RL (IX+d)   */
-        case 0x17: /* RL (IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address);
-            rl(work8);
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x18: /* RR (IX+d),B */
-        case 0x19: /* RR (IX+d),C */
-        case 0x1A: /* RR (IX+d),D */
-        case 0x1B: /* RR (IX+d),E */
-        case 0x1C: /* RR (IX+d),H */
-        case 0x1D: /* RR (IX+d),L */
-        case 0x1E: /* RR (IX+d)   */
-        case 0x1F: /* RR (IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address);
-            rr(work8);
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x20: /* SLA (IX+d),B */
-        case 0x21: /* SLA (IX+d),C */
-        case 0x22: /* SLA (IX+d),D */
-        case 0x23: /* SLA (IX+d),E */
-        case 0x24: /* SLA (IX+d),H */
-        case 0x25: /* SLA (IX+d),L */
-        case 0x26: /* SLA (IX+d)   */
-        case 0x27: /* SLA (IX+d),A */
-        {
-             uint8_t work8 = Z80Ops::peek8(address);
-             sla(work8);
-             Z80Ops::addressOnBus(address, 1);
-             Z80Ops::poke8(address, work8);
-             copyToRegister(work8);
-            break;
-        }
-        case 0x28: /* SRA (IX+d),B */
-        case 0x29: /* SRA (IX+d),C */
-        case 0x2A: /* SRA (IX+d),D */
-        case 0x2B: /* SRA (IX+d),E */
-        case 0x2C: /* SRA (IX+d),H */
-        case 0x2D: /* SRA (IX+d),L */
-        case 0x2E: /* SRA (IX+d)   */
-        case 0x2F: /* SRA (IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address);
-            sra(work8);
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x30: /* SLL (IX+d),B */
-        case 0x31: /* SLL (IX+d),C */
-        case 0x32: /* SLL (IX+d),D */
-        case 0x33: /* SLL (IX+d),E */
-        case 0x34: /* SLL (IX+d),H */
-        case 0x35: /* SLL (IX+d),L */
-        case 0x36: /* SLL (IX+d)   */
-        case 0x37: /* SLL (IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address);
-            sll(work8);
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x38: /* SRL (IX+d),B */
-        case 0x39: /* SRL (IX+d),C */
-        case 0x3A: /* SRL (IX+d),D */
-        case 0x3B: /* SRL (IX+d),E */
-        case 0x3C: /* SRL (IX+d),H */
-        case 0x3D: /* SRL (IX+d),L */
-        case 0x3E: /* SRL (IX+d)   */
-        case 0x3F: /* SRL (IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address);
-            srl(work8);
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x40:
-        case 0x41:
-        case 0x42:
-        case 0x43:
-        case 0x44:
-        case 0x45:
-        case 0x46:
-        case 0x47:
-        { /* BIT 0,(IX+d) */
-            bitTest(0x01, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x48:
-        case 0x49:
-        case 0x4A:
-        case 0x4B:
-        case 0x4C:
-        case 0x4D:
-        case 0x4E:
-        case 0x4F:
-        { /* BIT 1,(IX+d) */
-            bitTest(0x02, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x50:
-        case 0x51:
-        case 0x52:
-        case 0x53:
-        case 0x54:
-        case 0x55:
-        case 0x56:
-        case 0x57:
-        { /* BIT 2,(IX+d) */
-            bitTest(0x04, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x58:
-        case 0x59:
-        case 0x5A:
-        case 0x5B:
-        case 0x5C:
-        case 0x5D:
-        case 0x5E:
-        case 0x5F:
-        { /* BIT 3,(IX+d) */
-            bitTest(0x08, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x60:
-        case 0x61:
-        case 0x62:
-        case 0x63:
-        case 0x64:
-        case 0x65:
-        case 0x66:
-        case 0x67:
-        { /* BIT 4,(IX+d) */
-            bitTest(0x10, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x68:
-        case 0x69:
-        case 0x6A:
-        case 0x6B:
-        case 0x6C:
-        case 0x6D:
-        case 0x6E:
-        case 0x6F:
-        { /* BIT 5,(IX+d) */
-            bitTest(0x20, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x70:
-        case 0x71:
-        case 0x72:
-        case 0x73:
-        case 0x74:
-        case 0x75:
-        case 0x76:
-        case 0x77:
-        { /* BIT 6,(IX+d) */
-            bitTest(0x40, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x78:
-        case 0x79:
-        case 0x7A:
-        case 0x7B:
-        case 0x7C:
-        case 0x7D:
-        case 0x7E:
-        case 0x7F:
-        { /* BIT 7,(IX+d) */
-            bitTest(0x80, Z80Ops::peek8(address));
-            sz5h3pnFlags = (sz5h3pnFlags & FLAG_SZHP_MASK)
-                    | ((address >> 8) & FLAG_53_MASK);
-            Z80Ops::addressOnBus(address, 1);
-            break;
-        }
-        case 0x80: /* RES 0,(IX+d),B */
-        case 0x81: /* RES 0,(IX+d),C */
-        case 0x82: /* RES 0,(IX+d),D */
-        case 0x83: /* RES 0,(IX+d),E */
-        case 0x84: /* RES 0,(IX+d),H */
-        case 0x85: /* RES 0,(IX+d),L */
-        case 0x86: /* RES 0,(IX+d)   */
-        case 0x87: /* RES 0,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0xFE;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x88: /* RES 1,(IX+d),B */
-        case 0x89: /* RES 1,(IX+d),C */
-        case 0x8A: /* RES 1,(IX+d),D */
-        case 0x8B: /* RES 1,(IX+d),E */
-        case 0x8C: /* RES 1,(IX+d),H */
-        case 0x8D: /* RES 1,(IX+d),L */
-        case 0x8E: /* RES 1,(IX+d)   */
-        case 0x8F: /* RES 1,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0xFD;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x90: /* RES 2,(IX+d),B */
-        case 0x91: /* RES 2,(IX+d),C */
-        case 0x92: /* RES 2,(IX+d),D */
-        case 0x93: /* RES 2,(IX+d),E */
-        case 0x94: /* RES 2,(IX+d),H */
-        case 0x95: /* RES 2,(IX+d),L */
-        case 0x96: /* RES 2,(IX+d)   */
-        case 0x97: /* RES 2,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0xFB;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0x98: /* RES 3,(IX+d),B */
-        case 0x99: /* RES 3,(IX+d),C */
-        case 0x9A: /* RES 3,(IX+d),D */
-        case 0x9B: /* RES 3,(IX+d),E */
-        case 0x9C: /* RES 3,(IX+d),H */
-        case 0x9D: /* RES 3,(IX+d),L */
-        case 0x9E: /* RES 3,(IX+d)   */
-        case 0x9F: /* RES 3,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0xF7;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xA0: /* RES 4,(IX+d),B */
-        case 0xA1: /* RES 4,(IX+d),C */
-        case 0xA2: /* RES 4,(IX+d),D */
-        case 0xA3: /* RES 4,(IX+d),E */
-        case 0xA4: /* RES 4,(IX+d),H */
-        case 0xA5: /* RES 4,(IX+d),L */
-        case 0xA6: /* RES 4,(IX+d)   */
-        case 0xA7: /* RES 4,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0xEF;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xA8: /* RES 5,(IX+d),B */
-        case 0xA9: /* RES 5,(IX+d),C */
-        case 0xAA: /* RES 5,(IX+d),D */
-        case 0xAB: /* RES 5,(IX+d),E */
-        case 0xAC: /* RES 5,(IX+d),H */
-        case 0xAD: /* RES 5,(IX+d),L */
-        case 0xAE: /* RES 5,(IX+d)   */
-        case 0xAF: /* RES 5,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0xDF;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xB0: /* RES 6,(IX+d),B */
-        case 0xB1: /* RES 6,(IX+d),C */
-        case 0xB2: /* RES 6,(IX+d),D */
-        case 0xB3: /* RES 6,(IX+d),E */
-        case 0xB4: /* RES 6,(IX+d),H */
-        case 0xB5: /* RES 6,(IX+d),L */
-        case 0xB6: /* RES 6,(IX+d)   */
-        case 0xB7: /* RES 6,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0xBF;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xB8: /* RES 7,(IX+d),B */
-        case 0xB9: /* RES 7,(IX+d),C */
-        case 0xBA: /* RES 7,(IX+d),D */
-        case 0xBB: /* RES 7,(IX+d),E */
-        case 0xBC: /* RES 7,(IX+d),H */
-        case 0xBD: /* RES 7,(IX+d),L */
-        case 0xBE: /* RES 7,(IX+d)   */
-        case 0xBF: /* RES 7,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) & 0x7F;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xC0: /* SET 0,(IX+d),B */
-        case 0xC1: /* SET 0,(IX+d),C */
-        case 0xC2: /* SET 0,(IX+d),D */
-        case 0xC3: /* SET 0,(IX+d),E */
-        case 0xC4: /* SET 0,(IX+d),H */
-        case 0xC5: /* SET 0,(IX+d),L */
-        case 0xC6: /* SET 0,(IX+d)   */
-        case 0xC7: /* SET 0,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x01;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xC8: /* SET 1,(IX+d),B */
-        case 0xC9: /* SET 1,(IX+d),C */
-        case 0xCA: /* SET 1,(IX+d),D */
-        case 0xCB: /* SET 1,(IX+d),E */
-        case 0xCC: /* SET 1,(IX+d),H */
-        case 0xCD: /* SET 1,(IX+d),L */
-        case 0xCE: /* SET 1,(IX+d)   */
-        case 0xCF: /* SET 1,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x02;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xD0: /* SET 2,(IX+d),B */
-        case 0xD1: /* SET 2,(IX+d),C */
-        case 0xD2: /* SET 2,(IX+d),D */
-        case 0xD3: /* SET 2,(IX+d),E */
-        case 0xD4: /* SET 2,(IX+d),H */
-        case 0xD5: /* SET 2,(IX+d),L */
-        case 0xD6: /* SET 2,(IX+d)   */
-        case 0xD7: /* SET 2,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x04;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xD8: /* SET 3,(IX+d),B */
-        case 0xD9: /* SET 3,(IX+d),C */
-        case 0xDA: /* SET 3,(IX+d),D */
-        case 0xDB: /* SET 3,(IX+d),E */
-        case 0xDC: /* SET 3,(IX+d),H */
-        case 0xDD: /* SET 3,(IX+d),L */
-        case 0xDE: /* SET 3,(IX+d)   */
-        case 0xDF: /* SET 3,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x08;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xE0: /* SET 4,(IX+d),B */
-        case 0xE1: /* SET 4,(IX+d),C */
-        case 0xE2: /* SET 4,(IX+d),D */
-        case 0xE3: /* SET 4,(IX+d),E */
-        case 0xE4: /* SET 4,(IX+d),H */
-        case 0xE5: /* SET 4,(IX+d),L */
-        case 0xE6: /* SET 4,(IX+d)   */
-        case 0xE7: /* SET 4,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x10;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xE8: /* SET 5,(IX+d),B */
-        case 0xE9: /* SET 5,(IX+d),C */
-        case 0xEA: /* SET 5,(IX+d),D */
-        case 0xEB: /* SET 5,(IX+d),E */
-        case 0xEC: /* SET 5,(IX+d),H */
-        case 0xED: /* SET 5,(IX+d),L */
-        case 0xEE: /* SET 5,(IX+d)   */
-        case 0xEF: /* SET 5,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x20;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xF0: /* SET 6,(IX+d),B */
-        case 0xF1: /* SET 6,(IX+d),C */
-        case 0xF2: /* SET 6,(IX+d),D */
-        case 0xF3: /* SET 6,(IX+d),E */
-        case 0xF4: /* SET 6,(IX+d),H */
-        case 0xF5: /* SET 6,(IX+d),L */
-        case 0xF6: /* SET 6,(IX+d)   */
-        case 0xF7: /* SET 6,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x40;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-        case 0xF8: /* SET 7,(IX+d),B */
-        case 0xF9: /* SET 7,(IX+d),C */
-        case 0xFA: /* SET 7,(IX+d),D */
-        case 0xFB: /* SET 7,(IX+d),E */
-        case 0xFC: /* SET 7,(IX+d),H */
-        case 0xFD: /* SET 7,(IX+d),L */
-        case 0xFE: /* SET 7,(IX+d)   */
-        case 0xFF: /* SET 7,(IX+d),A */
-        {
-            uint8_t work8 = Z80Ops::peek8(address) | 0x80;
-            Z80Ops::addressOnBus(address, 1);
-            Z80Ops::poke8(address, work8);
-            copyToRegister(work8);
-            break;
-        }
-    }
+void Z80::dcED71(void)
+{ /* OUT (C),0 */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ++, 0x00);
+
+    Ports::output(REG_BC, 0x00); // NMOS Z80 returns 0x00
+    // Ports::output(REG_BC, 0xFF); // CMOS Z80 returns 0xFF
+
+    REG_WZ = REG_BC + 1;
 }
 
-//Subconjunto de instrucciones 0xED
+void Z80::dcED72(void)
+{ /* SBC HL,SP */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    sbc16(REG_SP);
+}
 
-void Z80::decodeED(void) {
-    switch (opCode) {
-        case 0x40:
-        { /* IN B,(C) */
-            REG_WZ = REG_BC;
-            REG_B = Ports::input(REG_WZ);
-            REG_WZ++;
-            sz5h3pnFlags = sz53pn_addTable[REG_B];
-            flagQ = true;
-            break;
-        }
-        case 0x41:
-        { /* OUT (C),B */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ, REG_B);
-            // REG_WZ++;
+void Z80::dcED73(void)
+{ /* LD (nn),SP */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    Z80Ops::poke16(REG_WZ++, regSP);
+    REG_PC = REG_PC + 2;
+}
 
-            Ports::output(REG_BC, REG_B);
-            REG_WZ = REG_BC + 1;
+void Z80::dcED78(void)
+{ /* IN A,(C) */
+    REG_WZ = REG_BC;
+    regA = Ports::input(REG_WZ++);
+    sz5h3pnFlags = sz53pn_addTable[regA];
+    flagQ = true;
+}
 
-            return;
-            // break;
-        }
-        case 0x42:
-        { /* SBC HL,BC */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            sbc16(REG_BC);
-            break;
-        }
-        case 0x43:
-        { /* LD (nn),BC */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            Z80Ops::poke16(REG_WZ, regBC);
-            REG_WZ++;
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x44:
-        case 0x4C:
-        case 0x54:
-        case 0x5C:
-        case 0x64:
-        case 0x6C:
-        case 0x74:
-        case 0x7C:
-        { /* NEG */
-            uint8_t aux = regA;
-            regA = 0;
-            carryFlag = false;
-            sbc(aux);
-            break;
-        }
-        case 0x4D:
-        { /* RETI */
-            ffIFF1 = ffIFF2;
-            REG_PC = REG_WZ = pop();
-            check_trdos();
-            break;
-        }
-        case 0x45:
-        case 0x55:
-        case 0x5D:
-        case 0x65:
-        case 0x6D:
-        case 0x75:
-        case 0x7D:
-        { /* RETN */
-            ffIFF1 = ffIFF2;
-            REG_PC = REG_WZ = pop();
-            check_trdos();
-            break;
-        }
-        case 0x46:
-        case 0x4E:
-        case 0x66:
-        case 0x6E:
-        { /* IM 0 */
-            modeINT = IntMode::IM0;
-            break;
-        }
-        case 0x47:
-        { /* LD I,A */
-            /*
-             * El par IR se pone en el bus de direcciones *antes*
-             * de poner A en el registro I. Detalle importante.
-             */
-            Z80Ops::addressOnBus(getPairIR().word, 1);
-            regI = regA;
-            break;
-        }
-        case 0x48:
-        { /* IN C,(C) */
-            REG_WZ = REG_BC;
-            REG_C = Ports::input(REG_WZ);
-            REG_WZ++;
-            sz5h3pnFlags = sz53pn_addTable[REG_C];
-            flagQ = true;
-            break;
-        }
-        case 0x49:
-        { /* OUT (C),C */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ, REG_C);
-            // REG_WZ++;
+void Z80::dcED79(void)
+{ /* OUT (C),A */
+    // REG_WZ = REG_BC;
+    // Ports::output(REG_WZ++, regA);
 
-            Ports::output(REG_BC, REG_C);
-            REG_WZ = REG_BC + 1;
+    Ports::output(REG_BC, regA);
+    REG_WZ = REG_BC + 1;
+}
 
-            return;
-            // break;
+void Z80::dcED7A(void)
+{ /* ADC HL,SP */
+    Z80Ops::addressOnBus(getPairIR().word, 7);
+    adc16(REG_SP);
+}
 
-        }
-        case 0x4A:
-        { /* ADC HL,BC */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            adc16(REG_BC);
-            break;
-        }
-        case 0x4B:
-        { /* LD BC,(nn) */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            REG_BC = Z80Ops::peek16(REG_WZ);
-            REG_WZ++;
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x4F:
-        { /* LD R,A */
-            /*
-             * El par IR se pone en el bus de direcciones *antes*
-             * de poner A en el registro R. Detalle importante.
-             */
-            Z80Ops::addressOnBus(getPairIR().word, 1);
-            setRegR(regA);
-            break;
-        }
-        case 0x50:
-        { /* IN D,(C) */
-            REG_WZ = REG_BC;
-            REG_D = Ports::input(REG_WZ);
-            REG_WZ++;
-            sz5h3pnFlags = sz53pn_addTable[REG_D];
-            flagQ = true;
-            break;
-        }
-        case 0x51:
-        { /* OUT (C),D */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ++, REG_D);
+void Z80::dcED7B(void)
+{ /* LD SP,(nn) */
+    REG_WZ = Z80Ops::peek16(REG_PC);
+    REG_SP = Z80Ops::peek16(REG_WZ++);
+    REG_PC = REG_PC + 2;
+}
 
-            Ports::output(REG_BC, REG_D);
-            REG_WZ = REG_BC + 1;
+void Z80::dcEDA0(void)
+{ /* LDI */
+    ldi();
+}
 
-            return;
-            // break;
-        }
-        case 0x52:
-        { /* SBC HL,DE */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            sbc16(REG_DE);
-            break;
-        }
-        case 0x53:
-        { /* LD (nn),DE */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            Z80Ops::poke16(REG_WZ++, regDE);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x56:
-        case 0x76:
-        { /* IM 1 */
-            modeINT = IntMode::IM1;
-            break;
-        }
-        case 0x57:
-        { /* LD A,I */
-            Z80Ops::addressOnBus(getPairIR().word, 1);
-            regA = regI;
-            sz5h3pnFlags = sz53n_addTable[regA];
-            if (ffIFF2 && !Z80Ops::isActiveINT()) {
-                sz5h3pnFlags |= PARITY_MASK;
-            }
-            flagQ = true;
-            break;
-        }
-        case 0x58:
-        { /* IN E,(C) */
-            REG_WZ = REG_BC;
-            REG_E = Ports::input(REG_WZ++);
-            sz5h3pnFlags = sz53pn_addTable[REG_E];
-            flagQ = true;
-            break;
-        }
-        case 0x59:
-        { /* OUT (C),E */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ++, REG_E);
+void Z80::dcEDA1(void)
+{ /* CPI */
+    cpi();
+}
 
-            Ports::output(REG_BC, REG_E);
-            REG_WZ = REG_BC + 1;
+void Z80::dcEDA2(void)
+{ /* INI */
+    ini();
+}
 
-            return;
-            // break;
-        }
-        case 0x5A:
-        { /* ADC HL,DE */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            adc16(REG_DE);
-            break;
-        }
-        case 0x5B:
-        { /* LD DE,(nn) */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            REG_DE = Z80Ops::peek16(REG_WZ++);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x5E:
-        case 0x7E:
-        { /* IM 2 */
-            modeINT = IntMode::IM2;
-            break;
-        }
-        case 0x5F:
-        { /* LD A,R */
-            Z80Ops::addressOnBus(getPairIR().word, 1);
-            regA = getRegR();
-            sz5h3pnFlags = sz53n_addTable[regA];
-            if (ffIFF2 && !Z80Ops::isActiveINT()) {
-                sz5h3pnFlags |= PARITY_MASK;
-            }
-            flagQ = true;
-            break;
-        }
-        case 0x60:
-        { /* IN H,(C) */
-            REG_WZ = REG_BC;
-            REG_H = Ports::input(REG_WZ++);
-            sz5h3pnFlags = sz53pn_addTable[REG_H];
-            flagQ = true;
-            break;
-        }
-        case 0x61:
-        { /* OUT (C),H */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ++, REG_H);
+void Z80::dcEDA3(void)
+{ /* OUTI */
+    outi();
+}
 
-            Ports::output(REG_BC, REG_H);
-            REG_WZ = REG_BC + 1;
+void Z80::dcEDA8(void)
+{ /* LDD */
+    ldd();
+}
 
-            return;
-            // break;
-        }
-        case 0x62:
-        { /* SBC HL,HL */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            sbc16(REG_HL);
-            break;
-        }
-        case 0x63:
-        { /* LD (nn),HL */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            Z80Ops::poke16(REG_WZ++, regHL);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x67:
-        { /* RRD */
-            // A = A7 A6 A5 A4 (HL)3 (HL)2 (HL)1 (HL)0
-            // (HL) = A3 A2 A1 A0 (HL)7 (HL)6 (HL)5 (HL)4
-            // Los bits 3,2,1 y 0 de (HL) se copian a los bits 3,2,1 y 0 de A.
-            // Los 4 bits bajos que había en A se copian a los bits 7,6,5 y 4 de (HL).
-            // Los 4 bits altos que había en (HL) se copian a los 4 bits bajos de (HL)
-            // Los 4 bits superiores de A no se tocan. ¡p'habernos matao!
-            uint8_t aux = regA << 4;
-            REG_WZ = REG_HL;
-            uint16_t memHL = Z80Ops::peek8(REG_WZ);
-            regA = (regA & 0xf0) | (memHL & 0x0f);
-            Z80Ops::addressOnBus(REG_WZ, 4);
-            Z80Ops::poke8(REG_WZ++, (memHL >> 4) | aux);
-            sz5h3pnFlags = sz53pn_addTable[regA];
-            flagQ = true;
-            break;
-        }
-        case 0x68:
-        { /* IN L,(C) */
-            REG_WZ = REG_BC;
-            REG_L = Ports::input(REG_WZ++);
-            sz5h3pnFlags = sz53pn_addTable[REG_L];
-            flagQ = true;
-            break;
-        }
-        case 0x69:
-        { /* OUT (C),L */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ++, REG_L);
+void Z80::dcEDA9(void)
+{ /* CPD */
+    cpd();
+}
 
-            Ports::output(REG_BC, REG_L);
-            REG_WZ = REG_BC + 1;
+void Z80::dcEDAA(void)
+{ /* IND */
+    ind();
+}
 
-            return;
-            // break;
-        }
-        case 0x6A:
-        { /* ADC HL,HL */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            adc16(REG_HL);
-            break;
-        }
-        case 0x6B:
-        { /* LD HL,(nn) */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            REG_HL = Z80Ops::peek16(REG_WZ++);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x6F:
-        { /* RLD */
-            // A = A7 A6 A5 A4 (HL)7 (HL)6 (HL)5 (HL)4
-            // (HL) = (HL)3 (HL)2 (HL)1 (HL)0 A3 A2 A1 A0
-            // Los 4 bits bajos que había en (HL) se copian a los bits altos de (HL).
-            // Los 4 bits altos que había en (HL) se copian a los 4 bits bajos de A
-            // Los bits 3,2,1 y 0 de A se copian a los bits 3,2,1 y 0 de (HL).
-            // Los 4 bits superiores de A no se tocan. ¡p'habernos matao!
-            uint8_t aux = regA & 0x0f;
-            REG_WZ = REG_HL;
-            uint16_t memHL = Z80Ops::peek8(REG_WZ);
-            regA = (regA & 0xf0) | (memHL >> 4);
-            Z80Ops::addressOnBus(REG_WZ, 4);
-            Z80Ops::poke8(REG_WZ++, (memHL << 4) | aux);
-            sz5h3pnFlags = sz53pn_addTable[regA];
-            flagQ = true;
-            break;
-        }
-        case 0x70:
-        { /* IN (C) */
-            REG_WZ = REG_BC;
-            uint8_t inPort = Ports::input(REG_WZ++);
-            sz5h3pnFlags = sz53pn_addTable[inPort];
-            flagQ = true;
-            break;
-        }
-        case 0x71:
-        { /* OUT (C),0 */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ++, 0x00);
+void Z80::dcEDAB(void)
+{ /* OUTD */
+    outd();
+}
+
+void Z80::dcEDB0(void)
+{ /* LDIR */
+    ldi();
+    if (REG_BC != 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_DE - 1, 5);
+        sz5h3pnFlags &= ~FLAG_53_MASK;
+        sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
+    }
+}
 
-            Ports::output(REG_BC, 0x00); // NMOS Z80 returns 0x00
-            // Ports::output(REG_BC, 0xFF); // CMOS Z80 returns 0xFF
+void Z80::dcEDB1(void)
+{ /* CPIR */
+    cpi();
+    if ((sz5h3pnFlags & PARITY_MASK) == PARITY_MASK
+            && (sz5h3pnFlags & ZERO_MASK) == 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_HL - 1, 5);
+        sz5h3pnFlags &= ~FLAG_53_MASK;
+        sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
+    }
+}
 
-            REG_WZ = REG_BC + 1;
+void Z80::dcEDB2(void)
+{ /* INIR */
+    ini();
+    if (REG_B != 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_HL - 1, 5);
+        SetAbortedINxR_OTxRFlags();
+    }
+}
 
-            return;
-            // break;
-        }
-        case 0x72:
-        { /* SBC HL,SP */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            sbc16(REG_SP);
-            break;
-        }
-        case 0x73:
-        { /* LD (nn),SP */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            Z80Ops::poke16(REG_WZ++, regSP);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0x78:
-        { /* IN A,(C) */
-            REG_WZ = REG_BC;
-            regA = Ports::input(REG_WZ++);
-            sz5h3pnFlags = sz53pn_addTable[regA];
-            flagQ = true;
-            break;
-        }
-        case 0x79:
-        { /* OUT (C),A */
-            // REG_WZ = REG_BC;
-            // Ports::output(REG_WZ++, regA);
+void Z80::dcEDB3(void)
+{ /* OTIR */
+    outi();
+    if (REG_B != 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_BC, 5);
+        SetAbortedINxR_OTxRFlags();
+    }
+}
 
-            Ports::output(REG_BC, regA);
-            REG_WZ = REG_BC + 1;
+void Z80::dcEDB8(void)
+{ /* LDDR */
+    ldd();
+    if (REG_BC != 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_DE + 1, 5);
+        sz5h3pnFlags &= ~FLAG_53_MASK;
+        sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
+    }
+}
 
-            return;
-            // break;
-        }
-        case 0x7A:
-        { /* ADC HL,SP */
-            Z80Ops::addressOnBus(getPairIR().word, 7);
-            adc16(REG_SP);
-            break;
-        }
-        case 0x7B:
-        { /* LD SP,(nn) */
-            REG_WZ = Z80Ops::peek16(REG_PC);
-            REG_SP = Z80Ops::peek16(REG_WZ++);
-            REG_PC = REG_PC + 2;
-            break;
-        }
-        case 0xA0:
-        { /* LDI */
-            ldi();
-            break;
-        }
-        case 0xA1:
-        { /* CPI */
-            cpi();
-            break;
-        }
-        case 0xA2:
-        { /* INI */
-            ini();
-            break;
-        }
-        case 0xA3:
-        { /* OUTI */
-            outi();
-            break;
-        }
-        case 0xA8:
-        { /* LDD */
-            ldd();
-            break;
-        }
-        case 0xA9:
-        { /* CPD */
-            cpd();
-            break;
-        }
-        case 0xAA:
-        { /* IND */
-            ind();
-            break;
-        }
-        case 0xAB:
-        { /* OUTD */
-            outd();
-            break;
-        }
-        case 0xB0:
-        { /* LDIR */
-            ldi();
-            if (REG_BC != 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_DE - 1, 5);
-                sz5h3pnFlags &= ~FLAG_53_MASK;
-                sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
-            }
-            break;
-        }
-        case 0xB1:
-        { /* CPIR */
-            cpi();
-            if ((sz5h3pnFlags & PARITY_MASK) == PARITY_MASK
-                    && (sz5h3pnFlags & ZERO_MASK) == 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_HL - 1, 5);
-                sz5h3pnFlags &= ~FLAG_53_MASK;
-                sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
-            }
-            break;
-        }
-        case 0xB2:
-        { /* INIR */
-            ini();
-            if (REG_B != 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_HL - 1, 5);
-                SetAbortedINxR_OTxRFlags();
-            }
-            break;
-        }
-        case 0xB3:
-        { /* OTIR */
-            outi();
-            if (REG_B != 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_BC, 5);
-                SetAbortedINxR_OTxRFlags();
-            }
-            break;
-        }
-        case 0xB8:
-        { /* LDDR */
-            ldd();
-            if (REG_BC != 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_DE + 1, 5);
-                sz5h3pnFlags &= ~FLAG_53_MASK;
-                sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
-            }
-            break;
-        }
-        case 0xB9:
-        { /* CPDR */
-            cpd();
-            if ((sz5h3pnFlags & PARITY_MASK) == PARITY_MASK
-                    && (sz5h3pnFlags & ZERO_MASK) == 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_HL + 1, 5);
-                sz5h3pnFlags &= ~FLAG_53_MASK;
-                sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
-            }
-            break;
-        }
-        case 0xBA:
-        { /* INDR */
-            ind();
-            if (REG_B != 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_HL + 1, 5);
-                SetAbortedINxR_OTxRFlags();
-            }
-            break;
-        }
-        case 0xBB:
-        { /* OTDR */
-            outd();
-            if (REG_B != 0) {
-                REG_PC = REG_PC - 2;
-                REG_WZ = REG_PC + 1;
-                Z80Ops::addressOnBus(REG_BC, 5);
-                SetAbortedINxR_OTxRFlags();
-            }
-            break;
-        }
-        // case 0xDD:
-            // prefixOpcode = 0xDD;
-            // break;
-        // case 0xED:
-            // prefixOpcode = 0xED;
-            // break;
-        // case 0xFD:
-            // prefixOpcode = 0xFD;
-            // break;
-        // default:
-        //     break;
+void Z80::dcEDB9(void)
+{ /* CPDR */
+    cpd();
+    if ((sz5h3pnFlags & PARITY_MASK) == PARITY_MASK
+            && (sz5h3pnFlags & ZERO_MASK) == 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_HL + 1, 5);
+        sz5h3pnFlags &= ~FLAG_53_MASK;
+        sz5h3pnFlags |= (REG_PCh & FLAG_53_MASK);
+    }
+}
+
+void Z80::dcEDBA(void)
+{ /* INDR */
+    ind();
+    if (REG_B != 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_HL + 1, 5);
+        SetAbortedINxR_OTxRFlags();
+    }
+}
+
+void Z80::dcEDBB(void)
+{ /* OTDR */
+    outd();
+    if (REG_B != 0) {
+        REG_PC = REG_PC - 2;
+        REG_WZ = REG_PC + 1;
+        Z80Ops::addressOnBus(REG_BC, 5);
+        SetAbortedINxR_OTxRFlags();
     }
 }
 
+void Z80::dcEDnop(void)
+{ /* NOP: unassigned ED xx */
+}
+
+void (*Z80::dcED[256])() = {
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcED40, &dcED41, &dcED42, &dcED43,
+    &dcED44, &dcED45, &dcED46, &dcED47,
+    &dcED48, &dcED49, &dcED4A, &dcED4B,
+    &dcED44, &dcED4D, &dcED46, &dcED4F,
+
+    &dcED50, &dcED51, &dcED52, &dcED53,
+    &dcED44, &dcED45, &dcED56, &dcED57,
+    &dcED58, &dcED59, &dcED5A, &dcED5B,
+    &dcED44, &dcED45, &dcED5E, &dcED5F,
+
+    &dcED60, &dcED61, &dcED62, &dcED63,
+    &dcED44, &dcED45, &dcED46, &dcED67,
+    &dcED68, &dcED69, &dcED6A, &dcED6B,
+    &dcED44, &dcED45, &dcED46, &dcED6F,
+
+    &dcED70, &dcED71, &dcED72, &dcED73,
+    &dcED44, &dcED45, &dcED56, &dcEDnop,
+    &dcED78, &dcED79, &dcED7A, &dcED7B,
+    &dcED44, &dcED45, &dcED5E, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDA0, &dcEDA1, &dcEDA2, &dcEDA3,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDA8, &dcEDA9, &dcEDAA, &dcEDAB,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDB0, &dcEDB1, &dcEDB2, &dcEDB3,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDB8, &dcEDB9, &dcEDBA, &dcEDBB,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop,
+    &dcEDnop, &dcEDnop, &dcEDnop, &dcEDnop
+};
+
 IRAM_ATTR void Z80::copyToRegister(uint8_t value)
 {
     switch (opCode & 0x07)
@@ -403,6 +403,7 @@ public:
     // Execute one instruction
     static void execute();
     static void exec_nocheck();
+    static void execUntil(uint32_t horizon);
 
     // Check INT
     static void checkINT(void);
@@ -548,18 +549,22 @@ private:
 
     //Subconjunto de instrucciones 0xDD / 0xFD
     // Decode DD/FD opcodes
-    static void decodeDDFD(RegisterPair& regIXY);
+    static inline void decodeDDFD(RegisterPair& regIXY) { dcDDFD[opCode](regIXY); }
 
     // Subconjunto de instrucciones 0xDD / 0xFD 0xCB
     // Decode DD / FD CB opcodes
-    static void decodeDDFDCB(uint16_t address);
+    static inline void decodeDDFDCB(uint16_t address) { dcDDFDCB[opCode](address); }
 
     //Subconjunto de instrucciones 0xED
     // Decode EDXX opcodes
-    static void decodeED(void);
+    static inline void decodeED(void) { dcED[opCode](); }
 
     static void (*dcOpcode[256])();
     static void (*dcCB[256])();
+    // Prefijos: una entrada por opcode, igual que dcOpcode/dcCB
+    static void (*dcDDFD[256])(RegisterPair& regIXY);
+    static void (*dcDDFDCB[256])(uint16_t address);
+    static void (*dcED[256])();
 
     static void decodeOpcode00(void);
     static void decodeOpcode01(void);
@@ -1106,6 +1111,192 @@ private:
     static void dcCBFE(void);                    
     static void dcCBFF(void);                    
 
+    static void dcDDFD09(RegisterPair& regIXY);
+    static void dcDDFD19(RegisterPair& regIXY);
+    static void dcDDFD21(RegisterPair& regIXY);
+    static void dcDDFD22(RegisterPair& regIXY);
+    static void dcDDFD23(RegisterPair& regIXY);
+    static void dcDDFD24(RegisterPair& regIXY);
+    static void dcDDFD25(RegisterPair& regIXY);
+    static void dcDDFD26(RegisterPair& regIXY);
+    static void dcDDFD29(RegisterPair& regIXY);
+    static void dcDDFD2A(RegisterPair& regIXY);
+    static void dcDDFD2B(RegisterPair& regIXY);
+    static void dcDDFD2C(RegisterPair& regIXY);
+    static void dcDDFD2D(RegisterPair& regIXY);
+    static void dcDDFD2E(RegisterPair& regIXY);
+    static void dcDDFD34(RegisterPair& regIXY);
+    static void dcDDFD35(RegisterPair& regIXY);
+    static void dcDDFD36(RegisterPair& regIXY);
+    static void dcDDFD39(RegisterPair& regIXY);
+    static void dcDDFD44(RegisterPair& regIXY);
+    static void dcDDFD45(RegisterPair& regIXY);
+    static void dcDDFD46(RegisterPair& regIXY);
+    static void dcDDFD4C(RegisterPair& regIXY);
+    static void dcDDFD4D(RegisterPair& regIXY);
+    static void dcDDFD4E(RegisterPair& regIXY);
+    static void dcDDFD54(RegisterPair& regIXY);
+    static void dcDDFD55(RegisterPair& regIXY);
+    static void dcDDFD56(RegisterPair& regIXY);
+    static void dcDDFD5C(RegisterPair& regIXY);
+    static void dcDDFD5D(RegisterPair& regIXY);
+    static void dcDDFD5E(RegisterPair& regIXY);
+    static void dcDDFD60(RegisterPair& regIXY);
+    static void dcDDFD61(RegisterPair& regIXY);
+    static void dcDDFD62(RegisterPair& regIXY);
+    static void dcDDFD63(RegisterPair& regIXY);
+    static void dcDDFD64(RegisterPair& regIXY);
+    static void dcDDFD65(RegisterPair& regIXY);
+    static void dcDDFD66(RegisterPair& regIXY);
+    static void dcDDFD67(RegisterPair& regIXY);
+    static void dcDDFD68(RegisterPair& regIXY);
+    static void dcDDFD69(RegisterPair& regIXY);
+    static void dcDDFD6A(RegisterPair& regIXY);
+    static void dcDDFD6B(RegisterPair& regIXY);
+    static void dcDDFD6C(RegisterPair& regIXY);
+    static void dcDDFD6D(RegisterPair& regIXY);
+    static void dcDDFD6E(RegisterPair& regIXY);
+    static void dcDDFD6F(RegisterPair& regIXY);
+    static void dcDDFD70(RegisterPair& regIXY);
+    static void dcDDFD71(RegisterPair& regIXY);
+    static void dcDDFD72(RegisterPair& regIXY);
+    static void dcDDFD73(RegisterPair& regIXY);
+    static void dcDDFD74(RegisterPair& regIXY);
+    static void dcDDFD75(RegisterPair& regIXY);
+    static void dcDDFD77(RegisterPair& regIXY);
+    static void dcDDFD7C(RegisterPair& regIXY);
+    static void dcDDFD7D(RegisterPair& regIXY);
+    static void dcDDFD7E(RegisterPair& regIXY);
+    static void dcDDFD84(RegisterPair& regIXY);
+    static void dcDDFD85(RegisterPair& regIXY);
+    static void dcDDFD86(RegisterPair& regIXY);
+    static void dcDDFD8C(RegisterPair& regIXY);
+    static void dcDDFD8D(RegisterPair& regIXY);
+    static void dcDDFD8E(RegisterPair& regIXY);
+    static void dcDDFD94(RegisterPair& regIXY);
+    static void dcDDFD95(RegisterPair& regIXY);
+    static void dcDDFD96(RegisterPair& regIXY);
+    static void dcDDFD9C(RegisterPair& regIXY);
+    static void dcDDFD9D(RegisterPair& regIXY);
+    static void dcDDFD9E(RegisterPair& regIXY);
+    static void dcDDFDA4(RegisterPair& regIXY);
+    static void dcDDFDA5(RegisterPair& regIXY);
+    static void dcDDFDA6(RegisterPair& regIXY);
+    static void dcDDFDAC(RegisterPair& regIXY);
+    static void dcDDFDAD(RegisterPair& regIXY);
+    static void dcDDFDAE(RegisterPair& regIXY);
+    static void dcDDFDB4(RegisterPair& regIXY);
+    static void dcDDFDB5(RegisterPair& regIXY);
+    static void dcDDFDB6(RegisterPair& regIXY);
+    static void dcDDFDBC(RegisterPair& regIXY);
+    static void dcDDFDBD(RegisterPair& regIXY);
+    static void dcDDFDBE(RegisterPair& regIXY);
+    static void dcDDFDCBprefix(RegisterPair& regIXY);
+    static void dcDDFDDD(RegisterPair& regIXY);
+    static void dcDDFDE1(RegisterPair& regIXY);
+    static void dcDDFDE3(RegisterPair& regIXY);
+    static void dcDDFDE5(RegisterPair& regIXY);
+    static void dcDDFDE9(RegisterPair& regIXY);
+    static void dcDDFDED(RegisterPair& regIXY);
+    static void dcDDFDF9(RegisterPair& regIXY);
+    static void dcDDFDFD(RegisterPair& regIXY);
+    static void dcDDFDdefault(RegisterPair& regIXY);
+
+    static void dcDDFDCB00(uint16_t address);
+    static void dcDDFDCB08(uint16_t address);
+    static void dcDDFDCB10(uint16_t address);
+    static void dcDDFDCB18(uint16_t address);
+    static void dcDDFDCB20(uint16_t address);
+    static void dcDDFDCB28(uint16_t address);
+    static void dcDDFDCB30(uint16_t address);
+    static void dcDDFDCB38(uint16_t address);
+    static void dcDDFDCB40(uint16_t address);
+    static void dcDDFDCB48(uint16_t address);
+    static void dcDDFDCB50(uint16_t address);
+    static void dcDDFDCB58(uint16_t address);
+    static void dcDDFDCB60(uint16_t address);
+    static void dcDDFDCB68(uint16_t address);
+    static void dcDDFDCB70(uint16_t address);
+    static void dcDDFDCB78(uint16_t address);
+    static void dcDDFDCB80(uint16_t address);
+    static void dcDDFDCB88(uint16_t address);
+    static void dcDDFDCB90(uint16_t address);
+    static void dcDDFDCB98(uint16_t address);
+    static void dcDDFDCBA0(uint16_t address);
+    static void dcDDFDCBA8(uint16_t address);
+    static void dcDDFDCBB0(uint16_t address);
+    static void dcDDFDCBB8(uint16_t address);
+    static void dcDDFDCBC0(uint16_t address);
+    static void dcDDFDCBC8(uint16_t address);
+    static void dcDDFDCBD0(uint16_t address);
+    static void dcDDFDCBD8(uint16_t address);
+    static void dcDDFDCBE0(uint16_t address);
+    static void dcDDFDCBE8(uint16_t address);
+    static void dcDDFDCBF0(uint16_t address);
+    static void dcDDFDCBF8(uint16_t address);
+
+    static void dcED40(void);
+    static void dcED41(void);
+    static void dcED42(void);
+    static void dcED43(void);
+    static void dcED44(void);
+    static void dcED4D(void);
+    static void dcED45(void);
+    static void dcED46(void);
+    static void dcED47(void);
+    static void dcED48(void);
+    static void dcED49(void);
+    static void dcED4A(void);
+    static void dcED4B(void);
+    static void dcED4F(void);
+    static void dcED50(void);
+    static void dcED51(void);
+    static void dcED52(void);
+    static void dcED53(void);
+    static void dcED56(void);
+    static void dcED57(void);
+    static void dcED58(void);
+    static void dcED59(void);
+    static void dcED5A(void);
+    static void dcED5B(void);
+    static void dcED5E(void);
+    static void dcED5F(void);
+    static void dcED60(void);
+    static void dcED61(void);
+    static void dcED62(void);
+    static void dcED63(void);
+    static void dcED67(void);
+    static void dcED68(void);
+    static void dcED69(void);
+    static void dcED6A(void);
+    static void dcED6B(void);
+    static void dcED6F(void);
+    static void dcED70(void);
+    static void dcED71(void);
+    static void dcED72(void);
+    static void dcED73(void);
+    static void dcED78(void);
+    static void dcED79(void);
+    static void dcED7A(void);
+    static void dcED7B(void);
+    static void dcEDA0(void);
+    static void dcEDA1(void);
+    static void dcEDA2(void);
+    static void dcEDA3(void);
+    static void dcEDA8(void);
+    static void dcEDA9(void);
+    static void dcEDAA(void);
+    static void dcEDAB(void);
+    static void dcEDB0(void);
+    static void dcEDB1(void);
+    static void dcEDB2(void);
+    static void dcEDB3(void);
+    static void dcEDB8(void);
+    static void dcEDB9(void);
+    static void dcEDBA(void);
+    static void dcEDBB(void);
+    static void dcEDnop(void);
+
     static void check_trdos();                 
     static void check_trdos_unpage();                 
 };
@@ -49,7 +49,12 @@ visit https://zxespectrum.speccy.org/contacto
 //
 // DIRTY_LINES experimental optimization
 //
+// Paper scanlines are redrawn only when the Z80 (or DMA) wrote to their bitmap
+// or attribute bytes since they were last drawn. Mode, screen page and palette
+// changes force a full redraw; DIRTY_REFRESH forces one every N frames anyway,
+// to wipe OSD messages drawn straight into the frame buffer.
 
 // #define DIRTY_LINES
+#define DIRTY_REFRESH 64
 
 #endif // ESPectrum_config_h
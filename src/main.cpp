@@ -868,6 +868,9 @@ void __scratch_x("render") render_core() {
         refresh_lcd();
 #endif
         pcm_call();
+#if !PICO_RP2040
+        VIDEO::gigascreenPass();
+#endif
 #ifdef USE_GS
         // Wall-clock-locked: runs GS-Z80 at exactly 12 MHz off core0.
         GS::pump();
@@ -2,6 +2,7 @@
 #include <pico/multicore.h>
 #include <pico/stdlib.h>
 #include <pico/time.h>
+#include <hardware/sync.h>
 
 #include "audio.h"
 #include "pwm_audio.h"
@@ -218,11 +219,36 @@ volatile int16_t* pcm_end_callback(volatile size_t* size) {
     return NULL;
 }
 
-static int16_t buff_L[640] = { 0 };
-static int16_t buff_R[640] = { 0 };
+// Кольцевой буфер SPSC между циклом эмуляции (производитель, pwm_audio_write)
+// и прерыванием таймера (потребитель, pcm_call_inner). Индексы свободно бегущие:
+// m_head двигает только производитель, m_tail - только потребитель.
+// Потребитель читает с дробным шагом m_step (16.16) и линейной интерполяцией;
+// шаг подстраивается раз в кадр по заполнению буфера, так что расхождение
+// частоты кадров и таймера выбирается без щелчков.
+#define PCM_RING    2048 // stereo samples, power of two (~65 ms at 31250 Hz)
+#define PCM_TARGET  128  // fill wanted just before a frame is written (~4 ms)
+#define PCM_HIGH    (PCM_RING - 640) // above this the consumer drops the backlog
+#define PCM_MAXSTEP (1 << 10) // max rate correction, 1/64
+static int16_t ring_L[PCM_RING] = { 0 };
+static int16_t ring_R[PCM_RING] = { 0 };
+static volatile uint32_t m_head = 0;
+static volatile uint32_t m_tail = 0;
+static volatile uint32_t m_step = 0x10000;
+static uint32_t m_frac = 0; // consumer only
 static repeating_timer_t m_timer = { 0 };
-static volatile size_t m_off = 0; // in 16-bit words
-static volatile size_t m_size = 0; // 16-bit values prepared (available)
+static pcm_ring_stats_t m_stats = { 0, 0xFFFFFFFF, 0, 0, 0, 0x10000 };
+
+const pcm_ring_stats_t& pcm_ring_stats(bool reset) {
+    static pcm_ring_stats_t snap;
+    snap = m_stats;
+    if (reset) {
+        m_stats.fill_min = 0xFFFFFFFF;
+        m_stats.fill_max = 0;
+        m_stats.underruns = 0;
+        m_stats.overruns = 0;
+    }
+    return snap;
+}
 
 esp_err_t __not_in_flash_func(pwm_audio_write)(
     uint8_t *bufL,
@@ -232,16 +258,62 @@ esp_err_t __not_in_flash_func(pwm_audio_write)(
     uint32_t wait_ms
 ) {
     uint32_t vol8 = (uint32_t)vol << 3;
+    uint32_t head = m_head;
+    uint32_t fill = head - m_tail;
+    if (fill > PCM_RING) fill = PCM_RING; // tail moved past a reset
+    m_stats.fill = fill;
+    if (fill < m_stats.fill_min) m_stats.fill_min = fill;
+    if (fill > m_stats.fill_max) m_stats.fill_max = fill;
+    // Drift: play slightly faster when the backlog grows, slower when it shrinks
+    int32_t corr = ((int32_t)fill - PCM_TARGET) * 3;
+    if (corr > PCM_MAXSTEP) corr = PCM_MAXSTEP; else if (corr < -PCM_MAXSTEP) corr = -PCM_MAXSTEP;
+    m_step = 0x10000 + corr;
+    m_stats.step = m_step;
+    size_t room = PCM_RING - fill;
+    if (len > room) {
+        m_stats.overruns++;
+        len = room;
+    }
     for (size_t i = 0; i < len; ++i) {
-        buff_L[i] = (int16_t)((uint32_t)bufL[i] * vol8);
-        buff_R[i] = (int16_t)((uint32_t)bufR[i] * vol8);
+        uint32_t j = (head + i) & (PCM_RING - 1);
+        ring_L[j] = (int16_t)((uint32_t)bufL[i] * vol8);
+        ring_R[j] = (int16_t)((uint32_t)bufR[i] * vol8);
     }
-    m_off = 0;
-    m_size = len;
+    __dmb(); // samples must be visible before the new head
+    m_head = head + len;
     if (bytes_written) *bytes_written = len;
     return ESP_OK;
 }
 
+// Next output sample from the ring; false (and the last sample) on underrun
+static bool __not_in_flash_func(pcm_ring_get)(int16_t& outL, int16_t& outR) {
+    static int16_t lastL = 0, lastR = 0;
+    uint32_t tail = m_tail;
+    uint32_t fill = m_head - tail;
+    __dmb();
+    if (fill > PCM_HIGH) { // e.g. leaving maxSpeed: drop all but PCM_TARGET
+        tail += fill - PCM_TARGET;
+        fill = PCM_TARGET;
+        m_frac = 0;
+    }
+    if (fill < 2) {
+        if (fill == 0) m_stats.underruns++;
+        outL = lastL;
+        outR = lastR;
+        m_tail = tail;
+        return false;
+    }
+    uint32_t i0 = tail & (PCM_RING - 1);
+    uint32_t i1 = (tail + 1) & (PCM_RING - 1);
+    int32_t f = m_frac >> 1; // 15-bit weight keeps the products in int32
+    lastL = outL = ring_L[i0] + (((ring_L[i1] - ring_L[i0]) * f) >> 15);
+    lastR = outR = ring_R[i0] + (((ring_R[i1] - ring_R[i0]) * f) >> 15);
+    m_frac += m_step;
+    m_tail = tail + (m_frac >> 16);
+    m_frac &= 0xFFFF;
+    return true;
+}
+
 //------------------------------------------------------------
 static i2s_config_t i2s_config = {
 		.sample_freq = 31250, 
@@ -408,17 +480,15 @@ static void __not_in_flash_func(pcm_call_inner)() {
 #endif
 #if !PICO_RP2040  && defined(VGA_HDMI)
     if (Config::audio_driver == 4) {
-        if (m_off < m_size) {
-            int32_t sL = (int32_t)buff_L[m_off] + gs_offL;
-            int32_t sR = (int32_t)buff_R[m_off] + gs_offR;
+        int16_t bL, bR;
+        if (pcm_ring_get(bL, bR)) {
+            int32_t sL = (int32_t)bL + gs_offL;
+            int32_t sR = (int32_t)bR + gs_offR;
             if (sL < -32768) sL = -32768; else if (sL > 32767) sL = 32767;
             if (sR < -32768) sR = -32768; else if (sR > 32767) sR = 32767;
             hdmi_audio_write_sample((int16_t)sL, (int16_t)sR);
-            m_off++;
-        } else if (m_size > 0) {
-            hdmi_audio_write_sample(buff_L[m_size - 1], buff_R[m_size - 1]);
         } else {
-            hdmi_audio_write_sample(0, 0);
+            hdmi_audio_write_sample(bL, bR);
         }
         return;
     }
@@ -428,14 +498,14 @@ static void __not_in_flash_func(pcm_call_inner)() {
     }
     else if (is_i2s_enabled) {
         static int16_t v32[2];
-        if (m_off < m_size) {
-            int32_t sL = (int32_t)buff_L[m_off] + gs_offL;
-            int32_t sR = (int32_t)buff_R[m_off] + gs_offR;
+        int16_t bL, bR;
+        if (pcm_ring_get(bL, bR)) {
+            int32_t sL = (int32_t)bL + gs_offL;
+            int32_t sR = (int32_t)bR + gs_offR;
             if (sL < -32768) sL = -32768; else if (sL > 32767) sL = 32767;
             if (sR < -32768) sR = -32768; else if (sR > 32767) sR = 32767;
             v32[0] = (int16_t)sR;
             v32[1] = (int16_t)sL;
-            ++m_off;
         }
         if (!pio_sm_is_tx_fifo_full(i2s_config.pio, i2s_config.sm)) {
             uint32_t w = ((uint32_t)(uint16_t)v32[0] << 16) | (uint16_t)v32[1];
@@ -444,16 +514,14 @@ static void __not_in_flash_func(pcm_call_inner)() {
     } else {
         uint16_t outL = 0;
         uint16_t outR = 0;
-        if (m_off < m_size) {
+        int16_t bL, bR;
+        if (pcm_ring_get(bL, bR)) {
             static int16_t err_L = 0, err_R = 0;
-            int16_t* b_L = buff_L + m_off;
-            int16_t* b_R = buff_R + m_off;
-            ++m_off;
-            int32_t xL = ((int32_t)*b_L) + gs_offL + 0x8000 + err_L;
+            int32_t xL = ((int32_t)bL) + gs_offL + 0x8000 + err_L;
             if (xL < 0) xL = 0; else if (xL > 0xFFFF) xL = 0xFFFF;
             outL = (uint16_t)xL >> 8;
             err_L = (int16_t)(xL - ((int32_t)outL << 8));
-            int32_t xR = ((int32_t)*b_R) + gs_offR + 0x8000 + err_R;
+            int32_t xR = ((int32_t)bR) + gs_offR + 0x8000 + err_R;
             if (xR < 0) xR = 0; else if (xR > 0xFFFF) xR = 0xFFFF;
             outR = (uint16_t)xR >> 8;
             err_R = (int16_t)(xR - ((int32_t)outR << 8));
@@ -501,8 +569,9 @@ void pcm_cleanup(void) {
 /// size - bytes
 void pcm_setup(int hz) {
     // Flush output buffer so pcm_call() outputs silence until new data arrives
-    m_size = 0;
-    m_off = 0;
+    m_tail = m_head;
+    m_frac = 0;
+    m_step = 0x10000;
 #if !PICO_RP2040
     if (Config::audio_driver == 4) {
         // HDMI audio — timer only, no I2S/PWM hardware
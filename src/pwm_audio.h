@@ -7,6 +7,14 @@ typedef volatile int16_t* (*pcm_end_callback_t)(volatile size_t* size);
 // internal call on core#1
 void pcm_call();
 bool pcm_data_in(void);
+// Audio ring telemetry; fill is sampled just before each frame is written
+struct pcm_ring_stats_t {
+    uint32_t fill, fill_min, fill_max;
+    uint32_t underruns; // output ticks with nothing to play
+    uint32_t overruns;  // frames that did not fit (samples dropped)
+    uint32_t step;      // current playback rate, 16.16
+};
+const pcm_ring_stats_t& pcm_ring_stats(bool reset = false);
 void pwm_audio_in_frame_started(void);
 #if LOAD_WAV_PIO
 void pcm_audio_in_stop(void);
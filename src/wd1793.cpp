@@ -989,10 +989,43 @@ case kRVMWD177XWriteTrack: {
   }
 }
 
+#if !PICO_RP2040
+// Raw-image fast mode: free steps per call (a few revolutions, so that retries
+// running out still end the command) and how long a pending DRQ may hold the
+// disk before the normal Lost Data path takes over
+#define FASTRAW_SPIN 32768
+#define FASTRAW_HOLD 64
+
+static inline bool fastRaw(rvmWD1793 *wd) {
+  rvmwdDisk *disk = wd->disk[wd->diskS];
+  return wd->fastraw && !wd->wd2797_mode && disk && (disk->IsUDIFile || disk->IsFDIFile || disk->IsMBDFile);
+}
+#endif
+
 IRAM_ATTR void rvmWD1793Step(rvmWD1793 *wd, uint32_t steps) {
-  
+
+#if !PICO_RP2040
+  const bool raw = fastRaw(wd);
+  uint32_t spin = FASTRAW_SPIN;
+#endif
+
   for (;steps > 0; steps--) {
 
+#if !PICO_RP2040
+    if (raw && wd->stepState != kRVMWD177XStepIdle) {
+      if (wd->control & kRVMWD177XDRQ) {
+        // Let the CPU service the data register at its own pace
+        if (wd->fastrawHold < FASTRAW_HOLD) {
+          wd->fastrawHold += steps < FASTRAW_HOLD ? steps : FASTRAW_HOLD;
+          return;
+        }
+      } else {
+        wd->fastrawHold = 0;
+        if (spin) { spin--; steps++; } // this step is free
+      }
+    }
+#endif
+
     uint8_t d=0x0;
     uint8_t s=0x0;
     uint8_t dd=0x0;
@@ -1053,6 +1086,11 @@ IRAM_ATTR void rvmWD1793Step(rvmWD1793 *wd, uint32_t steps) {
         if (wd->fastmode) {
           wd->c = 0;
           _do(wd);
+#if !PICO_RP2040
+        } else if (raw) {
+          wd->c = 0;
+          _do(wd);
+#endif
         } else if(!(--wd->c)) {
             _do(wd);
         }
@@ -1377,6 +1415,11 @@ IRAM_ATTR void rvmWD1793Write(rvmWD1793 *wd,uint8_t a,uint8_t value) {
 
           }
 
+#if !PICO_RP2040
+          // Raw-image fast mode: run up to the first DRQ or the end right away
+          if (fastRaw(wd)) rvmWD1793Step(wd, 1);
+#endif
+
         } else {
 
           wd->status=kRVMWD177XStatusNotReady;
@@ -1401,6 +1444,9 @@ IRAM_ATTR void rvmWD1793Write(rvmWD1793 *wd,uint8_t a,uint8_t value) {
     case 3: //Data
       wd->data=value;
       wd->control &= ~kRVMWD177XDRQ;
+#if !PICO_RP2040
+      if (fastRaw(wd)) rvmWD1793Step(wd, 1); // take the byte now
+#endif
       break;
   }
 }
@@ -1462,6 +1508,14 @@ IRAM_ATTR uint8_t rvmWD1793Read(rvmWD1793 *wd,uint8_t a) {
 
       wd->control &= ~kRVMWD177XDRQ;
 
+#if !PICO_RP2040
+      if (fastRaw(wd)) {
+        r = wd->data;
+        rvmWD1793Step(wd, 1); // next byte ready for the next read
+        return r;
+      }
+#endif
+
       // printf("read data: %02x\n", wd->data);
       return wd->data;
 
@@ -1472,6 +1526,10 @@ IRAM_ATTR uint8_t rvmWD1793Read(rvmWD1793 *wd,uint8_t a) {
 
 static void fdiFlushTrack(rvmWD1793 *wd);
 static void mbdFlushTrack(rvmWD1793 *wd);
+static void trdCommitSector(rvmwdDisk *disk);
+#if !PICO_RP2040
+static void trdFlush(rvmwdDisk *disk, bool drop);
+#endif
 
 void rvmWD1793Reset(rvmWD1793 *wd) {
 
@@ -1502,11 +1560,21 @@ void rvmWD1793Reset(rvmWD1793 *wd) {
       if (wd->disk[i] && (wd->disk[i]->IsUDIFile || wd->disk[i]->IsFDIFile || wd->disk[i]->IsMBDFile))
         hasRawDisk = true;
     wd->fastmode = hasRawDisk ? false : Config::trdosFastMode;
+    wd->fastraw = Config::trdosFastMode;
+    wd->fastrawHold = 0;
   }
 #else
   wd->fastmode = Config::trdosFastMode;
 #endif
   wd->sclConverted = false;
+  // Pending TRD/SCL sector writes go to the image too
+  for (int i = 0; i < 4; i++) {
+    if (!wd->disk[i] || !wd->disk[i]->Diskfile) continue;
+    trdCommitSector(wd->disk[i]);
+#if !PICO_RP2040
+    trdFlush(wd->disk[i], false);
+#endif
+  }
 #if !PICO_RP2040
   // Flush modified UDI/FDI track to SD before resetting (avoid data loss)
   if (wd->diskDirty && wd->diskLoadedCyl >= 0) {
@@ -2234,6 +2302,122 @@ static void mbdFlushTrack(rvmWD1793 *wd) {
 
 #endif
 
+// TRD/SCL sector data. A sector is streamed byte by byte through cursectbuf;
+// writes stay there until the sector is complete (or the head moves on) and
+// are then committed in one piece.
+static inline int32_t trdOffset(rvmwdDisk *disk, uint32_t cyl, uint8_t side) {
+  return (cyl << (11 + disk->sides)) + (side << 12) + disk->sclDataOffset;
+}
+
+#if !PICO_RP2040
+// Track cache: each slot holds the 16 sectors of one track side, read with a
+// single f_read. Committed sectors only mark their slot dirty; dirty sectors
+// reach the image when the slot is evicted, the disk is ejected, the
+// controller is reset or the drive has been idle for TRD_IDLE_FRAMES. Four
+// slots keep both sides of the current and the previous cylinder; they are
+// shared by both controllers. RP2040 has no RAM to spare and writes each
+// sector straight through.
+#define TRD_CACHE_SLOTS 4
+#define TRD_IDLE_FRAMES 25
+
+typedef struct {
+  rvmwdDisk *disk;   // NULL = free
+  uint8_t cyl, side;
+  uint16_t dirty;    // bit per sector to write back
+  uint8_t idle;      // frames since the last write
+  uint32_t lru;
+  uint8_t data[16 << 8];
+} trdSlot;
+
+static trdSlot s_trd[TRD_CACHE_SLOTS];
+static uint32_t s_trd_tick;
+
+static void trdWriteBack(trdSlot *s) {
+  if (!s->dirty) return;
+  FIL *f = s->disk->Diskfile;
+  const int32_t base = trdOffset(s->disk, s->cyl, s->side);
+  UINT bw;
+  // runs of consecutive dirty sectors go out as one write
+  for (int i = 0; i < 16; ) {
+    if (!(s->dirty & (1 << i))) { i++; continue; }
+    int j = i;
+    while (j < 16 && (s->dirty & (1 << j))) j++;
+    f_lseek(f, base + (i << 8));
+    f_write(f, s->data + (i << 8), (j - i) << 8, &bw);
+    i = j;
+  }
+  s->dirty = 0;
+}
+
+static trdSlot* trdTrack(rvmwdDisk *disk, uint32_t cyl, uint8_t side) {
+  trdSlot *victim = NULL;
+  for (int i = 0; i < TRD_CACHE_SLOTS; i++) {
+    trdSlot *s = &s_trd[i];
+    if (s->disk == disk && s->cyl == cyl && s->side == side) {
+      s->lru = ++s_trd_tick;
+      return s;
+    }
+    if (!victim || (victim->disk && (!s->disk || (int32_t)(s->lru - victim->lru) < 0)))
+      victim = s;
+  }
+  if (victim->disk) trdWriteBack(victim);
+  victim->disk = disk;
+  victim->cyl = cyl;
+  victim->side = side;
+  victim->dirty = 0;
+  victim->idle = 0;
+  victim->lru = ++s_trd_tick;
+  const int32_t base = trdOffset(disk, cyl, side);
+  UINT br = 0;
+  if (base >= 0 && f_lseek(disk->Diskfile, base) == FR_OK)
+    f_read(disk->Diskfile, victim->data, sizeof(victim->data), &br);
+  if (br < sizeof(victim->data)) memset(victim->data + br, 0, sizeof(victim->data) - br);
+  return victim;
+}
+
+// Write back the slots of 'disk'; drop them too when the disk goes away
+static void trdFlush(rvmwdDisk *disk, bool drop) {
+  for (int i = 0; i < TRD_CACHE_SLOTS; i++) {
+    trdSlot *s = &s_trd[i];
+    if (s->disk != disk) continue;
+    trdWriteBack(s);
+    if (drop) s->disk = NULL;
+  }
+}
+#endif
+
+static void trdCommitSector(rvmwdDisk *disk) {
+  if (!disk->cursectdirty) return;
+  disk->cursectdirty = false;
+#if !PICO_RP2040
+  trdSlot *s = trdTrack(disk, disk->cursectcyl, disk->cursectside);
+  memcpy(s->data + (disk->cursectnum << 8), disk->cursectbuf, 0x100);
+  s->dirty |= 1 << disk->cursectnum;
+  s->idle = 0;
+#else
+  UINT bw;
+  f_lseek(disk->Diskfile, trdOffset(disk, disk->cursectcyl, disk->cursectside) + (disk->cursectnum << 8));
+  f_write(disk->Diskfile, disk->cursectbuf, 0x100, &bw);
+#endif
+}
+
+// Once per frame: commit a sector left half-written by an aborted command and,
+// once the controller has been idle for a while, write cached tracks back
+void rvmWD1793Idle(rvmWD1793 *wd) {
+  if (wd->stepState != kRVMWD177XStepIdle) return;
+  for (int u = 0; u < 4; u++) {
+    rvmwdDisk *disk = wd->disk[u];
+    if (!disk || !disk->Diskfile) continue;
+    trdCommitSector(disk);
+#if !PICO_RP2040
+    for (int i = 0; i < TRD_CACHE_SLOTS; i++) {
+      trdSlot *s = &s_trd[i];
+      if (s->disk == disk && s->dirty && ++s->idle >= TRD_IDLE_FRAMES) trdWriteBack(s);
+    }
+#endif
+  }
+}
+
 IRAM_ATTR uint8_t rvmwdDiskStep(rvmWD1793 *wd, uint32_t control) {
 
   rvmwdDisk *disk = wd->disk[wd->diskS];
@@ -2258,10 +2442,9 @@ IRAM_ATTR uint8_t rvmwdDiskStep(rvmWD1793 *wd, uint32_t control) {
     disk->indx++;
 
     if(control & kRVMwdDiskControlWrite) {
-      const uint8_t wr = control & 0xff;
-      UINT bw;
-      f_write(disk->Diskfile, &wr, 1, &bw);
-      disk->cursectbuf[disk->cursectbufpos] = wr;
+      disk->cursectbuf[disk->cursectbufpos] = control & 0xff;
+      disk->cursectdirty = true;
+      if (disk->cursectbufpos == 0xff) trdCommitSector(disk);
       return 0;
     }
 
@@ -2416,6 +2599,8 @@ IRAM_ATTR uint8_t rvmwdDiskStep(rvmWD1793 *wd, uint32_t control) {
 
         // const uint32_t side = (control & 0x800) << 1;
 
+        trdCommitSector(disk);
+
         if ((disk->IsSCLFile) && (!disk->t) && (!wd->side)) {
 
           // Create track0 from SCL file if not already done
@@ -2435,18 +2620,23 @@ IRAM_ATTR uint8_t rvmwdDiskStep(rvmWD1793 *wd, uint32_t control) {
 
         } else {
 
-          const int seekptr = (disk->t << (11 + disk->sides)) + (wd->side << 12) + (cursect << 8) + disk->sclDataOffset;
+#if !PICO_RP2040
+          memcpy(disk->cursectbuf, trdTrack(disk, disk->t, wd->side)->data + (cursect << 8), 0x100);
+#else
+          const int seekptr = trdOffset(disk, disk->t, wd->side) + (cursect << 8);
 
-          UINT br;
+          UINT br = 0;
           f_lseek(disk->Diskfile,seekptr);
           f_read(disk->Diskfile, disk->cursectbuf, 0x100, &br);
+          if (br < 0x100) memset(disk->cursectbuf + br, 0, 0x100 - br);
+#endif
+          disk->cursectcyl = disk->t;
+          disk->cursectside = wd->side;
+          disk->cursectnum = cursect;
 
           if(control & kRVMwdDiskControlWrite) {
-            uint8_t wr = control & 0xff;
-            UINT bw;
-            f_lseek(disk->Diskfile,seekptr);
-            f_write(disk->Diskfile, &wr,1,&bw);
-            disk->cursectbuf[0] = wr;
+            disk->cursectbuf[0] = control & 0xff;
+            disk->cursectdirty = true;
           } else {
             disk->a = disk->cursectbuf[0];
           }
@@ -2477,7 +2667,9 @@ void wdDiskEject(rvmWD1793 *wd, unsigned char UnitNum) {
     printf("Ejecting disk\n");
 
     if (wd->disk[UnitNum]->Diskfile != NULL) {
+        trdCommitSector(wd->disk[UnitNum]);
 #if !PICO_RP2040
+        trdFlush(wd->disk[UnitNum], true);
         if (wd->diskDirty && wd->diskS == UnitNum) {
             if (wd->disk[UnitNum]->IsUDIFile) udiFlushTrack(wd);
             else if (wd->disk[UnitNum]->IsFDIFile) fdiFlushTrack(wd);
@@ -148,6 +148,8 @@ typedef struct
     uint32_t writeprotect; // Write Protect
     uint8_t cursectbuf[0x100];
     uint16_t cursectbufpos;
+    uint8_t cursectcyl, cursectside, cursectnum; // TRD/SCL sector held in cursectbuf
+    bool cursectdirty;     // cursectbuf written, not yet handed to the track cache/image
     FIL *Diskfile;
     BYTE *Filedata;
     std::string fname;
@@ -315,6 +317,12 @@ typedef struct
     int diskLoadedSide;           // loaded side
     bool diskDirty;              // track buffer modified, needs flush to file
 
+    // Accelerated mode for UDI/FDI/MBD (fastmode's sectdatapos shortcut needs
+    // the fixed TRD layout): while a command runs, disk steps cost no emulated
+    // time unless DRQ is waiting for the CPU
+    bool fastraw;
+    uint16_t fastrawHold;        // steps DRQ has been pending
+
     // FDI find_marker support (ZXMAK2-style)
     uint32_t fdiSectorIdPos[32];   // byte position of 0xFE in diskTrackBuf per sector
     uint8_t  fdiSectorFlags[32];   // bit0 = data CRC error, bit1 = no data area (flags & 0x40)
@@ -333,6 +341,7 @@ void rvmWD1793Reset(rvmWD1793 *wd);
 bool rvmWD1793InsertDisk(rvmWD1793 *wd, unsigned char UnitNum, const std::string& Filename);
 uint8_t rvmwdDiskStep(rvmWD1793 *wd, uint32_t control);
 void wdDiskEject(rvmWD1793 *wd, unsigned char UnitNum);
+void rvmWD1793Idle(rvmWD1793 *wd);
 void SCLtoTRD(rvmwdDisk *d, unsigned char *track0);
 bool rvmWD1793CreateEmptyTRD(const char *path);
 #if !PICO_RP2040